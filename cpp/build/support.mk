@@ -137,6 +137,11 @@ CPPFLAGS += $(DEBUG_CPPFLAGS)
 LDFLAGS	+= $(DEBUG_LDFLAGS)
 endif
 
+#compile out log messages less severe than LOG_LEVEL (for example make LOG_LEVEL=LogLevel_Info)
+ifneq ($(LOG_LEVEL),)
+CFLAGS	+= -DOPENZWAVE_LOG_LEVEL=$(LOG_LEVEL)
+endif
+
 #if /lib64 exists, then setup x86_64 library path to lib64 (good indication if a linux has /lib and lib64). 
 #Else, if it doesnt, then set as /lib. This is used in the make install target 
 ifeq ($(wildcard /lib64),)
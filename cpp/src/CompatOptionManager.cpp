@@ -59,7 +59,10 @@ namespace OpenZWave
 		{ "VerifyChanged", COMPAT_FLAG_VERIFYCHANGED, COMPAT_FLAG_TYPE_BOOL_ARRAY },
 		{ "EnableNotificationClear", COMPAT_FLAG_NOT_ENABLECLEAR, COMPAT_FLAG_TYPE_BOOL },
 		{ "EnableV1AlarmTypes", COMPAT_FLAG_NOT_V1ALARMTYPES_ENABLED, COMPAT_FLAG_TYPE_BOOL },
-		{ "NoRefreshAfterSet", COMPAT_FLAG_NO_REFRESH_AFTER_SET, COMPAT_FLAG_TYPE_BOOL_ARRAY }
+		{ "NoRefreshAfterSet", COMPAT_FLAG_NO_REFRESH_AFTER_SET, COMPAT_FLAG_TYPE_BOOL_ARRAY },
+		{ "NotifyDeadband", COMPAT_FLAG_NOTIFY_DEADBAND, COMPAT_FLAG_TYPE_INT_ARRAY }, // Smallest change, in thousandths of the value's unit, that is passed on to the application
+		{ "NotifyMinInterval", COMPAT_FLAG_NOTIFY_MININTERVAL, COMPAT_FLAG_TYPE_INT_ARRAY }, // Minimum milliseconds between notifications for a value
+		{ "NotifyTrailingEdge", COMPAT_FLAG_NOTIFY_TRAILINGEDGE, COMPAT_FLAG_TYPE_BOOL_ARRAY } // Deliver the last value held back by NotifyMinInterval once the interval expires
 		};
 
 		uint16_t availableCompatFlagsCount = sizeof(availableCompatFlags) / sizeof(availableCompatFlags[0]);
@@ -81,7 +84,11 @@ namespace OpenZWave
 		{ "TimeOutMins", STATE_FLAG_DOORLOCK_TIMEOUTMINS, COMPAT_FLAG_TYPE_BYTE },
 		{ "TImeOutSecs", STATE_FLAG_DOORLOCK_TIMEOUTSECS, COMPAT_FLAG_TYPE_BYTE },
 		{ "MaxRecords", STATE_FLAG_DOORLOCKLOG_MAXRECORDS, COMPAT_FLAG_TYPE_BYTE },
-		{ "Count", STATE_FLAG_USERCODE_COUNT, COMPAT_FLAG_TYPE_BYTE } };
+		{ "Count", STATE_FLAG_USERCODE_COUNT, COMPAT_FLAG_TYPE_BYTE },
+		{ "ChecksumSupported", STATE_FLAG_USERCODE_CHECKSUMSUPPORTED, COMPAT_FLAG_TYPE_BOOL },
+		{ "MultipleReports", STATE_FLAG_USERCODE_MULTIPLEREPORTS, COMPAT_FLAG_TYPE_BOOL },
+		{ "Checksum", STATE_FLAG_USERCODE_CHECKSUM, COMPAT_FLAG_TYPE_INT }, // Checksum of the codes last read from the lock, with bit 16 set once it is known
+		{ "NoBulkSupport", STATE_FLAG_CONFIG_NOBULK, COMPAT_FLAG_TYPE_BOOL } };
 
 		uint16_t availableDiscoveryFlagsCount = sizeof(availableDiscoveryFlags) / sizeof(availableDiscoveryFlags[0]);
 
@@ -167,8 +174,9 @@ namespace OpenZWave
 				string value;
 				for (it = m_enabledCompatFlags.begin(); it != m_enabledCompatFlags.end(); it++)
 				{
-					TiXmlElement const *valElement = compatElement->FirstChildElement(it->first.c_str());
-					if (valElement)
+					// Array flags may be given once per index, plus once without an index for the default
+					// Indexed entries are kept even if they match the default, as the default may come after them
+					for (TiXmlElement const *valElement = compatElement->FirstChildElement(it->first.c_str()); valElement; valElement = valElement->NextSiblingElement(it->first.c_str()))
 					{
 						value = valElement->GetText();
 						char* pStopChar;
@@ -184,7 +192,12 @@ namespace OpenZWave
 								break;
 							case COMPAT_FLAG_TYPE_BOOL_ARRAY:
 								{
-									if (m_CompatVals[it->second].valBool != !strcmp(value.c_str(), "true"))
+									if (!valElement->Attribute("index"))
+									{
+										m_CompatVals[it->second].valBool = !strcmp(value.c_str(), "true");
+										m_CompatVals[it->second].changed = true;
+									}
+									else
 									{
 										string indexVal = valElement->Attribute("index");
 										uint32 index = strtol(indexVal.c_str(), &pStopChar, 10);
@@ -211,7 +224,12 @@ namespace OpenZWave
 									Log::Write(LogLevel_Warning, m_owner->GetNodeId(), "ReadXML: (%s) - Value for %s is larger than a byte", m_owner->GetCommandClassName().c_str(), it->first.c_str());
 									val = 0;
 								}
-								if (m_CompatVals[it->second].valByte != val)
+								if (!valElement->Attribute("index"))
+								{
+									m_CompatVals[it->second].valByte = val;
+									m_CompatVals[it->second].changed = true;
+								}
+								else
 								{
 									string indexVal = valElement->Attribute("index");
 									uint32 index = strtol(indexVal.c_str(), &pStopChar, 10);
@@ -238,7 +256,12 @@ namespace OpenZWave
 									Log::Write(LogLevel_Warning, m_owner->GetNodeId(), "ReadXML: (%s) - Value for %s is larger than a short", m_owner->GetCommandClassName().c_str(), it->first.c_str());
 									val = 0;
 								}
-								if (m_CompatVals[it->second].valShort != val)
+								if (!valElement->Attribute("index"))
+								{
+									m_CompatVals[it->second].valShort = val;
+									m_CompatVals[it->second].changed = true;
+								}
+								else
 								{
 									string indexVal = valElement->Attribute("index");
 									uint32 index = strtol(indexVal.c_str(), &pStopChar, 10);
@@ -264,7 +287,12 @@ namespace OpenZWave
 									Log::Write(LogLevel_Warning, m_owner->GetNodeId(), "ReadXML: (%s) - Value for %s is larger than a int", m_owner->GetCommandClassName().c_str(), it->first.c_str());
 									val = 0;
 								}
-								if (m_CompatVals[it->second].valInt != val)
+								if (!valElement->Attribute("index"))
+								{
+									m_CompatVals[it->second].valInt = val;
+									m_CompatVals[it->second].changed = true;
+								}
+								else
 								{
 									string indexVal = valElement->Attribute("index");
 									uint32 index = strtol(indexVal.c_str(), &pStopChar, 10);
@@ -352,6 +380,9 @@ namespace OpenZWave
 					}
 					case COMPAT_FLAG_TYPE_BOOL_ARRAY:
 					{
+						TiXmlElement* defElement = new TiXmlElement(it->first.c_str());
+						defElement->LinkEndChild(new TiXmlText(m_CompatVals[it->second].valBool == true ? "true" : "false"));
+						compatElement->LinkEndChild(defElement);
 						for (std::map<uint32_t, bool>::iterator it2 = m_CompatVals[it->second].valBoolArray.begin(); it2 != m_CompatVals[it->second].valBoolArray.end(); it2++) {
 							if (it2->second != m_CompatVals[it->second].valBool) {
 								TiXmlElement* valElement = new TiXmlElement(it->first.c_str());
@@ -374,6 +405,10 @@ namespace OpenZWave
 					}
 					case COMPAT_FLAG_TYPE_BYTE_ARRAY:
 					{
+						snprintf(str, sizeof(str), "%d", m_CompatVals[it->second].valByte);
+						TiXmlElement* defElement = new TiXmlElement(it->first.c_str());
+						defElement->LinkEndChild(new TiXmlText(str));
+						compatElement->LinkEndChild(defElement);
 						for (std::map<uint32_t, uint8_t>::iterator it2 = m_CompatVals[it->second].valByteArray.begin(); it2 != m_CompatVals[it->second].valByteArray.end(); it2++) {
 							if (it2->second != m_CompatVals[it->second].valByte) {
 								snprintf(str, sizeof(str), "%d", it2->second);
@@ -397,6 +432,10 @@ namespace OpenZWave
 					}
 					case COMPAT_FLAG_TYPE_SHORT_ARRAY:
 					{
+						snprintf(str, sizeof(str), "%d", m_CompatVals[it->second].valShort);
+						TiXmlElement* defElement = new TiXmlElement(it->first.c_str());
+						defElement->LinkEndChild(new TiXmlText(str));
+						compatElement->LinkEndChild(defElement);
 						for (std::map<uint32_t, uint16_t>::iterator it2 = m_CompatVals[it->second].valShortArray.begin(); it2 != m_CompatVals[it->second].valShortArray.end(); it2++) {
 							if (it2->second != m_CompatVals[it->second].valShort) {
 								snprintf(str, sizeof(str), "%d", it2->second);
@@ -420,6 +459,10 @@ namespace OpenZWave
 					}
 					case COMPAT_FLAG_TYPE_INT_ARRAY:
 					{
+						snprintf(str, sizeof(str), "%d", m_CompatVals[it->second].valInt);
+						TiXmlElement* defElement = new TiXmlElement(it->first.c_str());
+						defElement->LinkEndChild(new TiXmlText(str));
+						compatElement->LinkEndChild(defElement);
 						for (std::map<uint32_t, uint32_t>::iterator it2 = m_CompatVals[it->second].valIntArray.begin(); it2 != m_CompatVals[it->second].valIntArray.end(); it2++) {
 							if (it2->second != m_CompatVals[it->second].valInt) {
 								snprintf(str, sizeof(str), "%d", it2->second);
@@ -69,6 +69,9 @@ namespace OpenZWave
 			COMPAT_FLAG_NOT_ENABLECLEAR,
 			COMPAT_FLAG_NOT_V1ALARMTYPES_ENABLED,
 			COMPAT_FLAG_NO_REFRESH_AFTER_SET,
+			COMPAT_FLAG_NOTIFY_DEADBAND,
+			COMPAT_FLAG_NOTIFY_MININTERVAL,
+			COMPAT_FLAG_NOTIFY_TRAILINGEDGE,
 			STATE_FLAG_CCVERSION,
 			STATE_FLAG_STATIC_REQUESTS,
 			STATE_FLAG_AFTERMARK,
@@ -85,6 +88,10 @@ namespace OpenZWave
 			STATE_FLAG_DOORLOCK_TIMEOUTSECS,
 			STATE_FLAG_DOORLOCKLOG_MAXRECORDS,
 			STATE_FLAG_USERCODE_COUNT,
+			STATE_FLAG_USERCODE_CHECKSUMSUPPORTED,
+			STATE_FLAG_USERCODE_MULTIPLEREPORTS,
+			STATE_FLAG_USERCODE_CHECKSUM,
+			STATE_FLAG_CONFIG_NOBULK,
 		};
 
 		enum CompatOptionFlagType
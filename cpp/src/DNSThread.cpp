@@ -57,21 +57,20 @@ namespace OpenZWave
 		void DNSThread::DNSThreadProc(Internal::Platform::Event* _exitEvent)
 		{
 			Log::Write(LogLevel_Info, "Starting DNSThread");
+			Internal::Platform::WaitSet waitObjects;
+			waitObjects.Add(_exitEvent);				// Thread must exit.
+			waitObjects.Add(m_dnsRequestEvent);			// DNS Request
 			while (true)
 			{
 				// DNSThread has been initialized
 				const uint32 count = 2;
 
-				Internal::Platform::Wait* waitObjects[count];
-
 				int32 timeout = Internal::Platform::Wait::Timeout_Infinite;
 //		timeout = 5000;
 
-				waitObjects[0] = _exitEvent;				// Thread must exit.
-				waitObjects[1] = m_dnsRequestEvent;			// DNS Request
 				// Wait for something to do
 
-				int32 res = Internal::Platform::Wait::Multiple(waitObjects, count, timeout);
+				int32 res = waitObjects.Multiple(count, timeout);
 
 				switch (res)
 				{
@@ -234,6 +234,7 @@ namespace OpenZWave
 #define CAN												0x18
 
 #define NUM_NODE_BITFIELD_BYTES							29		// 29 bytes = 232 bits, one for each possible node in the network.
+#define MAX_MULTICAST_NODES								64		// Most nodes a single ZW_SEND_DATA_MULTI frame may address
 
 #define REQUEST											0x00
 #define RESPONSE										0x01
@@ -268,6 +269,7 @@ namespace OpenZWave
 
 #define FUNC_ID_ZW_SEND_NODE_INFORMATION				0x12
 #define FUNC_ID_ZW_SEND_DATA							0x13
+#define FUNC_ID_ZW_SEND_DATA_MULTI						0x14
 #define FUNC_ID_ZW_GET_VERSION							0x15
 #define FUNC_ID_ZW_R_F_POWER_LEVEL_SET					0x17
 #define FUNC_ID_ZW_GET_RANDOM							0x1c
@@ -41,6 +41,7 @@
 #include "platform/Event.h"
 #include "platform/Mutex.h"
 #include "platform/SerialController.h"
+#include "platform/ReplayController.h"
 #ifdef USE_HID
 #ifdef WINRT
 #include "platform/winRT/HidControllerWinRT.h"
@@ -56,18 +57,28 @@
 #include "command_classes/ApplicationStatus.h"
 #include "command_classes/ControllerReplication.h"
 #include "command_classes/Security.h"
+#include "command_classes/Supervision.h"
 #include "command_classes/WakeUp.h"
 #include "command_classes/SwitchAll.h"
+#include "command_classes/Basic.h"
+#include "command_classes/SwitchBinary.h"
+#include "command_classes/SwitchMultilevel.h"
 #include "command_classes/ManufacturerSpecific.h"
 #include "command_classes/NoOperation.h"
 
 #include "value_classes/ValueID.h"
 #include "value_classes/Value.h"
 #include "value_classes/ValueStore.h"
+#include "value_classes/ValueBool.h"
+#include "value_classes/ValueByte.h"
 
 #include "tinyxml.h"
 
 #include "Utils.h"
+#include "Metrics.h"
+#include "FrameCapture.h"
+#include "Topology.h"
+#include "ValueHistory.h"
 #if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
 # include <unistd.h>
 #elif defined _WIN32
@@ -110,19 +121,26 @@ static char const* c_controllerCommandNames[] =
 static char const* c_sendQueueNames[] =
 { "Command", "NoOp", "Controller", "WakeUp", "Send", "Query", "Poll" };
 
+// Histogram bucket bounds, in seconds
+static double const c_rttBuckets[] =
+{ 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10 };
+static double const c_pollLagBuckets[] =
+{ 0.01, 0.05, 0.1, 0.5, 1, 5, 10, 30, 60, 300 };
+
 //-----------------------------------------------------------------------------
 // <Driver::Driver>
 // Constructor
 //-----------------------------------------------------------------------------
 Driver::Driver(string const& _controllerPath, ControllerInterface const& _interface) :
-		m_driverThread(new Internal::Platform::Thread("driver")), m_dns(new Internal::DNSThread(this)), m_dnsThread(new Internal::Platform::Thread("dns")), m_initMutex(new Internal::Platform::Mutex()), m_exit(false), m_init(false), m_awakeNodesQueried(false), m_allNodesQueried(false), m_notifytransactions(false), m_timer(new Internal::TimerThread(this)), m_timerThread(new Internal::Platform::Thread("timer")), m_controllerInterfaceType(_interface), m_controllerPath(_controllerPath), m_controller(
-				NULL), m_homeId(0), m_libraryVersion(""), m_libraryTypeName(""), m_libraryType(0), m_manufacturerId(0), m_productType(0), m_productId(0), m_initVersion(0), m_initCaps(0), m_controllerCaps(0), m_Controller_nodeId(0), m_nodeMutex(new Internal::Platform::Mutex()), m_controllerReplication( NULL), m_transmitOptions( TRANSMIT_OPTION_ACK | TRANSMIT_OPTION_AUTO_ROUTE | TRANSMIT_OPTION_EXPLORE), m_waitingForAck(false), m_expectedCallbackId(0), m_expectedReply(0), m_expectedCommandClassId(
+		m_driverThread(new Internal::Platform::Thread("driver")), m_dns(new Internal::DNSThread(this)), m_dnsThread(new Internal::Platform::Thread("dns")), m_initMutex(new Internal::Platform::Mutex()), m_exit(false), m_init(false), m_awakeNodesQueried(false), m_allNodesQueried(false), m_notifytransactions(false), m_suppressValueRefresh(false), m_valueHistorySize(0), m_valueHistoryResolution(60), m_valueHistoryPersist(false), m_warmStart(false), m_warmStartRefreshDelay(2000), m_warmStartTimer(NULL), m_timer(new Internal::TimerThread(this)), m_timerThread(new Internal::Platform::Thread("timer")), m_controllerInterfaceType(_interface), m_controllerPath(_controllerPath), m_controller(
+				NULL), m_capture(NULL), m_topology(new Internal::Topology()), m_homeId(0), m_libraryVersion(""), m_libraryTypeName(""), m_libraryType(0), m_manufacturerId(0), m_productType(0), m_productId(0), m_initVersion(0), m_initCaps(0), m_controllerCaps(0), m_Controller_nodeId(0), m_nodeMutex(new Internal::Platform::Mutex()), m_controllerReplication( NULL), m_transmitOptions( TRANSMIT_OPTION_ACK | TRANSMIT_OPTION_AUTO_ROUTE | TRANSMIT_OPTION_EXPLORE), m_waitingForAck(false), m_expectedCallbackId(0), m_expectedReply(0), m_expectedCommandClassId(
 				0), m_expectedNodeId(0), m_pollThread(new Internal::Platform::Thread("poll")), m_pollMutex(new Internal::Platform::Mutex()), m_pollInterval(0), m_bIntervalBetweenPolls(false),				// if set to true (via SetPollInterval), the pollInterval will be interspersed between each poll (so a much smaller m_pollInterval like 100, 500, or 1,000 may be appropriate)
-		m_currentControllerCommand( NULL), m_SUCNodeId(0), m_controllerResetEvent( NULL), m_sendMutex(new Internal::Platform::Mutex()), m_currentMsg( NULL), m_virtualNeighborsReceived(false), m_notificationsEvent(new Internal::Platform::Event()), m_SOFCnt(0), m_ACKWaiting(0), m_readAborts(0), m_badChecksum(0), m_readCnt(0), m_writeCnt(0), m_CANCnt(0), m_NAKCnt(0), m_ACKCnt(0), m_OOFCnt(0), m_dropped(0), m_retries(0), m_callbacks(0), m_badroutes(0), m_noack(0), m_netbusy(0), m_notidle(0), m_txverified(
-				0), m_nondelivery(0), m_routedbusy(0), m_broadcastReadCnt(0), m_broadcastWriteCnt(0), AuthKey(0), EncryptKey(0), m_nonceReportSent(0), m_nonceReportSentAttempt(0), m_queueMsgEvent(new Internal::Platform::Event()), m_eventMutex(new Internal::Platform::Mutex())
+		m_currentControllerCommand( NULL), m_SUCNodeId(0), m_controllerResetEvent( NULL), m_sendMutex(new Internal::Platform::Mutex()), m_currentMsg( NULL), m_valueSetSerial(0), m_valueSetValue( NULL), m_valueSetSupervised(false), m_virtualNeighborsReceived(false), m_multicastWriteCnt(0), m_multicastNodeCnt(0), m_notificationsEvent(new Internal::Platform::Event()), m_SOFCnt(0), m_ACKWaiting(0), m_readAborts(0), m_badChecksum(0), m_readCnt(0), m_writeCnt(0), m_CANCnt(0), m_NAKCnt(0), m_ACKCnt(0), m_OOFCnt(0), m_dropped(0), m_retries(0), m_callbacks(0), m_badroutes(0), m_noack(0), m_netbusy(0), m_notidle(0), m_txverified(
+				0), m_nondelivery(0), m_routedbusy(0), m_broadcastReadCnt(0), m_broadcastWriteCnt(0), m_duplicatesDropped(0), m_setsSuperseded(0), m_requestRTTHistogram(new Internal::MetricsHistogram(c_rttBuckets, sizeof(c_rttBuckets) / sizeof(c_rttBuckets[0]))), m_responseRTTHistogram(new Internal::MetricsHistogram(c_rttBuckets, sizeof(c_rttBuckets) / sizeof(c_rttBuckets[0]))), m_pollLagHistogram(new Internal::MetricsHistogram(c_pollLagBuckets, sizeof(c_pollLagBuckets) / sizeof(c_pollLagBuckets[0]))), AuthKey(0), EncryptKey(0), m_nonceReportSent(0), m_nonceReportSentAttempt(0), m_queueMsgEvent(new Internal::Platform::Event()), m_eventMutex(new Internal::Platform::Mutex())
 {
 	// set a timestamp to indicate when this driver started
 	Internal::Platform::TimeStamp m_startTime;
+	m_startNow = Internal::Platform::TimeStamp::Now();
 
 	// Create the message queue events
 	for (int32 i = 0; i < MsgQueue_Count; ++i)
@@ -147,14 +165,39 @@ Driver::Driver(string const& _controllerPath, ControllerInterface const& _interf
 	}
 	else
 #endif
+	if (ControllerInterface_Replay == _interface)
+	{
+		m_controller = new Internal::Platform::ReplayController();
+	}
+	else
 	{
 		m_controller = new Internal::Platform::SerialController();
 	}
 	m_controller->SetSignalThreshold(1);
 
+	string capturePath;
+	Options::Get()->GetOptionAsString("CaptureFile", &capturePath);
+	if (!capturePath.empty())
+	{
+		m_capture = Internal::FrameCapture::Create(capturePath, _controllerPath);
+	}
+
 	Options::Get()->GetOptionAsBool("NotifyTransactions", &m_notifytransactions);
+	Options::Get()->GetOptionAsBool("SuppressValueRefresh", &m_suppressValueRefresh);
+
+	int32 historySize = 0;
+	int32 historyResolution = 60;
+	Options::Get()->GetOptionAsInt("ValueHistorySize", &historySize);
+	Options::Get()->GetOptionAsInt("ValueHistoryResolution", &historyResolution);
+	Options::Get()->GetOptionAsBool("ValueHistoryPersist", &m_valueHistoryPersist);
+	m_valueHistorySize = historySize > 0 ? (uint32) historySize : 0;
+	m_valueHistoryResolution = historyResolution > 0 ? (uint32) historyResolution : 60;
 	Options::Get()->GetOptionAsInt("PollInterval", &m_pollInterval);
 	Options::Get()->GetOptionAsBool("IntervalBetweenPolls", &m_bIntervalBetweenPolls);
+	Options::Get()->GetOptionAsBool("WarmStart", &m_warmStart);
+	Options::Get()->GetOptionAsInt("WarmStartRefreshDelay", &m_warmStartRefreshDelay);
+
+	m_warmStartTimer = new Internal::Timer(this);
 
 	m_httpClient = new Internal::HttpClient(this);
 
@@ -213,6 +256,7 @@ Driver::~Driver()
 
 	m_controller->Close();
 	m_controller->Release();
+	delete m_capture;
 
 	m_initMutex->Release();
 
@@ -238,6 +282,7 @@ Driver::~Driver()
 	}
 	// Don't release until all nodes have removed their poll values
 	m_pollMutex->Release();
+	delete m_topology;
 
 	// Clear the send Queue
 	for (int32 i = 0; i < MsgQueue_Count; ++i)
@@ -294,8 +339,12 @@ Driver::~Driver()
 	delete this->AuthKey;
 	delete this->EncryptKey;
 	delete this->m_httpClient;
+	delete this->m_warmStartTimer;
 	delete this->m_timer;
 	delete this->m_dns;
+	delete m_requestRTTHistogram;
+	delete m_responseRTTHistogram;
+	delete m_pollLagHistogram;
 
 
 }
@@ -339,20 +388,20 @@ void Driver::DriverThreadProc(Internal::Platform::Event* _exitEvent)
 	{
 		if (Init(attempts))
 		{
-			// Driver has been initialised
-			Internal::Platform::Wait* waitObjects[WAITOBJECTCOUNT];
-			waitObjects[0] = _exitEvent;						// Thread must exit.
-			waitObjects[1] = m_notificationsEvent;				// Notifications waiting to be sent.
-			waitObjects[2] = m_queueMsgEvent;
-			;					// a DNS and HTTP Event
-			waitObjects[3] = m_controller;					    // Controller has received data.
-			waitObjects[4] = m_queueEvent[MsgQueue_Command];	// A controller command is in progress.
-			waitObjects[5] = m_queueEvent[MsgQueue_NoOp];		// Send device probes and diagnostics messages
-			waitObjects[6] = m_queueEvent[MsgQueue_Controller];	// A multi-part controller command is in progress
-			waitObjects[7] = m_queueEvent[MsgQueue_WakeUp];		// A node has woken. Pending messages should be sent.
-			waitObjects[8] = m_queueEvent[MsgQueue_Send];		// Ordinary requests to be sent.
-			waitObjects[9] = m_queueEvent[MsgQueue_Query];		// Node queries are pending.
-			waitObjects[10] = m_queueEvent[MsgQueue_Poll];		// Poll request is waiting.
+			// Driver has been initialised.  The wait set is built once and kept for the
+			// life of the loop, so waiting does not allocate or re-register watchers.
+			Internal::Platform::WaitSet waitObjects;
+			waitObjects.Add(_exitEvent);						// Thread must exit.
+			waitObjects.Add(m_notificationsEvent);				// Notifications waiting to be sent.
+			waitObjects.Add(m_queueMsgEvent);					// a DNS and HTTP Event
+			waitObjects.Add(m_controller);					    // Controller has received data.
+			waitObjects.Add(m_queueEvent[MsgQueue_Command]);	// A controller command is in progress.
+			waitObjects.Add(m_queueEvent[MsgQueue_NoOp]);		// Send device probes and diagnostics messages
+			waitObjects.Add(m_queueEvent[MsgQueue_Controller]);	// A multi-part controller command is in progress
+			waitObjects.Add(m_queueEvent[MsgQueue_WakeUp]);		// A node has woken. Pending messages should be sent.
+			waitObjects.Add(m_queueEvent[MsgQueue_Send]);		// Ordinary requests to be sent.
+			waitObjects.Add(m_queueEvent[MsgQueue_Query]);		// Node queries are pending.
+			waitObjects.Add(m_queueEvent[MsgQueue_Poll]);		// Poll request is waiting.
 
 			Internal::Platform::TimeStamp retryTimeStamp;
 			int retryTimeout = RETRY_TIMEOUT;
@@ -391,7 +440,7 @@ void Driver::DriverThreadProc(Internal::Platform::Event* _exitEvent)
 				}
 
 				// Wait for something to do
-				int32 res = Internal::Platform::Wait::Multiple(waitObjects, count, timeout);
+				int32 res = waitObjects.Multiple(count, timeout);
 
 				switch (res)
 				{
@@ -527,7 +576,7 @@ bool Driver::Init(uint32 _attempts)
 
 	// Send a NAK to the ZWave device
 	uint8 nak = NAK;
-	m_controller->Write(&nak, 1);
+	WriteToController(&nak, 1);
 
 	// Purge any Messages in the Serial Buffer 
 	m_controller->Purge();
@@ -568,6 +617,7 @@ void Driver::RemoveQueues(uint8 const _nodeId)
 			MsgQueueItem const& item = *it;
 			if (MsgQueueCmd_SendMsg == item.m_command && _nodeId == item.m_msg->GetTargetNodeId())
 			{
+				UnindexPendingMsg(item.m_msg);
 				delete item.m_msg;
 				remove = true;
 			}
@@ -750,6 +800,7 @@ bool Driver::ReadCache()
 		}
 	}
 
+	ReadValueHistory();
 	return true;
 }
 
@@ -831,6 +882,196 @@ void Driver::WriteCache()
 	string filename = userPath + string(str);
 
 	doc.SaveFile(filename.c_str());
+
+	WriteValueHistory();
+}
+
+//-----------------------------------------------------------------------------
+// The value history file holds four uint32s (magic, version, resolution and
+// sizeof(ValueHistoryEntry)) followed by one record per value: its ValueID::GetId()
+// and then the tiers as written by ValueHistory::Write.  Numbers are stored in
+// the host's byte order.
+//-----------------------------------------------------------------------------
+static uint32 const c_valueHistoryMagic = 0x48565a4f;		// "OZVH"
+static uint32 const c_valueHistoryVersion = 1;
+
+//-----------------------------------------------------------------------------
+// <Driver::ReadValueHistory>
+// Restore the value histories saved alongside the cache
+//-----------------------------------------------------------------------------
+void Driver::ReadValueHistory()
+{
+	if (!m_valueHistorySize || !m_valueHistoryPersist)
+	{
+		return;
+	}
+
+	char str[40];
+	string userPath;
+	Options::Get()->GetOptionAsString("UserPath", &userPath);
+	snprintf(str, sizeof(str), "ozwcache_0x%08x_history.dat", m_homeId);
+	string filename = userPath + string(str);
+
+	FILE* file = fopen(filename.c_str(), "rb");
+	if (!file)
+	{
+		return;
+	}
+
+	uint32 header[4];
+	if (fread(header, sizeof(header), 1, file) != 1 || header[0] != c_valueHistoryMagic || header[1] != c_valueHistoryVersion || header[3] != sizeof(ValueHistoryEntry))
+	{
+		Log::Write(LogLevel_Warning, "Ignoring value history %s as it is not in a format this version understands", filename.c_str());
+		fclose(file);
+		return;
+	}
+
+	// The downsampled tiers only fit the current history if the resolution is unchanged
+	bool sameResolution = (header[2] == m_valueHistoryResolution);
+	uint32 restored = 0;
+	uint64 id;
+	std::vector<ValueHistoryEntry> tiers[ValueHistoryTier_Count];
+	while (fread(&id, sizeof(id), 1, file) == 1)
+	{
+		if (!Internal::ValueHistory::Read(file, tiers))
+		{
+			Log::Write(LogLevel_Warning, "Value history %s is truncated", filename.c_str());
+			break;
+		}
+
+		Internal::LockGuard LG(m_nodeMutex);
+		if (Internal::VC::Value* value = GetValue(ValueID(m_homeId, id)))
+		{
+			double numeric;
+			if (value->GetNumericValue(&numeric))
+			{
+				Internal::ValueHistory* history = value->GetHistory();
+				if (!history)
+				{
+					history = new Internal::ValueHistory(m_valueHistorySize, m_valueHistoryResolution);
+					value->m_history.m_history.store(history, std::memory_order_release);
+				}
+				history->Restore(ValueHistoryTier_Samples, tiers[ValueHistoryTier_Samples]);
+				if (sameResolution)
+				{
+					history->Restore(ValueHistoryTier_Resolution, tiers[ValueHistoryTier_Resolution]);
+					history->Restore(ValueHistoryTier_Coarse, tiers[ValueHistoryTier_Coarse]);
+				}
+				restored++;
+			}
+			value->Release();
+		}
+	}
+	fclose(file);
+	Log::Write(LogLevel_Info, "Restored the history of %d values from %s", restored, filename.c_str());
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::WriteValueHistory>
+// Save the value histories alongside the cache
+//-----------------------------------------------------------------------------
+void Driver::WriteValueHistory()
+{
+	if (!m_valueHistorySize || !m_valueHistoryPersist)
+	{
+		return;
+	}
+
+	char str[40];
+	string userPath;
+	Options::Get()->GetOptionAsString("UserPath", &userPath);
+	snprintf(str, sizeof(str), "ozwcache_0x%08x_history.dat", m_homeId);
+	string filename = userPath + string(str);
+
+	FILE* file = fopen(filename.c_str(), "wb");
+	if (!file)
+	{
+		Log::Write(LogLevel_Warning, "Cannot save value history to %s", filename.c_str());
+		return;
+	}
+
+	uint32 header[4] =
+	{ c_valueHistoryMagic, c_valueHistoryVersion, m_valueHistoryResolution, sizeof(ValueHistoryEntry) };
+	bool ok = (fwrite(header, sizeof(header), 1, file) == 1);
+
+	Internal::LockGuard LG(m_nodeMutex);
+	for (int i = 0; ok && i < 256; ++i)
+	{
+		if (!m_nodes[i])
+		{
+			continue;
+		}
+		Internal::VC::ValueStore* vs = m_nodes[i]->m_values;
+		for (Internal::VC::ValueStore::Iterator it = vs->Begin(); ok && it != vs->End(); ++it)
+		{
+			if (Internal::ValueHistory* history = it->second->GetHistory())
+			{
+				uint64 id = it->second->GetID().GetId();
+				ok = (fwrite(&id, sizeof(id), 1, file) == 1) && history->Write(file);
+			}
+		}
+	}
+	LG.Unlock();
+
+	if (fclose(file) != 0 || !ok)
+	{
+		Log::Write(LogLevel_Warning, "Failed to save value history to %s", filename.c_str());
+	}
+}
+
+//-----------------------------------------------------------------------------
+//	Warm Start
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// <Driver::ScheduleWarmStartRefresh>
+// Stagger the dynamic value refresh of warm started nodes
+//-----------------------------------------------------------------------------
+void Driver::ScheduleWarmStartRefresh(list<uint8> const& _nodes)
+{
+	list<uint8> listening;
+	list<uint8> flirs;
+	list<uint8> sleeping;
+	{
+		Internal::LockGuard LG(m_nodeMutex);
+		for (list<uint8>::const_iterator it = _nodes.begin(); it != _nodes.end(); ++it)
+		{
+			if (Node* node = GetNode(*it))
+			{
+				if (node->IsListeningDevice())
+					listening.push_back(*it);
+				else if (node->IsFrequentListeningDevice())
+					flirs.push_back(*it);
+				else
+					sleeping.push_back(*it);
+			}
+		}
+	}
+	listening.splice(listening.end(), flirs);
+	listening.splice(listening.end(), sleeping);
+
+	int32 delay = m_warmStartRefreshDelay;
+	for (list<uint8>::iterator it = listening.begin(); it != listening.end(); ++it)
+	{
+		Log::Write(LogLevel_Detail, *it, "Warm Start: Refreshing dynamic values in %d ms", delay);
+		Internal::TimerThread::TimerCallback callback = bind(&Driver::WarmStartRefresh, this, *it);
+		m_warmStartTimer->TimerSetEvent(delay, callback, *it);
+		delay += m_warmStartRefreshDelay;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::WarmStartRefresh>
+// Request the dynamic values of a warm started node
+//-----------------------------------------------------------------------------
+void Driver::WarmStartRefresh(uint32 _nodeId)
+{
+	Internal::LockGuard LG(m_nodeMutex);
+	if (Node* node = GetNode((uint8) _nodeId))
+	{
+		Log::Write(LogLevel_Info, node->GetNodeId(), "Warm Start: Refreshing dynamic values");
+		node->RefreshDynamicValues();
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -950,9 +1191,16 @@ void Driver::SendMsg(Internal::Msg* _msg, MsgQueue const _queue)
 	item.m_msg = _msg;
 	/* make sure the HomeId is Set on this message */
 	_msg->SetHomeId(m_homeId);
-	_msg->Finalize();
+	Internal::MemoryAccounting::Attribute(_msg, m_homeId, _msg->GetTargetNodeId());
+	string valueSet;
 	{
 		Internal::LockGuard LG(m_nodeMutex);
+		valueSet = m_valueSetKey;
+		if (m_valueSetValue != NULL)
+		{
+			SuperviseValueSet(_msg);
+		}
+		_msg->Finalize();
 		if (Node* node = GetNode(_msg->GetTargetNodeId()))
 		{
 			/* if the node Supports the Security Class - check if this message is meant to be encapsulated */
@@ -961,7 +1209,10 @@ void Driver::SendMsg(Internal::Msg* _msg, MsgQueue const _queue)
 				Internal::CC::CommandClass *cc = node->GetCommandClass(_msg->GetSendingCommandClass());
 				if ((cc) && (cc->IsSecured()))
 				{
-					Log::Write(LogLevel_Detail, GetNodeNumber(_msg), "Setting Encryption Flag on Message For Command Class %s", cc->GetCommandClassName().c_str());
+					if (Log::IsLevelEnabled(LogLevel_Detail))
+					{
+						Log::Write(LogLevel_Detail, GetNodeNumber(_msg), "Setting Encryption Flag on Message For Command Class %s", cc->GetCommandClassName().c_str());
+					}
 					item.m_msg->setEncrypted();
 				}
 			}
@@ -984,7 +1235,7 @@ void Driver::SendMsg(Internal::Msg* _msg, MsgQueue const _queue)
 							item.m_msg = NULL;
 							UpdateControllerState(ControllerState_Sleeping);
 						}
-						else
+						else if (Log::IsLevelEnabled(LogLevel_Detail))
 						{
 							Log::Write(LogLevel_Detail, GetNodeNumber(_msg), "Queuing (%s) %s", c_sendQueueNames[MsgQueue_WakeUp], _msg->GetAsString().c_str());
 						}
@@ -995,13 +1246,201 @@ void Driver::SendMsg(Internal::Msg* _msg, MsgQueue const _queue)
 			}
 		}
 	}
-	Log::Write(LogLevel_Detail, GetNodeNumber(_msg), "Queuing (%s) %s", c_sendQueueNames[_queue], _msg->GetAsString().c_str());
 	m_sendMutex->Lock();
+	string key;
+	if (MergePendingMsg(_queue, _msg, valueSet, &key))
+	{
+		m_sendMutex->Unlock();
+		return;
+	}
+	if (Log::IsLevelEnabled(LogLevel_Detail))
+	{
+		Log::Write(LogLevel_Detail, GetNodeNumber(_msg), "Queuing (%s) %s", c_sendQueueNames[_queue], _msg->GetAsString().c_str());
+	}
 	m_msgQueue[_queue].push_back(item);
+	IndexPendingMsg(_queue, key);
 	m_queueEvent[_queue]->Set();
 	m_sendMutex->Unlock();
 }
 
+//-----------------------------------------------------------------------------
+// <Driver::MergePendingMsg>
+// Merge a message with one already waiting in the queue, if possible.  Returns
+// true if the message was merged (and has been consumed), otherwise o_key is
+// set to the key under which the message should be indexed once queued.
+//-----------------------------------------------------------------------------
+bool Driver::MergePendingMsg(MsgQueue const _queue, Internal::Msg* _msg, string const& _valueSet, string* o_key)
+{
+	// Encrypted messages have to go through the nonce exchange one by one
+	if (_msg->isEncrypted() || _msg->GetTargetNodeId() == 0xff)
+	{
+		return false;
+	}
+	string payload = _msg->GetSendDataPayload();
+	if (payload.empty())
+	{
+		return false;
+	}
+
+	string base;
+	base += (char) _queue;
+	base += (char) _msg->GetTargetNodeId();
+
+	if (_msg->GetExpectedReply() == FUNC_ID_APPLICATION_COMMAND_HANDLER)
+	{
+		// A Get.  If an identical one is still waiting, it will fetch the same data.
+		string key = base + 'G' + payload;
+		if (m_pendingMsgs.find(key) != m_pendingMsgs.end())
+		{
+			Log::Write(LogLevel_Detail, GetNodeNumber(_msg), "Dropping (%s) %s - an identical request is already queued", c_sendQueueNames[_queue], _msg->GetLogText().c_str());
+			m_duplicatesDropped++;
+			delete _msg;
+			return true;
+		}
+		*o_key = key;
+		return false;
+	}
+
+	if (_valueSet.empty())
+	{
+		// Only Sets issued for a ValueID can be matched up with each other
+		return false;
+	}
+
+	// A Set makes any Gets queued before it stale, so later Gets must not be merged with them
+	string gets = base + 'G';
+	map<string, list<MsgQueueItem>::iterator>::iterator git = m_pendingMsgs.lower_bound(gets);
+	while (git != m_pendingMsgs.end() && git->first.compare(0, gets.size(), gets) == 0)
+	{
+		if (git->first.size() > gets.size() + 2 && git->first[gets.size() + 2] == _valueSet[0])
+		{
+			m_pendingMsgKeys.erase(git->second->m_msg);
+			m_pendingMsgs.erase(git++);
+		}
+		else
+		{
+			++git;
+		}
+	}
+
+	string key = base + 'S' + _valueSet;
+	map<string, list<MsgQueueItem>::iterator>::iterator it = m_pendingMsgs.find(key);
+	if (it == m_pendingMsgs.end())
+	{
+		*o_key = key;
+		return false;
+	}
+
+	Internal::Msg* queued = it->second->m_msg;
+	if (m_pendingMsgKeys[queued].m_valueSet == m_valueSetSerial)
+	{
+		// The Command Class sent more than one Set for this value, so the
+		// messages cannot stand in for each other
+		m_pendingMsgKeys.erase(queued);
+		m_pendingMsgs.erase(it);
+		return false;
+	}
+
+	Log::Write(LogLevel_Detail, GetNodeNumber(_msg), "Replacing queued (%s) %s with a newer value", c_sendQueueNames[_queue], queued->GetLogText().c_str());
+	m_pendingMsgKeys.erase(queued);
+	delete queued;
+	it->second->m_msg = _msg;
+	m_pendingMsgKeys[_msg].m_key = key;
+	m_pendingMsgKeys[_msg].m_valueSet = m_valueSetSerial;
+	m_setsSuperseded++;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::IndexPendingMsg>
+// Record the message just added to the back of a queue under its key
+//-----------------------------------------------------------------------------
+void Driver::IndexPendingMsg(MsgQueue const _queue, string const& _key)
+{
+	if (_key.empty())
+	{
+		return;
+	}
+	list<MsgQueueItem>::iterator it = m_msgQueue[_queue].end();
+	--it;
+	m_pendingMsgs[_key] = it;
+	m_pendingMsgKeys[it->m_msg].m_key = _key;
+	m_pendingMsgKeys[it->m_msg].m_valueSet = (_key[2] == 'S') ? m_valueSetSerial : 0;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::UnindexPendingMsg>
+// Forget a message that is leaving its queue
+//-----------------------------------------------------------------------------
+void Driver::UnindexPendingMsg(Internal::Msg* _msg)
+{
+	map<Internal::Msg*, PendingMsgKey>::iterator it = m_pendingMsgKeys.find(_msg);
+	if (it != m_pendingMsgKeys.end())
+	{
+		m_pendingMsgs.erase(it->second.m_key);
+		m_pendingMsgKeys.erase(it);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::BeginValueSet>
+// Messages queued until EndValueSet is called are Sets of this value
+//-----------------------------------------------------------------------------
+void Driver::BeginValueSet(ValueID const& _id, Internal::VC::Value const* _value)
+{
+	Internal::LockGuard LG(m_nodeMutex);
+	m_valueSetValue = _value;
+	m_valueSetSupervised = false;
+	m_valueSetKey.clear();
+	m_valueSetKey += (char) _id.GetCommandClassId();
+	m_valueSetKey += (char) _id.GetInstance();
+	m_valueSetKey += (char) (_id.GetIndex() >> 8);
+	m_valueSetKey += (char) (_id.GetIndex() & 0xff);
+	if (++m_valueSetSerial == 0)
+	{
+		m_valueSetSerial = 1;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::EndValueSet>
+// Stop treating queued messages as Sets of a value
+//-----------------------------------------------------------------------------
+bool Driver::EndValueSet()
+{
+	Internal::LockGuard LG(m_nodeMutex);
+	m_valueSetKey.clear();
+	m_valueSetValue = NULL;
+	bool supervised = m_valueSetSupervised;
+	m_valueSetSupervised = false;
+	return supervised;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::SuperviseValueSet>
+// Wrap a Set of the value being Set in a Supervision Get if the node supports
+// it.  Called with m_nodeMutex held, before the message is finalized.
+//-----------------------------------------------------------------------------
+void Driver::SuperviseValueSet(Internal::Msg* _msg)
+{
+	if (_msg->GetExpectedReply() == FUNC_ID_APPLICATION_COMMAND_HANDLER)
+	{
+		// Gets are answered by a report anyway
+		return;
+	}
+
+	if (Node* node = GetNode(_msg->GetTargetNodeId()))
+	{
+		if (Internal::CC::Supervision* supervision = static_cast<Internal::CC::Supervision*>(node->GetCommandClass(Internal::CC::Supervision::StaticGetCommandClassId())))
+		{
+			if (supervision->Supervise(_msg, *m_valueSetValue))
+			{
+				m_valueSetSupervised = true;
+			}
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 // <Driver::WriteNextMsg>
 // Transmit a queued message to the Z-Wave controller
@@ -1018,6 +1457,7 @@ bool Driver::WriteNextMsg(MsgQueue const _queue)
 		// Send a message
 		m_currentMsg = item.m_msg;
 		m_currentMsgQueueSource = _queue;
+		UnindexPendingMsg(item.m_msg);
 		m_msgQueue[_queue].pop_front();
 		if (m_msgQueue[_queue].empty())
 		{
@@ -1178,6 +1618,16 @@ bool Driver::WriteMsg(string const &msg)
 
 		}
 
+		// Let the command class know its Get will not be answered
+		uint8* buffer = m_currentMsg->GetBuffer();
+		if (node != NULL && buffer[3] == FUNC_ID_ZW_SEND_DATA && buffer[5] >= 2 && m_currentMsg->GetExpectedReply() == FUNC_ID_APPLICATION_COMMAND_HANDLER)
+		{
+			if (Internal::CC::CommandClass* cc = node->GetCommandClass(buffer[6]))
+			{
+				cc->RequestDropped(&buffer[7], buffer[5] - 1);
+			}
+		}
+
 		RemoveCurrentMsg();
 		m_dropped++;
 		return false;
@@ -1234,7 +1684,10 @@ bool Driver::WriteMsg(string const &msg)
 	{
 		if (m_currentMsg->isNonceRecieved())
 		{
-			Log::Write(LogLevel_Info, nodeId, "Processing (%s) Encrypted message (%sCallback ID=0x%.2x, Expected Reply=0x%.2x) - %s", c_sendQueueNames[m_currentMsgQueueSource], attemptsstr.c_str(), m_expectedCallbackId, m_expectedReply, m_currentMsg->GetAsString().c_str());
+			if (Log::IsLevelEnabled(LogLevel_Info))
+			{
+				Log::Write(LogLevel_Info, nodeId, "Processing (%s) Encrypted message (%sCallback ID=0x%.2x, Expected Reply=0x%.2x) - %s", c_sendQueueNames[m_currentMsgQueueSource], attemptsstr.c_str(), m_expectedCallbackId, m_expectedReply, m_currentMsg->GetAsString().c_str());
+			}
 			SendEncryptedMessage();
 		}
 		else
@@ -1245,8 +1698,11 @@ bool Driver::WriteMsg(string const &msg)
 	}
 	else
 	{
-		Log::Write(LogLevel_Info, nodeId, "Sending (%s) message (%sCallback ID=0x%.2x, Expected Reply=0x%.2x) - %s", c_sendQueueNames[m_currentMsgQueueSource], attemptsstr.c_str(), m_expectedCallbackId, m_expectedReply, m_currentMsg->GetAsString().c_str());
-		uint32 bytesWritten = m_controller->Write(m_currentMsg->GetBuffer(), m_currentMsg->GetLength());
+		if (Log::IsLevelEnabled(LogLevel_Info))
+		{
+			Log::Write(LogLevel_Info, nodeId, "Sending (%s) message (%sCallback ID=0x%.2x, Expected Reply=0x%.2x) - %s", c_sendQueueNames[m_currentMsgQueueSource], attemptsstr.c_str(), m_expectedCallbackId, m_expectedReply, m_currentMsg->GetAsString().c_str());
+		}
+		uint32 bytesWritten = WriteToController(m_currentMsg->GetBuffer(), m_currentMsg->GetLength());
 
 		if (bytesWritten == 0)
 		{
@@ -1267,6 +1723,10 @@ bool Driver::WriteMsg(string const &msg)
 	if (nodeId == 0xff)
 	{
 		m_broadcastWriteCnt++; // not accurate since library uses 0xff for the controller too
+		if (m_currentMsg->GetBuffer()[3] == FUNC_ID_ZW_SEND_DATA_MULTI)
+		{
+			m_multicastSentTS.SetTime();
+		}
 	}
 	else
 	{
@@ -1384,6 +1844,7 @@ bool Driver::MoveMessagesToWakeUpQueue(uint8 const _targetNodeId, bool const _mo
 							{
 								if (_targetNodeId == item.m_msg->GetTargetNodeId())
 								{
+									UnindexPendingMsg(item.m_msg);
 									// This message is for the unresponsive node
 									// We do not move any "Wake Up No More Information"
 									// commands or NoOperations to the pending queue.
@@ -1606,7 +2067,7 @@ bool Driver::IsExpectedReply(const uint8 _nodeId)
 		return true;
 	}
 	// Accept all messages that do not convey source node identification.
-	if (m_expectedReply == FUNC_ID_ZW_GET_NODE_PROTOCOL_INFO || m_expectedReply == FUNC_ID_ZW_REQUEST_NODE_INFO || m_expectedReply == FUNC_ID_ZW_GET_ROUTING_INFO || m_expectedReply == FUNC_ID_ZW_ASSIGN_RETURN_ROUTE || m_expectedReply == FUNC_ID_ZW_DELETE_RETURN_ROUTE || m_expectedReply == FUNC_ID_ZW_SEND_DATA || m_expectedReply == FUNC_ID_ZW_SEND_NODE_INFORMATION || m_expectedReply == FUNC_ID_ZW_REQUEST_NODE_NEIGHBOR_UPDATE || m_expectedReply == FUNC_ID_ZW_ENABLE_SUC
+	if (m_expectedReply == FUNC_ID_ZW_GET_NODE_PROTOCOL_INFO || m_expectedReply == FUNC_ID_ZW_REQUEST_NODE_INFO || m_expectedReply == FUNC_ID_ZW_GET_ROUTING_INFO || m_expectedReply == FUNC_ID_ZW_ASSIGN_RETURN_ROUTE || m_expectedReply == FUNC_ID_ZW_DELETE_RETURN_ROUTE || m_expectedReply == FUNC_ID_ZW_SEND_DATA || m_expectedReply == FUNC_ID_ZW_SEND_DATA_MULTI || m_expectedReply == FUNC_ID_ZW_SEND_NODE_INFORMATION || m_expectedReply == FUNC_ID_ZW_REQUEST_NODE_NEIGHBOR_UPDATE || m_expectedReply == FUNC_ID_ZW_ENABLE_SUC
 			|| m_expectedReply == FUNC_ID_ZW_SET_SUC_NODE_ID || m_expectedReply == FUNC_ID_ZW_REQUEST_NODE_NEIGHBOR_UPDATE_OPTIONS)
 	{
 		return true;
@@ -1639,6 +2100,12 @@ bool Driver::ReadMsg()
 		return false;
 	}
 
+	// SOF frames are recorded once the whole frame has been read
+	if (m_capture && buffer[0] != SOF)
+	{
+		m_capture->Write(Internal::FrameCapture::Direction_Inbound, buffer, 1);
+	}
+
 	switch (buffer[0])
 	{
 		case SOF:
@@ -1677,26 +2144,34 @@ bool Driver::ReadMsg()
 			m_controller->SetSignalThreshold(1);
 
 			uint32 length = buffer[1] + 2;
-
-			// Log the data
-			string str = "";
-			for (uint32 i = 0; i < length; ++i)
+			if (m_capture)
 			{
-				if (i)
-				{
-					str += ", ";
-				}
-
-				char byteStr[8];
-				snprintf(byteStr, sizeof(byteStr), "0x%.2x", buffer[i]);
-				str += byteStr;
+				m_capture->Write(Internal::FrameCapture::Direction_Inbound, buffer, length);
 			}
+
 			uint8 nodeId = NodeFromMessage(buffer);
 			if (nodeId == 0)
 			{
 				nodeId = GetNodeNumber(m_currentMsg);
 			}
-			Log::Write(LogLevel_Detail, nodeId, "  Received: %s", str.c_str());
+
+			// Log the data
+			if (Log::IsLevelEnabled(LogLevel_Detail))
+			{
+				string str = "";
+				for (uint32 i = 0; i < length; ++i)
+				{
+					if (i)
+					{
+						str += ", ";
+					}
+
+					char byteStr[8];
+					snprintf(byteStr, sizeof(byteStr), "0x%.2x", buffer[i]);
+					str += byteStr;
+				}
+				Log::Write(LogLevel_Detail, nodeId, "  Received: %s", str.c_str());
+			}
 
 			// Verify checksum
 			uint8 checksum = 0xff;
@@ -1709,7 +2184,7 @@ bool Driver::ReadMsg()
 			{
 				// Checksum correct - send ACK
 				uint8 ack = ACK;
-				m_controller->Write(&ack, 1);
+				WriteToController(&ack, 1);
 				m_readCnt++;
 
 				// Process the received message
@@ -1720,7 +2195,7 @@ bool Driver::ReadMsg()
 				Log::Write(LogLevel_Warning, nodeId, "WARNING: Checksum incorrect - sending NAK");
 				m_badChecksum++;
 				uint8 nak = NAK;
-				m_controller->Write(&nak, 1);
+				WriteToController(&nak, 1);
 				m_controller->Purge();
 			}
 			break;
@@ -1785,7 +2260,7 @@ bool Driver::ReadMsg()
 			Log::Write(LogLevel_Warning, "WARNING: Out of frame flow! (0x%.2x).  Sending NAK.", buffer[0]);
 			m_OOFCnt++;
 			uint8 nak = NAK;
-			m_controller->Write(&nak, 1);
+			WriteToController(&nak, 1);
 			m_controller->Purge();
 			break;
 		}
@@ -1794,6 +2269,19 @@ bool Driver::ReadMsg()
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// <Driver::WriteToController>
+// Write to the controller, recording the bytes if capturing
+//-----------------------------------------------------------------------------
+uint32 Driver::WriteToController(uint8* _buffer, uint32 _length)
+{
+	if (m_capture)
+	{
+		m_capture->Write(Internal::FrameCapture::Direction_Outbound, _buffer, _length);
+	}
+	return m_controller->Write(_buffer, _length);
+}
+
 //-----------------------------------------------------------------------------
 // <Driver::ProcessMsg>
 // Process data received from the Z-Wave PC interface
@@ -1973,6 +2461,12 @@ void Driver::ProcessMsg(uint8* _data, uint8 _length)
 				handleCallback = false;			// Skip the callback handling - a subsequent FUNC_ID_ZW_SEND_DATA request will deal with that
 				break;
 			}
+			case FUNC_ID_ZW_SEND_DATA_MULTI:
+			{
+				HandleSendDataMultiResponse(_data);
+				handleCallback = false;			// Skip the callback handling - a subsequent FUNC_ID_ZW_SEND_DATA_MULTI request will deal with that
+				break;
+			}
 			case FUNC_ID_ZW_GET_VERSION:
 			{
 				Log::Write(LogLevel_Detail, "");
@@ -2211,6 +2705,11 @@ void Driver::ProcessMsg(uint8* _data, uint8 _length)
 				HandleSendDataRequest(_data, _length, false);
 				break;
 			}
+			case FUNC_ID_ZW_SEND_DATA_MULTI:
+			{
+				HandleSendDataMultiRequest(_data);
+				break;
+			}
 			case FUNC_ID_ZW_REPLICATION_COMMAND_COMPLETE:
 			{
 				if (m_controllerReplication)
@@ -2756,6 +3255,7 @@ void Driver::HandleSerialAPIGetInitDataResponse(uint8* _data)
 	m_initVersion = _data[2];
 	m_initCaps = _data[3];
 
+	list<uint8> warmStarted;
 	if (_data[4] == NUM_NODE_BITFIELD_BYTES)
 	{
 		for (i = 0; i < NUM_NODE_BITFIELD_BYTES; ++i)
@@ -2778,9 +3278,18 @@ void Driver::HandleSerialAPIGetInitDataResponse(uint8* _data)
 							Log::Write(LogLevel_Info, GetNodeNumber(m_currentMsg), "    Node %.3d - Known", nodeId);
 							if (!m_init)
 							{
-								// The node was read in from the config, so we
-								// only need to get its current state
-								node->SetQueryStage(Node::QueryStage_CacheLoad);
+								if (m_warmStart && node->WarmStart())
+								{
+									// The cached data is trusted, the dynamic values
+									// are refreshed in the background below
+									warmStarted.push_back(nodeId);
+								}
+								else
+								{
+									// The node was read in from the config, so we
+									// only need to get its current state
+									node->SetQueryStage(Node::QueryStage_CacheLoad);
+								}
 							}
 
 						}
@@ -2817,6 +3326,12 @@ void Driver::HandleSerialAPIGetInitDataResponse(uint8* _data)
 	}
 	m_init = true;
 
+	if (!warmStarted.empty())
+	{
+		Log::Write(LogLevel_Info, "Warm Started %d nodes from the cache", (int) warmStarted.size());
+		ScheduleWarmStartRefresh(warmStarted);
+		CheckCompletedNodeQueries();
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -3050,6 +3565,7 @@ void Driver::HandleGetRoutingInfoResponse(uint8* _data)
 	{
 		// copy the 29-byte bitmap received (29*8=232 possible nodes) into this node's neighbors member variable
 		memcpy(node->m_neighbors, &_data[2], 29);
+		m_topology->SetNeighbors(node->GetNodeId(), node->m_neighbors);
 		Log::Write(LogLevel_Info, GetNodeNumber(m_currentMsg), "    Neighbors of this node are:");
 		bool bNeighbors = false;
 		for (int by = 0; by < 29; by++)
@@ -3110,6 +3626,7 @@ void Driver::HandleSendDataRequest(uint8* _data, uint8 _length, bool _replicatio
 					node->m_averageRequestRTT = node->m_lastRequestRTT;
 				}
 				Log::Write(LogLevel_Info, nodeId, "Request RTT %d Average Request RTT %d", node->m_lastRequestRTT, node->m_averageRequestRTT);
+				m_requestRTTHistogram->Observe(node->m_lastRequestRTT / 1000.0);
 			}
 			/* if the frame has txStatus message, then extract it */
 			// petergebruers, changed test (_length > 7) to >= 23 to avoid extracting non-existent data, highest is _data[22]
@@ -3621,6 +4138,7 @@ void Driver::HandleApplicationCommandHandlerRequest(uint8* _data, bool encrypted
 				node->m_averageResponseRTT = node->m_lastResponseRTT;
 			}
 			Log::Write(LogLevel_Info, nodeId, "Response RTT %d Average Response RTT %d", node->m_lastResponseRTT, node->m_averageResponseRTT);
+			m_responseRTTHistogram->Observe(node->m_lastResponseRTT / 1000.0);
 		}
 		else
 		{
@@ -4303,6 +4821,7 @@ void Driver::PollThreadProc(Internal::Platform::Event* _exitEvent)
 
 			// reset the poll counter to the full pollIntensity value and push it at the end of the list
 			// release the value object referenced; call GetNode to ensure the node objects are locked during this period
+			bool inTransition = false;
 			{
 				Internal::LockGuard LG(m_nodeMutex);
 				(void) GetNode(valueId.GetNodeId());
@@ -4311,6 +4830,7 @@ void Driver::PollThreadProc(Internal::Platform::Event* _exitEvent)
 					continue;
 				pe.m_pollCounter = value->GetPollIntensity();
 				m_pollList.push_back(pe);
+				inTransition = value->IsInTransition();
 				value->Release();
 			}
 			// If the polling interval is for the whole poll list, calculate the time before the next poll,
@@ -4345,6 +4865,14 @@ void Driver::PollThreadProc(Internal::Platform::Event* _exitEvent)
 						}
 					}
 
+					if (requestState && inTransition)
+					{
+						// The value is refreshed once the transition is over, and polling it
+						// part way through would only report a level it is moving away from
+						Log::Write(LogLevel_Detail, node->m_nodeId, "Polling: skipping %s, which is in a transition", valueId.GetAsString().c_str());
+						requestState = false;
+					}
+
 					if (requestState)
 					{
 						// Request an update of the value
@@ -4370,6 +4898,7 @@ void Driver::PollThreadProc(Internal::Platform::Event* _exitEvent)
 			// Wait until the library isn't actively sending messages (or in the midst of a transaction)
 			int i32;
 			int loopCount = 0;
+			uint64 waitStart = Internal::Platform::TimeStamp::Now();
 			while (!m_msgQueue[MsgQueue_Poll].empty() || !m_msgQueue[MsgQueue_Send].empty() || !m_msgQueue[MsgQueue_Command].empty() || !m_msgQueue[MsgQueue_Query].empty() || m_currentMsg != NULL)
 			{
 				i32 = Internal::Platform::Wait::Single(_exitEvent, 10);		// test conditions every 10ms
@@ -4386,6 +4915,7 @@ void Driver::PollThreadProc(Internal::Platform::Event* _exitEvent)
 					//					assert( 0 );
 				}
 			}
+			m_pollLagHistogram->Observe((Internal::Platform::TimeStamp::Now() - waitStart) / 1e9);
 
 			// ready for next poll...insert the pollInterval delay
 			i32 = Internal::Platform::Wait::Single(_exitEvent, pollInterval);
@@ -4747,6 +5277,49 @@ uint32 Driver::GetNodeNeighbors(uint8 const _nodeId, uint8** o_neighbors)
 	return numNeighbors;
 }
 
+//-----------------------------------------------------------------------------
+// <Driver::GetNodeHopCount>
+// Gets the number of hops from the controller to a node
+//-----------------------------------------------------------------------------
+int32 Driver::GetNodeHopCount(uint8 const _nodeId)
+{
+	return m_topology->GetHopCount(m_Controller_nodeId, _nodeId);
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::GetArticulationPoints>
+// Gets the nodes whose failure would split the network
+//-----------------------------------------------------------------------------
+uint32 Driver::GetArticulationPoints(uint8** o_nodes)
+{
+	std::vector<uint8> nodes;
+	m_topology->GetArticulationPoints(m_Controller_nodeId, nodes);
+	*o_nodes = NULL;
+	if (!nodes.empty())
+	{
+		*o_nodes = new uint8[nodes.size()];
+		memcpy(*o_nodes, &nodes[0], nodes.size());
+	}
+	return (uint32) nodes.size();
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::GetNodesWithoutRedundantRoutes>
+// Gets the nodes a single failure would cut off from the controller
+//-----------------------------------------------------------------------------
+uint32 Driver::GetNodesWithoutRedundantRoutes(uint8** o_nodes)
+{
+	std::vector<uint8> nodes;
+	m_topology->GetNodesWithoutRedundantRoutes(m_Controller_nodeId, nodes);
+	*o_nodes = NULL;
+	if (!nodes.empty())
+	{
+		*o_nodes = new uint8[nodes.size()];
+		memcpy(*o_nodes, &nodes[0], nodes.size());
+	}
+	return (uint32) nodes.size();
+}
+
 //-----------------------------------------------------------------------------
 // <Driver::GetNodeManufacturerName>
 // Get the manufacturer name for the node with the specified ID
@@ -5730,6 +6303,250 @@ void Driver::SwitchAllOff()
 	}
 }
 
+//-----------------------------------------------------------------------------
+//	Multicast
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// <Driver::SetValueMulticast>
+// Set the same level on a set of values, grouping them into ZW_SEND_DATA_MULTI
+// frames where possible and falling back to singlecast for the rest
+//-----------------------------------------------------------------------------
+bool Driver::SetValueMulticast(vector<ValueID> const& _ids, uint8 const _level)
+{
+	map<uint8, vector<ValueID> > groups;	// Command Class Id -> values that can share a multicast frame
+	vector<ValueID> singlecast;
+	{
+		Internal::LockGuard LG(m_nodeMutex);
+		for (vector<ValueID>::const_iterator it = _ids.begin(); it != _ids.end(); ++it)
+		{
+			if (it->GetHomeId() != m_homeId)
+			{
+				Log::Write(LogLevel_Warning, it->GetNodeId(), "SetValueMulticast: ValueID belongs to Home ID 0x%.8x - Ignoring", it->GetHomeId());
+				continue;
+			}
+			Node* node = GetNode(it->GetNodeId());
+			if (node != NULL && IsMulticastCapable(node, *it))
+			{
+				groups[it->GetCommandClassId()].push_back(*it);
+			}
+			else
+			{
+				singlecast.push_back(*it);
+			}
+		}
+	}
+
+	bool res = false;
+	for (map<uint8, vector<ValueID> >::iterator git = groups.begin(); git != groups.end(); ++git)
+	{
+		vector<ValueID>& ids = git->second;
+		if (ids.size() < 2)
+		{
+			// Nothing to gain from a multicast frame for a single node
+			singlecast.insert(singlecast.end(), ids.begin(), ids.end());
+			continue;
+		}
+
+		for (size_t i = 0; i < ids.size(); i += MAX_MULTICAST_NODES)
+		{
+			vector<ValueID> chunk(ids.begin() + i, ids.begin() + min(ids.size(), i + MAX_MULTICAST_NODES));
+			SendDataMulti(git->first, chunk, _level);
+		}
+
+		// Multicast frames are not acknowledged by the receiving nodes, so
+		// queue a Get behind them to confirm each node actually changed state
+		Internal::LockGuard LG(m_nodeMutex);
+		for (vector<ValueID>::iterator it = ids.begin(); it != ids.end(); ++it)
+		{
+			if (Node* node = GetNode(it->GetNodeId()))
+			{
+				if (Internal::CC::CommandClass* cc = node->GetCommandClass(it->GetCommandClassId()))
+				{
+					cc->RequestValue(0, it->GetIndex(), it->GetInstance(), MsgQueue_Send);
+				}
+			}
+		}
+		res = true;
+	}
+
+	for (vector<ValueID>::iterator it = singlecast.begin(); it != singlecast.end(); ++it)
+	{
+		Internal::LockGuard LG(m_nodeMutex);
+		if (Internal::VC::Value* value = GetValue(*it))
+		{
+			Log::Write(LogLevel_Info, it->GetNodeId(), "SetValueMulticast: Node cannot take part in a multicast - sending as singlecast");
+			switch (it->GetType())
+			{
+				case ValueID::ValueType_Bool:
+				{
+					res |= static_cast<Internal::VC::ValueBool*>(value)->Set(_level != 0);
+					break;
+				}
+				case ValueID::ValueType_Byte:
+				{
+					res |= static_cast<Internal::VC::ValueByte*>(value)->Set(_level);
+					break;
+				}
+				default:
+				{
+					Log::Write(LogLevel_Warning, it->GetNodeId(), "SetValueMulticast: ValueID is not a Bool or Byte Value - Ignoring");
+					break;
+				}
+			}
+			value->Release();
+		}
+	}
+	return res;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::IsMulticastCapable>
+// Check whether a value can be set on its node via a multicast frame
+//-----------------------------------------------------------------------------
+bool Driver::IsMulticastCapable(Node* _node, ValueID const& _id)
+{
+	// Multicast frames are not routed, and sleeping or FLiRS nodes would miss them
+	if (_node->GetNodeId() == m_Controller_nodeId || !_node->IsListeningDevice() || _node->IsFrequentListeningDevice() || !_node->IsNodeAlive())
+	{
+		return false;
+	}
+
+	uint8 const ccId = _id.GetCommandClassId();
+	if (ccId == Internal::CC::Basic::StaticGetCommandClassId())
+	{
+		if (_id.GetIndex() != ValueID_Index_Basic::Set)
+		{
+			return false;
+		}
+	}
+	else if (ccId == Internal::CC::SwitchBinary::StaticGetCommandClassId())
+	{
+		if (_id.GetIndex() != ValueID_Index_SwitchBinary::Level)
+		{
+			return false;
+		}
+	}
+	else if (ccId == Internal::CC::SwitchMultilevel::StaticGetCommandClassId())
+	{
+		if (_id.GetIndex() != ValueID_Index_SwitchMultiLevel::Level)
+		{
+			return false;
+		}
+	}
+	else
+	{
+		return false;
+	}
+
+	// Endpoints would need Multi Channel encapsulation, and secured
+	// Command Classes need a per node nonce, so neither can be multicast
+	Internal::CC::CommandClass* cc = _node->GetCommandClass(ccId);
+	if (cc == NULL || _id.GetInstance() != 1 || cc->GetEndPoint(1) != 0 || cc->IsSecured())
+	{
+		return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::SendDataMulti>
+// Queue one ZW_SEND_DATA_MULTI frame carrying a Set command for all the nodes
+//-----------------------------------------------------------------------------
+void Driver::SendDataMulti(uint8 const _commandClassId, vector<ValueID> const& _ids, uint8 const _level)
+{
+	uint8 level = _level;
+	if (_commandClassId == Internal::CC::SwitchBinary::StaticGetCommandClassId())
+	{
+		level = _level ? 0xff : 0x00;
+	}
+
+	string nodes;
+	Internal::Msg* msg = new Internal::Msg("SendDataMulti", 0xff, REQUEST, FUNC_ID_ZW_SEND_DATA_MULTI, true);
+	msg->Append((uint8) _ids.size());
+	for (vector<ValueID>::const_iterator it = _ids.begin(); it != _ids.end(); ++it)
+	{
+		char str[8];
+		snprintf(str, sizeof(str), " %d", it->GetNodeId());
+		nodes += str;
+		msg->Append(it->GetNodeId());
+	}
+	msg->Append(3);
+	msg->Append(_commandClassId);
+	msg->Append(0x01);		// Basic, SwitchBinary and SwitchMultilevel all use 0x01 for their Set command
+	msg->Append(level);
+	// Multicast frames are never acknowledged, so don't ask the controller to wait for one
+	msg->Append(m_transmitOptions & ~TRANSMIT_OPTION_ACK);
+
+	Log::Write(LogLevel_Info, "Queuing multicast %s Set (level=%d) to nodes%s", Internal::CC::CommandClasses::GetName(_commandClassId).c_str(), level, nodes.c_str());
+	SendMsg(msg, MsgQueue_Send);
+
+	m_multicastWriteCnt++;
+	m_multicastNodeCnt += (uint32) _ids.size();
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::HandleSendDataMultiResponse>
+// Process a response from the Z-Wave PC interface
+//-----------------------------------------------------------------------------
+void Driver::HandleSendDataMultiResponse(uint8* _data)
+{
+	if (_data[2])
+	{
+		Log::Write(LogLevel_Detail, "  ZW_SEND_DATA_MULTI delivered to Z-Wave stack");
+	}
+	else
+	{
+		Log::Write(LogLevel_Error, "ERROR: ZW_SEND_DATA_MULTI could not be delivered to Z-Wave stack");
+		m_nondelivery++;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::HandleSendDataMultiRequest>
+// Process a request from the Z-Wave PC interface
+//-----------------------------------------------------------------------------
+void Driver::HandleSendDataMultiRequest(uint8* _data)
+{
+	Log::Write(LogLevel_Detail, "  ZW_SEND_DATA_MULTI Request with callback ID 0x%.2x received (expected 0x%.2x)", _data[2], m_expectedCallbackId);
+	if (_data[2] != m_expectedCallbackId)
+	{
+		// Wrong callback ID
+		m_callbacks++;
+		Log::Write(LogLevel_Warning, "WARNING: Unexpected Callback ID received");
+		return;
+	}
+
+	if (_data[3] != TRANSMIT_COMPLETE_OK)
+	{
+		Log::Write(LogLevel_Warning, "WARNING: ZW_SEND_DATA_MULTI failed with status 0x%.2x", _data[3]);
+		return;
+	}
+
+	if (m_currentMsg == NULL || m_currentMsg->GetBuffer()[3] != FUNC_ID_ZW_SEND_DATA_MULTI)
+	{
+		return;
+	}
+
+	// Compare the multicast against the time the same nodes have been taking to
+	// acknowledge singlecast frames, to show what the multicast path saved.
+	int32 elapsed = -m_multicastSentTS.TimeRemaining();
+	int32 singlecast = 0;
+	uint8 const* buffer = m_currentMsg->GetBuffer();
+	uint8 const numNodes = buffer[4];
+	{
+		Internal::LockGuard LG(m_nodeMutex);
+		for (uint8 i = 0; i < numNodes; ++i)
+		{
+			if (Node* node = GetNode(buffer[5 + i]))
+			{
+				singlecast += node->m_averageRequestRTT;
+			}
+		}
+	}
+	Log::Write(LogLevel_Info, "Multicast to %d nodes completed in %d ms (estimated singlecast time %d ms)", numNodes, elapsed, singlecast);
+}
+
 //-----------------------------------------------------------------------------
 // <Driver::SetConfigParam>
 // Set the value of one of the configuration parameters of a device
@@ -5745,6 +6562,21 @@ bool Driver::SetConfigParam(uint8 const _nodeId, uint8 const _param, int32 _valu
 	return false;
 }
 
+//-----------------------------------------------------------------------------
+// <Driver::SetConfigParams>
+// Set consecutive configuration parameters of the same size in a device
+//-----------------------------------------------------------------------------
+bool Driver::SetConfigParams(uint8 const _nodeId, uint16 const _firstParam, vector<int32> const& _values, uint8 const _size)
+{
+	Internal::LockGuard LG(m_nodeMutex);
+	if (Node* node = GetNode(_nodeId))
+	{
+		return node->SetConfigParams(_firstParam, _values, _size);
+	}
+
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 // <Driver::RequestConfigParam>
 // Request the value of one of the configuration parameters of a device
@@ -5922,7 +6754,10 @@ void Driver::NotifyWatchers()
 			default:
 				break;
 		}
-		Log::Write(LogLevel_Detail, notification->GetNodeId(), "Notification: %s", notification->GetAsString().c_str());
+		if (Log::IsLevelEnabled(LogLevel_Detail))
+		{
+			Log::Write(LogLevel_Detail, notification->GetNodeId(), "Notification: %s", notification->GetAsString().c_str());
+		}
 
 		Manager::Get()->NotifyWatchers(notification);
 
@@ -6553,6 +7388,10 @@ void Driver::GetDriverStatistics(DriverData* _data)
 	_data->m_routedbusy = m_routedbusy;
 	_data->m_broadcastReadCnt = m_broadcastReadCnt;
 	_data->m_broadcastWriteCnt = m_broadcastWriteCnt;
+	_data->m_multicastWriteCnt = m_multicastWriteCnt;
+	_data->m_multicastNodeCnt = m_multicastNodeCnt;
+	_data->m_duplicatesDropped = m_duplicatesDropped;
+	_data->m_setsSuperseded = m_setsSuperseded;
 }
 
 //-----------------------------------------------------------------------------
@@ -6569,6 +7408,86 @@ void Driver::GetNodeStatistics(uint8 const _nodeId, Node::NodeData* _data)
 	}
 }
 
+//-----------------------------------------------------------------------------
+// <Driver::CollectMetrics>
+// Add the driver and node statistics to a metrics snapshot
+//-----------------------------------------------------------------------------
+void Driver::CollectMetrics(Internal::MetricsSnapshot& _snapshot)
+{
+	char buf[64];
+	snprintf(buf, sizeof(buf), "home_id=\"0x%.8x\"", m_homeId);
+	string const home = buf;
+
+	DriverData data;
+	GetDriverStatistics(&data);
+	_snapshot.AddGauge("ozw_driver_uptime_seconds", "Time since the driver was started.", home, (Internal::Platform::TimeStamp::Now() - m_startNow) / 1e9);
+	_snapshot.AddCounter("ozw_frames_received_total", "SOF bytes received from the controller.", home, data.m_SOFCnt);
+	_snapshot.AddCounter("ozw_messages_received_total", "Messages successfully read from the controller.", home, data.m_readCnt);
+	_snapshot.AddCounter("ozw_messages_sent_total", "Messages successfully written to the controller.", home, data.m_writeCnt);
+	_snapshot.AddCounter("ozw_acks_total", "ACK bytes received from the controller.", home, data.m_ACKCnt);
+	_snapshot.AddCounter("ozw_cans_total", "CAN bytes received from the controller.", home, data.m_CANCnt);
+	_snapshot.AddCounter("ozw_naks_total", "NAK bytes received from the controller.", home, data.m_NAKCnt);
+	_snapshot.AddCounter("ozw_retries_total", "Messages retransmitted.", home, data.m_retries);
+	_snapshot.AddCounter("ozw_dropped_total", "Messages dropped and not delivered.", home, data.m_dropped);
+	_snapshot.AddCounter("ozw_read_aborts_total", "Reads aborted due to timeouts.", home, data.m_readAborts);
+	_snapshot.AddCounter("ozw_bad_checksums_total", "Frames received with a bad checksum.", home, data.m_badChecksum);
+	_snapshot.AddCounter("ozw_out_of_frame_total", "Bytes received out of framing.", home, data.m_OOFCnt);
+	_snapshot.AddCounter("ozw_ack_waiting_total", "Unsolicited messages received while waiting for an ACK.", home, data.m_ACKWaiting);
+	_snapshot.AddCounter("ozw_unexpected_callbacks_total", "Callbacks that did not match the message in flight.", home, data.m_callbacks);
+	_snapshot.AddCounter("ozw_broadcasts_received_total", "Broadcast frames received.", home, data.m_broadcastReadCnt);
+	_snapshot.AddCounter("ozw_broadcasts_sent_total", "Broadcast frames sent.", home, data.m_broadcastWriteCnt);
+	_snapshot.AddCounter("ozw_multicasts_sent_total", "Multicast frames sent.", home, data.m_multicastWriteCnt);
+	_snapshot.AddCounter("ozw_duplicates_dropped_total", "Queued Gets dropped as duplicates.", home, data.m_duplicatesDropped);
+	_snapshot.AddCounter("ozw_sets_superseded_total", "Queued Sets replaced by a newer Set.", home, data.m_setsSuperseded);
+
+	static char const* const errorHelp = "Transmissions that failed, by reason.";
+	_snapshot.AddCounter("ozw_transmit_errors_total", errorHelp, home + ",reason=\"bad_route\"", data.m_badroutes);
+	_snapshot.AddCounter("ozw_transmit_errors_total", errorHelp, home + ",reason=\"no_ack\"", data.m_noack);
+	_snapshot.AddCounter("ozw_transmit_errors_total", errorHelp, home + ",reason=\"network_busy\"", data.m_netbusy);
+	_snapshot.AddCounter("ozw_transmit_errors_total", errorHelp, home + ",reason=\"not_idle\"", data.m_notidle);
+	_snapshot.AddCounter("ozw_transmit_errors_total", errorHelp, home + ",reason=\"non_delivery\"", data.m_nondelivery);
+	_snapshot.AddCounter("ozw_transmit_errors_total", errorHelp, home + ",reason=\"routed_busy\"", data.m_routedbusy);
+
+	{
+		Internal::LockGuard LG(m_sendMutex);
+		for (int32 i = 0; i < MsgQueue_Count; ++i)
+		{
+			_snapshot.AddGauge("ozw_send_queue_depth", "Messages waiting in each send queue.", home + ",queue=\"" + c_sendQueueNames[i] + "\"", (double) m_msgQueue[i].size());
+		}
+	}
+	{
+		Internal::LockGuard LG(m_pollMutex);
+		_snapshot.AddGauge("ozw_poll_list_size", "Values in the poll list.", home, (double) m_pollList.size());
+	}
+
+	_snapshot.AddHistogram("ozw_request_rtt_seconds", "Time from sending a request until the node acknowledged it.", home, *m_requestRTTHistogram);
+	_snapshot.AddHistogram("ozw_response_rtt_seconds", "Time from sending a request until the node's reply arrived.", home, *m_responseRTTHistogram);
+	_snapshot.AddHistogram("ozw_poll_lag_seconds", "Time each poll waited for the send queues to drain.", home, *m_pollLagHistogram);
+
+	Internal::LockGuard LG(m_nodeMutex);
+	for (int i = 0; i < 256; ++i)
+	{
+		Node* node = m_nodes[i];
+		if (!node)
+		{
+			continue;
+		}
+		snprintf(buf, sizeof(buf), ",node=\"%d\"", i);
+		string const labels = home + buf;
+		_snapshot.AddGauge("ozw_node_alive", "1 if the node is alive, 0 if it has been marked dead.", labels, node->IsNodeAlive() ? 1 : 0);
+		_snapshot.AddCounter("ozw_node_sent_total", "Messages sent to the node.", labels, node->m_sentCnt);
+		_snapshot.AddCounter("ozw_node_sent_failed_total", "Messages to the node that failed.", labels, node->m_sentFailed);
+		_snapshot.AddCounter("ozw_node_retries_total", "Messages to the node that were retried.", labels, node->m_retries);
+		_snapshot.AddCounter("ozw_node_received_total", "Messages received from the node.", labels, node->m_receivedCnt);
+		_snapshot.AddCounter("ozw_node_received_duplicates_total", "Duplicate messages received from the node.", labels, node->m_receivedDups);
+		_snapshot.AddCounter("ozw_node_received_unsolicited_total", "Unsolicited messages received from the node.", labels, node->m_receivedUnsolicited);
+		_snapshot.AddGauge("ozw_node_request_rtt_seconds", "Last time from request to acknowledgement.", labels, node->m_lastRequestRTT / 1000.0);
+		_snapshot.AddGauge("ozw_node_request_rtt_average_seconds", "Running average time from request to acknowledgement.", labels, node->m_averageRequestRTT / 1000.0);
+		_snapshot.AddGauge("ozw_node_response_rtt_seconds", "Last time from request to reply.", labels, node->m_lastResponseRTT / 1000.0);
+		_snapshot.AddGauge("ozw_node_response_rtt_average_seconds", "Running average time from request to reply.", labels, node->m_averageResponseRTT / 1000.0);
+	}
+}
+
 //-----------------------------------------------------------------------------
 // <Driver::LogDriverStatistics>
 // Report driver statistics to the driver's log
@@ -6595,6 +7514,10 @@ void Driver::LogDriverStatistics()
 	Log::Write(LogLevel_Always, "Total messages successfully received: . . . . . . . . . . %ld", data.m_readCnt);
 	Log::Write(LogLevel_Always, "Total Messages successfully sent: . . . . . . . . . . . . %ld", data.m_writeCnt);
 	Log::Write(LogLevel_Always, "ACKs received from controller:  . . . . . . . . . . . . . %ld", data.m_ACKCnt);
+	Log::Write(LogLevel_Always, "Multicast frames sent:  . . . . . . . . . . . . . . . . . %ld", data.m_multicastWriteCnt);
+	Log::Write(LogLevel_Always, "Singlecast frames saved by multicast: . . . . . . . . . . %ld", data.m_multicastNodeCnt);
+	Log::Write(LogLevel_Always, "Duplicate queued requests dropped:  . . . . . . . . . . . %ld", data.m_duplicatesDropped);
+	Log::Write(LogLevel_Always, "Queued Sets replaced by a newer value:  . . . . . . . . . %ld", data.m_setsSuperseded);
 	// Consider tracking and adding:
 	//		Initialization messages
 	//		Ad-hoc command messages
@@ -6670,7 +7593,7 @@ bool Driver::SendEncryptedMessage()
 	m_expectedCallbackId = m_currentMsg->GetCallbackId();
 	Log::Write(LogLevel_Info, m_currentMsg->GetTargetNodeId(), "Sending (%s) message (Callback ID=0x%.2x, Expected Reply=0x%.2x) - %s", c_sendQueueNames[m_currentMsgQueueSource], m_expectedCallbackId, m_expectedReply, m_currentMsg->GetAsString().c_str());
 
-	m_controller->Write(buffer, length);
+	WriteToController(buffer, length);
 	m_currentMsg->clearNonce();
 
 	return true;
@@ -6703,7 +7626,7 @@ bool Driver::SendNonceRequest(string logmsg)
 	}
 	Log::Write(LogLevel_Info, m_currentMsg->GetTargetNodeId(), "Sending (%s) message (Callback ID=0x%.2x, Expected Reply=0x%.2x) - Nonce_Get(%s) - %s:", c_sendQueueNames[m_currentMsgQueueSource], 2, m_expectedReply, logmsg.c_str(), Internal::PktToString(m_buffer, 10).c_str());
 
-	m_controller->Write(m_buffer, 11);
+	WriteToController(m_buffer, 11);
 
 	return true;
 }
@@ -6810,7 +7733,7 @@ void Driver::SendNonceKey(uint8 nodeId, uint8 *nonce)
 	}
 	Log::Write(LogLevel_Info, nodeId, "Sending (%s) message (Callback ID=0x%.2x, Expected Reply=0x%.2x) - Nonce_Report - %s:", c_sendQueueNames[m_currentMsgQueueSource], m_buffer[17], m_expectedReply, Internal::PktToString(m_buffer, 19).c_str());
 
-	m_controller->Write(m_buffer, 19);
+	WriteToController(m_buffer, 19);
 
 	m_nonceReportSent = nodeId;
 }
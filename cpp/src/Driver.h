@@ -73,9 +73,14 @@ namespace OpenZWave
 		struct DNSLookup;
 		class i_HttpClient;
 		struct HttpDownload;
+		class FrameCapture;
 		class ManufacturerSpecificDB;
+		class MetricsHistogram;
+		class MetricsSnapshot;
 		class Msg;
 		class TimerThread;
+		class Timer;
+		class Topology;
 	}
 
 	/** \brief The Driver class handles communication between OpenZWave
@@ -112,7 +117,8 @@ namespace OpenZWave
 			{
 				ControllerInterface_Unknown = 0,
 				ControllerInterface_Serial,
-				ControllerInterface_Hid
+				ControllerInterface_Hid,
+				ControllerInterface_Replay		/**< The controller path is a capture file recorded with the CaptureFile option */
 			};
 
 			//-----------------------------------------------------------------------------
@@ -186,7 +192,12 @@ namespace OpenZWave
 			bool m_awakeNodesQueried; /**< Set to true once the driver has polled all awake nodes */
 			bool m_allNodesQueried; /**< Set to true once the driver has polled all nodes */
 			bool m_notifytransactions;
+			bool m_suppressValueRefresh; /**< Cached SuppressValueRefresh option, read on every value report */
+			uint32 m_valueHistorySize; /**< Entries kept in each tier of a value's history, or 0 to keep none (ValueHistorySize option) */
+			uint32 m_valueHistoryResolution; /**< Seconds per entry of the downsampled history (ValueHistoryResolution option) */
+			bool m_valueHistoryPersist; /**< Save the value histories alongside the cache (ValueHistoryPersist option) */
 			Internal::Platform::TimeStamp m_startTime; /**< Time this driver started (for log report purposes) */
+			uint64 m_startNow; /**< TimeStamp::Now() when this driver started, for the uptime metric */
 
 			//-----------------------------------------------------------------------------
 			//	Configuration
@@ -195,6 +206,26 @@ namespace OpenZWave
 			void RequestConfig();							// Get the network configuration from the Z-Wave network
 			bool ReadCache();								// Read the configuration from a file
 			void WriteCache();								// Save the configuration to a file
+			void ReadValueHistory();						// Restore the value histories saved by WriteValueHistory
+			void WriteValueHistory();						// Save the value histories next to the cache
+
+			//-----------------------------------------------------------------------------
+			//	Warm Start
+			//-----------------------------------------------------------------------------
+		private:
+			/**
+			 *  Schedule the background refresh of dynamic values for nodes that were warm
+			 *  started from the cache. Listening nodes are refreshed first, then FLiRS devices,
+			 *  and finally sleeping devices (whose requests wait on their WakeUp queue). Each
+			 *  node is spaced WarmStartRefreshDelay milliseconds from the previous one.
+			 *  \param _nodes The node IDs that were warm started.
+			 */
+			void ScheduleWarmStartRefresh(list<uint8> const& _nodes);
+			void WarmStartRefresh(uint32 _nodeId);						// TimerThread callback that requests the dynamic values of a single node
+
+			bool m_warmStart;								// Trust the cache for nodes that completed their interview (WarmStart option)
+			int32 m_warmStartRefreshDelay;					// Delay between warm start refreshes of consecutive nodes
+			Internal::Timer* m_warmStartTimer;				// Owns the scheduled warm start refresh events
 
 			//-----------------------------------------------------------------------------
 			//	Timer
@@ -327,6 +358,8 @@ namespace OpenZWave
 			ControllerInterface m_controllerInterfaceType;				// Specifies the controller's hardware interface
 			string m_controllerPath;							// name or path used to open the controller hardware.
 			Internal::Platform::Controller* m_controller;								// Handles communications with the controller hardware.
+			Internal::FrameCapture* m_capture;								// Records the serial traffic if the CaptureFile option is set, otherwise NULL.
+			Internal::Topology* m_topology;								// Graph of the network built from the nodes' neighbor lists.
 			uint32 m_homeId;									// Home ID of the Z-Wave controller.  Not valid until the DriverReady notification has been received.
 			string m_libraryVersion;							// Version of the Z-Wave Library used by the controller.
 			string m_libraryTypeName;							// Name describing the library type.
@@ -355,6 +388,7 @@ namespace OpenZWave
 			//-----------------------------------------------------------------------------
 		private:
 			bool ReadMsg();
+			uint32 WriteToController(uint8* _buffer, uint32 _length);		// Write to the controller, recording the bytes if capturing
 			void ProcessMsg(uint8* _data, uint8 _length);
 
 			void HandleGetVersionResponse(uint8* _data);
@@ -498,6 +532,9 @@ namespace OpenZWave
 			string GetNodeSpecificString(uint8 const _nodeId, uint8 _instance);
 			string GetNodeType(uint8 const _nodeId);
 			uint32 GetNodeNeighbors(uint8 const _nodeId, uint8** o_neighbors);
+			int32 GetNodeHopCount(uint8 const _nodeId);
+			uint32 GetArticulationPoints(uint8** o_nodes);
+			uint32 GetNodesWithoutRedundantRoutes(uint8** o_nodes);
 
 			string GetNodeManufacturerName(uint8 const _nodeId);
 			string GetNodeProductName(uint8 const _nodeId);
@@ -797,6 +834,32 @@ namespace OpenZWave
 			MsgQueue m_currentMsgQueueSource;			// identifies which queue held m_currentMsg
 			Internal::Platform::TimeStamp m_resendTimeStamp;
 
+			//-----------------------------------------------------------------------------
+			// Pending message index
+			//-----------------------------------------------------------------------------
+		private:
+			// Messages waiting in the send queues are indexed so that a Get which is already
+			// queued is dropped, and a Set of a value that is already queued replaces the
+			// older Set in place.  All of these are called with m_sendMutex held.
+			bool MergePendingMsg(MsgQueue const _queue, Internal::Msg* _msg, string const& _valueSet, string* o_key);
+			void IndexPendingMsg(MsgQueue const _queue, string const& _key);
+			void UnindexPendingMsg(Internal::Msg* _msg);
+			void BeginValueSet(ValueID const& _id, Internal::VC::Value const* _value);	// Called by Value::Set around the Command Class SetValue call, so Sets can be keyed by ValueID
+			bool EndValueSet();								// Returns true if the Set was sent supervised, so no Get is needed to confirm it
+			void SuperviseValueSet(Internal::Msg* _msg);
+
+			struct PendingMsgKey
+			{
+					string m_key;
+					uint32 m_valueSet;	// Value::Set call that queued the message, or 0 for Gets
+			};
+			map<string, list<MsgQueueItem>::iterator> m_pendingMsgs;	// Queue, node and payload or ValueID -> queued message
+			map<Internal::Msg*, PendingMsgKey> m_pendingMsgKeys;	// Queued message -> its key in m_pendingMsgs
+			string m_valueSetKey;									// Command Class, instance and index of the value being Set, if any
+			uint32 m_valueSetSerial;
+			Internal::VC::Value const* m_valueSetValue;				// Target of the value being Set, if any
+			bool m_valueSetSupervised;								// A Set of m_valueSetValue was wrapped in a Supervision Get
+
 			//-----------------------------------------------------------------------------
 			// Network functions
 			//-----------------------------------------------------------------------------
@@ -834,12 +897,28 @@ namespace OpenZWave
 			void SwitchAllOn();
 			void SwitchAllOff();
 
+			//-----------------------------------------------------------------------------
+			// Multicast
+			//-----------------------------------------------------------------------------
+		private:
+			// The public interface is provided via the wrappers in the Manager class
+			bool SetValueMulticast(vector<ValueID> const& _ids, uint8 const _level);
+			bool IsMulticastCapable(Node* _node, ValueID const& _id);
+			void SendDataMulti(uint8 const _commandClassId, vector<ValueID> const& _ids, uint8 const _level);
+			void HandleSendDataMultiResponse(uint8* _data);
+			void HandleSendDataMultiRequest(uint8* _data);
+
+			uint32 m_multicastWriteCnt;					// Number of ZW_SEND_DATA_MULTI frames sent
+			uint32 m_multicastNodeCnt;					// Number of singlecast frames replaced by multicast frames
+			Internal::Platform::TimeStamp m_multicastSentTS;	// When the last ZW_SEND_DATA_MULTI frame was written
+
 			//-----------------------------------------------------------------------------
 			// Configuration Parameters	(wrappers for the Node methods)
 			//-----------------------------------------------------------------------------
 		private:
 			// The public interface is provided via the wrappers in the Manager class
 			bool SetConfigParam(uint8 const _nodeId, uint8 const _param, int32 _value, uint8 const _size);
+			bool SetConfigParams(uint8 const _nodeId, uint16 const _firstParam, vector<int32> const& _values, uint8 const _size);
 			void RequestConfigParam(uint8 const _nodeId, uint8 const _param);
 
 			//-----------------------------------------------------------------------------
@@ -893,12 +972,17 @@ namespace OpenZWave
 					uint32 m_routedbusy;		// Number of messages received with routed busy status
 					uint32 m_broadcastReadCnt;	// Number of broadcasts read
 					uint32 m_broadcastWriteCnt;	// Number of broadcasts sent
+					uint32 m_multicastWriteCnt;	// Number of multicast frames sent
+					uint32 m_multicastNodeCnt;	// Number of singlecast frames replaced by multicast frames
+					uint32 m_duplicatesDropped;	// Number of queued Gets dropped as duplicates
+					uint32 m_setsSuperseded;	// Number of queued Sets replaced by a newer Set
 			};
 			void LogDriverStatistics();
 
 		private:
 			void GetDriverStatistics(DriverData* _data);
 			void GetNodeStatistics(uint8 const _nodeId, Node::NodeData* _data);
+			void CollectMetrics(Internal::MetricsSnapshot& _snapshot);		// Add the driver and node statistics to a metrics snapshot
 
 			uint32 m_SOFCnt;			// Number of SOF bytes received
 			uint32 m_ACKWaiting;		// Number of unsolicited messages while waiting for an ACK
@@ -922,6 +1006,11 @@ namespace OpenZWave
 			uint32 m_routedbusy;		// Number of messages received with routed busy status
 			uint32 m_broadcastReadCnt;	// Number of broadcasts read
 			uint32 m_broadcastWriteCnt;	// Number of broadcasts sent
+			uint32 m_duplicatesDropped;	// Number of queued Gets dropped as duplicates
+			uint32 m_setsSuperseded;	// Number of queued Sets replaced by a newer Set
+			Internal::MetricsHistogram* m_requestRTTHistogram;	// Time from sending a request until the node acknowledged it, across all nodes
+			Internal::MetricsHistogram* m_responseRTTHistogram;	// Time from sending a request until the node's reply arrived, across all nodes
+			Internal::MetricsHistogram* m_pollLagHistogram;		// Time each poll waited for the send queues to drain
 			//time_t m_commandStart;	// Start time of last command
 			//time_t m_timeoutLost;		// Cumulative time lost to timeouts
 
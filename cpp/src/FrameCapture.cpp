@@ -0,0 +1,200 @@
+//-----------------------------------------------------------------------------
+//
+//	FrameCapture.cpp
+//
+//	Recording of the serial API traffic between a driver and its controller
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <ctype.h>
+#include <string.h>
+
+#include "FrameCapture.h"
+#include "Utils.h"
+#include "platform/Log.h"
+#include "platform/Mutex.h"
+#include "platform/TimeStamp.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		static uint8 const c_captureMagic[4] =
+		{ 'O', 'Z', 'W', 'C' };
+
+//-----------------------------------------------------------------------------
+// <FrameCapture::Create>
+// Create a capture file and write its header
+//-----------------------------------------------------------------------------
+		FrameCapture* FrameCapture::Create(string const& _path, string const& _controllerPath)
+		{
+			string path = GetFileName(_path, _controllerPath);
+			FILE* file = fopen(path.c_str(), "wb");
+			if (!file)
+			{
+				Log::Write(LogLevel_Error, "Cannot create capture file %s", path.c_str());
+				return NULL;
+			}
+
+			uint8 header[8] =
+			{ c_captureMagic[0], c_captureMagic[1], c_captureMagic[2], c_captureMagic[3], Version, 0, 0, 0 };
+			if (fwrite(header, 1, sizeof(header), file) != sizeof(header))
+			{
+				Log::Write(LogLevel_Error, "Cannot write capture file %s", path.c_str());
+				fclose(file);
+				return NULL;
+			}
+
+			Log::Write(LogLevel_Info, "Capturing serial frames to %s", path.c_str());
+			return new FrameCapture(file);
+		}
+
+//-----------------------------------------------------------------------------
+// <FrameCapture::GetFileName>
+// Add the controller path to the capture file name, before any extension
+//-----------------------------------------------------------------------------
+		string FrameCapture::GetFileName(string const& _path, string const& _controllerPath)
+		{
+			string controller;
+			for (string::const_iterator it = _controllerPath.begin(); it != _controllerPath.end(); ++it)
+			{
+				char c = *it;
+				if (isalnum((unsigned char) c) || c == '-')
+				{
+					controller += c;
+				}
+				else if (!controller.empty() && controller[controller.size() - 1] != '_')
+				{
+					controller += '_';
+				}
+			}
+			if (!controller.empty() && controller[controller.size() - 1] == '_')
+			{
+				controller.erase(controller.size() - 1);
+			}
+			if (controller.empty())
+			{
+				return _path;
+			}
+
+			size_t slash = _path.find_last_of("/\\");
+			size_t dot = _path.find_last_of('.');
+			if (dot == string::npos || (slash != string::npos && dot < slash))
+			{
+				dot = _path.size();
+			}
+			return _path.substr(0, dot) + "-" + controller + _path.substr(dot);
+		}
+
+//-----------------------------------------------------------------------------
+// <FrameCapture::FrameCapture>
+// Constructor
+//-----------------------------------------------------------------------------
+		FrameCapture::FrameCapture(FILE* _file) :
+				m_file(_file), m_last(Platform::TimeStamp::Now()), m_mutex(new Platform::Mutex())
+		{
+		}
+
+//-----------------------------------------------------------------------------
+// <FrameCapture::~FrameCapture>
+// Destructor
+//-----------------------------------------------------------------------------
+		FrameCapture::~FrameCapture()
+		{
+			fclose(m_file);
+			m_mutex->Release();
+		}
+
+//-----------------------------------------------------------------------------
+// <FrameCapture::Write>
+// Append one record.  The file is flushed so a capture survives a crash.
+//-----------------------------------------------------------------------------
+		void FrameCapture::Write(Direction _direction, uint8 const* _data, uint32 _length)
+		{
+			LockGuard LG(m_mutex);
+
+			uint64 now = Platform::TimeStamp::Now();
+			uint64 delta = (now - m_last) / 1000;
+			m_last = now;
+			if (delta > 0xffffffff)
+			{
+				delta = 0xffffffff;
+			}
+
+			uint8 header[7];
+			header[0] = (uint8) (delta & 0xff);
+			header[1] = (uint8) ((delta >> 8) & 0xff);
+			header[2] = (uint8) ((delta >> 16) & 0xff);
+			header[3] = (uint8) ((delta >> 24) & 0xff);
+			header[4] = (uint8) _direction;
+			header[5] = (uint8) (_length & 0xff);
+			header[6] = (uint8) ((_length >> 8) & 0xff);
+
+			fwrite(header, 1, sizeof(header), m_file);
+			fwrite(_data, 1, _length, m_file);
+			fflush(m_file);
+		}
+
+//-----------------------------------------------------------------------------
+// <FrameCapture::Load>
+// Read every record of a capture file
+//-----------------------------------------------------------------------------
+		bool FrameCapture::Load(string const& _path, std::vector<Record>& _records)
+		{
+			FILE* file = fopen(_path.c_str(), "rb");
+			if (!file)
+			{
+				Log::Write(LogLevel_Error, "Cannot open capture file %s", _path.c_str());
+				return false;
+			}
+
+			uint8 header[8];
+			if (fread(header, 1, sizeof(header), file) != sizeof(header) || memcmp(header, c_captureMagic, sizeof(c_captureMagic)) || header[4] != Version)
+			{
+				Log::Write(LogLevel_Error, "%s is not a version %d capture file", _path.c_str(), Version);
+				fclose(file);
+				return false;
+			}
+
+			uint64 time = 0;
+			uint8 recordHeader[7];
+			while (fread(recordHeader, 1, sizeof(recordHeader), file) == sizeof(recordHeader))
+			{
+				Record record;
+				time += (uint64) recordHeader[0] | ((uint64) recordHeader[1] << 8) | ((uint64) recordHeader[2] << 16) | ((uint64) recordHeader[3] << 24);
+				record.m_time = time;
+				record.m_direction = recordHeader[4] ? Direction_Outbound : Direction_Inbound;
+				uint32 length = (uint32) recordHeader[5] | ((uint32) recordHeader[6] << 8);
+				record.m_data.resize(length);
+				if (length && fread(&record.m_data[0], 1, length, file) != length)
+				{
+					Log::Write(LogLevel_Warning, "Capture file %s ends in a truncated record", _path.c_str());
+					break;
+				}
+				_records.push_back(record);
+			}
+
+			fclose(file);
+			return true;
+		}
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,110 @@
+//-----------------------------------------------------------------------------
+//
+//	FrameCapture.h
+//
+//	Recording of the serial API traffic between a driver and its controller
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _FrameCapture_H
+#define _FrameCapture_H
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class Mutex;
+		}
+
+		/** \brief Records serial API frames to a capture file.
+		 *
+		 * A capture file starts with an eight byte header: the characters "OZWC", a
+		 * version byte and three reserved bytes.  Each record that follows is:
+		 * - uint32 microseconds since the previous record (or since the capture started)
+		 * - uint8 direction, Direction_Inbound or Direction_Outbound
+		 * - uint16 length of the data
+		 * - the data: a whole SOF frame, or a single ACK, NAK or CAN byte
+		 *
+		 * All integers are little endian.  Times come from the monotonic clock.
+		 * \see Platform::ReplayController
+		 */
+		class FrameCapture
+		{
+			public:
+				enum Direction
+				{
+					Direction_Inbound = 0,		/**< Received from the controller */
+					Direction_Outbound			/**< Written to the controller */
+				};
+
+				struct Record
+				{
+						uint64 m_time;					/**< Microseconds since the start of the capture */
+						Direction m_direction;
+						std::vector<uint8> m_data;
+				};
+
+				static uint8 const Version = 1;
+
+				/**
+				 * Create a capture file, replacing any existing file.  The controller path is
+				 * added to the file name, so each controller has its own capture.
+				 * \param _path the CaptureFile option, e.g. capture.ozwc.
+				 * \param _controllerPath the controller being captured, e.g. /dev/ttyACM0 becomes capture-dev_ttyACM0.ozwc.
+				 * \return NULL if the file could not be created.
+				 */
+				static FrameCapture* Create(string const& _path, string const& _controllerPath);
+				~FrameCapture();
+
+				/**
+				 * Append a record.  May be called from any thread.
+				 */
+				void Write(Direction _direction, uint8 const* _data, uint32 _length);
+
+				/**
+				 * Read every record of a capture file.
+				 * \return false if the file could not be read or is not a capture file.  Records read before a truncated final record are kept.
+				 */
+				static bool Load(string const& _path, std::vector<Record>& _records);
+
+			private:
+				static string GetFileName(string const& _path, string const& _controllerPath);
+				FrameCapture(FILE* _file);
+				FrameCapture(FrameCapture const&);					// prevent copy
+				FrameCapture& operator =(FrameCapture const&);		// prevent assignment
+
+				FILE* m_file;
+				uint64 m_last;									// TimeStamp::Now() of the previous record
+				Platform::Mutex* m_mutex;
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_FrameCapture_H
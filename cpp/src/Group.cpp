@@ -49,6 +49,8 @@ using namespace OpenZWave;
 Group::Group(uint32 const _homeId, uint8 const _nodeId, uint8 const _groupIdx, uint8 const _maxAssociations) :
 		m_homeId(_homeId), m_nodeId(_nodeId), m_groupIdx(_groupIdx), m_maxAssociations(_maxAssociations), m_auto(false), m_multiInstance(false)
 {
+	Internal::MemoryAccounting::Attribute(this, m_homeId, m_nodeId);
+
 	char str[16];
 	snprintf(str, sizeof(str), "Group %d", m_groupIdx);
 	m_label = str;
@@ -63,6 +65,8 @@ Group::Group(uint32 const _homeId, uint8 const _nodeId, uint8 const _groupIdx, u
 Group::Group(uint32 const _homeId, uint8 const _nodeId, TiXmlElement const* _groupElement) :
 		m_homeId(_homeId), m_nodeId(_nodeId), m_groupIdx(0), m_maxAssociations(0), m_auto(false), m_multiInstance(false)
 {
+	Internal::MemoryAccounting::Attribute(this, m_homeId, m_nodeId);
+
 	int intVal;
 	char const* str;
 	vector<InstanceAssociation> pending;
@@ -32,6 +32,7 @@
 #include <vector>
 #include <map>
 #include "Defs.h"
+#include "MemoryAccounting.h"
 
 class TiXmlElement;
 
@@ -80,6 +81,14 @@ namespace OpenZWave
 		public:
 			Group(uint32 const _homeId, uint8 const _nodeId, uint8 const _groupIdx, uint8 const _maxAssociations);
 			Group(uint32 const _homeId, uint8 const _nodeId, TiXmlElement const* _valueElement);
+			static void* operator new(size_t _size)
+			{
+				return Internal::MemoryAccounting::Allocate(_size, Internal::MemoryAccounting::Category_Group);
+			}
+			static void operator delete(void* _ptr)
+			{
+				Internal::MemoryAccounting::Free(_ptr);
+			}
 			~Group()
 			{
 			}
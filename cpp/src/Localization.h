@@ -32,6 +32,7 @@
 #include <string>
 #include <map>
 #include "Defs.h"
+#include "MemoryAccounting.h"
 #include "Driver.h"
 #include "command_classes/CommandClass.h"
 
@@ -44,6 +45,14 @@ namespace OpenZWave
 		{
 			public:
 				LabelLocalizationEntry(uint16 _index, uint32 _pos = -1);
+				static void* operator new(size_t _size)
+				{
+					return Internal::MemoryAccounting::Allocate(_size, Internal::MemoryAccounting::Category_Localization);
+				}
+				static void operator delete(void* _ptr)
+				{
+					Internal::MemoryAccounting::Free(_ptr);
+				}
 				~LabelLocalizationEntry()
 				{
 				}
@@ -63,6 +72,14 @@ namespace OpenZWave
 		{
 			public:
 				ValueLocalizationEntry(uint8 _commandClass, uint16 _index, uint32 _pos = -1);
+				static void* operator new(size_t _size)
+				{
+					return Internal::MemoryAccounting::Allocate(_size, Internal::MemoryAccounting::Category_Localization);
+				}
+				static void operator delete(void* _ptr)
+				{
+					Internal::MemoryAccounting::Free(_ptr);
+				}
 				~ValueLocalizationEntry()
 				{
 
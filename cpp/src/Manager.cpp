@@ -35,12 +35,16 @@
 #include "Manager.h"
 #include "Driver.h"
 #include "Localization.h"
+#include "Metrics.h"
+#include "MemoryAccounting.h"
 #include "Node.h"
 #include "Notification.h"
+#include "WatcherQueue.h"
 #include "NotificationCCTypes.h"
 #include "Options.h"
 #include "Scene.h"
 #include "SensorMultiLevelCCTypes.h"
+#include "ValueTable.h"
 #include "Utils.h"
 
 #include "platform/Mutex.h"
@@ -143,8 +147,10 @@ ozwversion Manager::getVersion()
 // Constructor
 //-----------------------------------------------------------------------------
 Manager::Manager() :
-		m_notificationMutex(new Internal::Platform::Mutex())
+		m_driverMutex(new Internal::Platform::Mutex()), m_metricsMutex(new Internal::Platform::Mutex()), m_notificationMutex(new Internal::Platform::Mutex())
 {
+	memset(m_notificationCounts, 0, sizeof(m_notificationCounts));
+
 	// Ensure the singleton instance is set
 	s_instance = this;
 
@@ -152,6 +158,14 @@ Manager::Manager() :
 	bool logging = false;
 	Options::Get()->GetOptionAsBool("Logging", &logging);
 
+	// Start counting allocations before anything is loaded
+	bool memoryAccounting = false;
+	Options::Get()->GetOptionAsBool("MemoryAccounting", &memoryAccounting);
+	if (memoryAccounting)
+	{
+		Internal::MemoryAccounting::Create();
+	}
+
 	string userPath = "";
 	Options::Get()->GetOptionAsString("UserPath", &userPath);
 
@@ -201,6 +215,12 @@ Manager::Manager() :
 	if (!Internal::SensorMultiLevelCCTypes::Create()) {
 		Log::Write(LogLevel_Error, "mgr,     Cannot Create SensorMultiLevelCCTypes!");
 	}
+	if (!Internal::ValueTable::Create()) {
+		Log::Write(LogLevel_Error, "mgr,     Cannot Create ValueTable!");
+	}
+	if (!Internal::MetricsExporter::Create()) {
+		Log::Write(LogLevel_Error, "mgr,     Cannot Create MetricsExporter!");
+	}
 
 }
 
@@ -210,6 +230,9 @@ Manager::Manager() :
 //-----------------------------------------------------------------------------
 Manager::~Manager()
 {
+	// Stop publishing metrics before the drivers go away
+	Internal::MetricsExporter::Destroy();
+
 	// Clear the pending list
 	while (!m_pendingDrivers.empty())
 	{
@@ -228,16 +251,30 @@ Manager::~Manager()
 	}
 	m_readyDrivers.clear();
 
+	Internal::ValueTable::Destroy();
+
+	m_metricsMutex->Release();
+	m_driverMutex->Release();
 	m_notificationMutex->Release();
 
 	// Clear the watchers list
 	while (!m_watchers.empty())
 	{
 		list<Watcher*>::iterator it = m_watchers.begin();
+		delete (*it)->m_queue;
 		delete *it;
 		m_watchers.erase(it);
 	}
+	while (!m_retiredQueues.empty())
+	{
+		delete m_retiredQueues.front();
+		m_retiredQueues.pop_front();
+	}
 	m_watchers.clear();
+	for (uint32 i = 0; i < NotificationFilter::TypeCount; ++i)
+	{
+		m_watchersByType[i].clear();
+	}
 
 	// Clear the generic device class list
 	while (!Node::s_genericDeviceClasses.empty())
@@ -282,6 +319,8 @@ Manager::~Manager()
 	Node::s_deviceClassesLoaded = false;
 	
 	Log::Destroy();
+
+	Internal::MemoryAccounting::Destroy();
 }
 
 //-----------------------------------------------------------------------------
@@ -339,7 +378,10 @@ bool Manager::AddDriver(string const& _controllerPath, Driver::ControllerInterfa
 	}
 
 	Driver* driver = new Driver(_controllerPath, _interface);
-	m_pendingDrivers.push_back(driver);
+	{
+		Internal::LockGuard LG(m_driverMutex);
+		m_pendingDrivers.push_back(driver);
+	}
 	driver->Start();
 
 	Log::Write(LogLevel_Info, "mgr,     Added driver for controller %s", _controllerPath.c_str());
@@ -352,13 +394,21 @@ bool Manager::AddDriver(string const& _controllerPath, Driver::ControllerInterfa
 //-----------------------------------------------------------------------------
 bool Manager::RemoveDriver(string const& _controllerPath)
 {
+	// Keep the metrics exporter away while the driver is deleted.  m_driverMutex is
+	// only taken around the list changes, as the driver thread needs it to become ready.
+	Internal::LockGuard LG(m_metricsMutex);
+
 	// Search the pending list
 	for (list<Driver*>::iterator pit = m_pendingDrivers.begin(); pit != m_pendingDrivers.end(); ++pit)
 	{
 		if (_controllerPath == (*pit)->GetControllerPath())
 		{
-			delete *pit;
-			m_pendingDrivers.erase(pit);
+			Driver* driver = *pit;
+			{
+				Internal::LockGuard DLG(m_driverMutex);
+				m_pendingDrivers.erase(pit);
+			}
+			delete driver;
 			Log::Write(LogLevel_Info, "mgr,     Driver for controller %s removed", _controllerPath.c_str());
 			return true;
 		}
@@ -384,7 +434,10 @@ bool Manager::RemoveDriver(string const& _controllerPath)
 			 */
 			Log::Write(LogLevel_Info, "mgr,     Driver for controller %s pending removal", _controllerPath.c_str());
 			delete rit->second;
-			m_readyDrivers.erase(rit);
+			{
+				Internal::LockGuard DLG(m_driverMutex);
+				m_readyDrivers.erase(rit);
+			}
 			Log::Write(LogLevel_Info, "mgr,     Driver for controller %s removed", _controllerPath.c_str());
 			return true;
 		}
@@ -420,6 +473,7 @@ void Manager::SetDriverReady(Driver* _driver, bool success)
 {
 	// Search the pending list
 	bool found = false;
+	Internal::LockGuard LG(m_driverMutex);
 	for (list<Driver*>::iterator it = m_pendingDrivers.begin(); it != m_pendingDrivers.end(); ++it)
 	{
 		if ((*it) == _driver)
@@ -1080,6 +1134,50 @@ void Manager::SyncronizeNodeNeighbors(uint32 const _homeId, uint8 const _nodeId)
 	return;
 }
 
+//-----------------------------------------------------------------------------
+// <Manager::GetNodeHopCount>
+// Get the number of hops between the controller and a node
+//-----------------------------------------------------------------------------
+int32 Manager::GetNodeHopCount(uint32 const _homeId, uint8 const _nodeId)
+{
+	if (Driver* driver = GetDriver(_homeId))
+	{
+		return driver->GetNodeHopCount(_nodeId);
+	}
+
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::GetArticulationPoints>
+// Get the nodes whose failure would split the network
+//-----------------------------------------------------------------------------
+uint32 Manager::GetArticulationPoints(uint32 const _homeId, uint8** o_nodes)
+{
+	if (Driver* driver = GetDriver(_homeId))
+	{
+		return driver->GetArticulationPoints(o_nodes);
+	}
+
+	*o_nodes = NULL;
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::GetNodesWithoutRedundantRoutes>
+// Get the nodes with only one route to the controller
+//-----------------------------------------------------------------------------
+uint32 Manager::GetNodesWithoutRedundantRoutes(uint32 const _homeId, uint8** o_nodes)
+{
+	if (Driver* driver = GetDriver(_homeId))
+	{
+		return driver->GetNodesWithoutRedundantRoutes(o_nodes);
+	}
+
+	*o_nodes = NULL;
+	return 0;
+}
+
 
 //-----------------------------------------------------------------------------
 // <Manager::GetNodeManufacturerName>
@@ -3103,6 +3201,60 @@ bool Manager::SetValue(ValueID const& _id, string const& _value)
 	return res;
 }
 
+//-----------------------------------------------------------------------------
+// <Manager::SetValueMulticast>
+// Sets the value of a group of bools, using multicast frames where possible
+//-----------------------------------------------------------------------------
+bool Manager::SetValueMulticast(vector<ValueID> const& _ids, bool const _value)
+{
+	if (_ids.empty())
+	{
+		return false;
+	}
+
+	for (vector<ValueID>::const_iterator it = _ids.begin(); it != _ids.end(); ++it)
+	{
+		if (ValueID::ValueType_Bool != it->GetType())
+		{
+			OZW_ERROR(OZWException::OZWEXCEPTION_CANNOT_CONVERT_VALUEID, "ValueID passed to SetValueMulticast is not a Bool Value");
+			return false;
+		}
+	}
+
+	if (Driver* driver = GetDriver(_ids.front().GetHomeId()))
+	{
+		return driver->SetValueMulticast(_ids, _value ? 0xff : 0x00);
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::SetValueMulticast>
+// Sets the value of a group of bytes, using multicast frames where possible
+//-----------------------------------------------------------------------------
+bool Manager::SetValueMulticast(vector<ValueID> const& _ids, uint8 const _value)
+{
+	if (_ids.empty())
+	{
+		return false;
+	}
+
+	for (vector<ValueID>::const_iterator it = _ids.begin(); it != _ids.end(); ++it)
+	{
+		if (ValueID::ValueType_Byte != it->GetType())
+		{
+			OZW_ERROR(OZWException::OZWEXCEPTION_CANNOT_CONVERT_VALUEID, "ValueID passed to SetValueMulticast is not a Byte Value");
+			return false;
+		}
+	}
+
+	if (Driver* driver = GetDriver(_ids.front().GetHomeId()))
+	{
+		return driver->SetValueMulticast(_ids, _value);
+	}
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 // <Manager::RefreshValue>
 // Instruct the driver to refresh this value by sending a message to the device
@@ -3160,6 +3312,111 @@ void Manager::SetChangeVerified(ValueID const& _id, bool _verify)
 	}
 }
 
+//-----------------------------------------------------------------------------
+// <Manager::SetNotificationFilter>
+// Set the deadband and rate limit for the notifications of the specified value
+//-----------------------------------------------------------------------------
+void Manager::SetNotificationFilter(ValueID const& _id, float const _deadband, int32 const _minInterval, bool const _trailingEdge)
+{
+	if (Driver* driver = GetDriver(_id.GetHomeId()))
+	{
+		Internal::LockGuard LG(driver->m_nodeMutex);
+		if (Internal::VC::Value* value = driver->GetValue(_id))
+		{
+			value->SetNotificationFilter(_deadband, _minInterval, _trailingEdge);
+			value->Release();
+		}
+		else
+		{
+			OZW_ERROR(OZWException::OZWEXCEPTION_INVALID_VALUEID, "Invalid ValueID passed to SetNotificationFilter");
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::GetNotificationFilter>
+// Get the deadband and rate limit for the notifications of the specified value
+//-----------------------------------------------------------------------------
+bool Manager::GetNotificationFilter(ValueID const& _id, float* o_deadband, int32* o_minInterval, bool* o_trailingEdge)
+{
+	bool res = false;
+	if (Driver* driver = GetDriver(_id.GetHomeId()))
+	{
+		Internal::LockGuard LG(driver->m_nodeMutex);
+		if (Internal::VC::Value* value = driver->GetValue(_id))
+		{
+			*o_deadband = (float) value->GetNotificationDeadband();
+			*o_minInterval = value->GetNotificationMinInterval();
+			*o_trailingEdge = value->GetNotificationTrailingEdge();
+			value->Release();
+			res = true;
+		}
+		else
+		{
+			OZW_ERROR(OZWException::OZWEXCEPTION_INVALID_VALUEID, "Invalid ValueID passed to GetNotificationFilter");
+		}
+	}
+	return res;
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::GetValueHistory>
+// Get the recent history of the specified value
+//-----------------------------------------------------------------------------
+bool Manager::GetValueHistory(ValueID const& _id, ValueHistoryTier const _tier, uint64 const _from, uint64 const _to, vector<ValueHistoryEntry>* o_entries)
+{
+	bool res = false;
+
+	if (o_entries)
+	{
+		o_entries->clear();
+		if (Driver* driver = GetDriver(_id.GetHomeId()))
+		{
+			Internal::LockGuard LG(driver->m_nodeMutex);
+			if (Internal::VC::Value* value = driver->GetValue(_id))
+			{
+				if (Internal::ValueHistory* history = value->GetHistory())
+				{
+					history->Get(_tier, _from, _to, *o_entries);
+					res = true;
+				}
+				value->Release();
+			}
+			else
+			{
+				OZW_ERROR(OZWException::OZWEXCEPTION_INVALID_VALUEID, "Invalid ValueID passed to GetValueHistory");
+			}
+		}
+	}
+
+	return res;
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::GetValueTransition>
+// Get the estimated level and time left of a value moving towards a target
+//-----------------------------------------------------------------------------
+bool Manager::GetValueTransition(ValueID const& _id, string* o_estimate, uint32* o_remaining)
+{
+	bool res = false;
+
+	if (Driver* driver = GetDriver(_id.GetHomeId()))
+	{
+		Internal::LockGuard LG(driver->m_nodeMutex);
+		if (Internal::VC::Value* value = driver->GetValue(_id))
+		{
+			res = value->GetTransition(o_estimate, o_remaining);
+			value->Release();
+		}
+		else
+		{
+			OZW_ERROR(OZWException::OZWEXCEPTION_INVALID_VALUEID, "Invalid ValueID passed to GetValueTransition");
+		}
+	}
+
+	return res;
+}
+
 //-----------------------------------------------------------------------------
 // <Manager::GetChangeVerified>
 // Get the verify changes flag for the specified value
@@ -3565,6 +3822,20 @@ bool Manager::SetConfigParam(uint32 const _homeId, uint8 const _nodeId, uint8 co
 	return false;
 }
 
+//-----------------------------------------------------------------------------
+// <Manager::SetConfigParams>
+// Set the values of consecutive configuration parameters of a device
+//-----------------------------------------------------------------------------
+bool Manager::SetConfigParams(uint32 const _homeId, uint8 const _nodeId, uint16 const _firstParam, vector<int32> const& _values, uint8 const _size)
+{
+	if (Driver* driver = GetDriver(_homeId))
+	{
+		return driver->SetConfigParams(_nodeId, _firstParam, _values, _size);
+	}
+
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 // <Manager::RequestConfigParam>
 // Request the value of one of the configuration parameters of a device
@@ -3716,12 +3987,53 @@ void Manager::RemoveAssociation(uint32 const _homeId, uint8 const _nodeId, uint8
 // Add a watcher to the list
 //-----------------------------------------------------------------------------
 bool Manager::AddWatcher(pfnOnNotification_t _watcher, void* _context)
+{
+	return AddWatcher(_watcher, _context, NotificationFilter());
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::AddWatcher>
+// Add a watcher to the list, indexed by the notification types it wants
+//-----------------------------------------------------------------------------
+bool Manager::AddWatcher(pfnOnNotification_t _watcher, void* _context, NotificationFilter const& _filter)
+{
+	Watcher* watcher = new Watcher(_watcher, _context, _filter, NULL);
+	if (!InsertWatcher(watcher))
+	{
+		delete watcher;
+		return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::AddWatcher>
+// Add a watcher that is called from its own delivery thread
+//-----------------------------------------------------------------------------
+bool Manager::AddWatcher(pfnOnNotification_t _watcher, void* _context, NotificationFilter const& _filter, uint32 const _queueSize, WatcherOverflow const _overflow)
+{
+	Internal::WatcherQueue* queue = new Internal::WatcherQueue(_watcher, _context, _queueSize, _overflow);
+	Watcher* watcher = new Watcher(_watcher, _context, _filter, queue);
+	if (!InsertWatcher(watcher))
+	{
+		delete queue;
+		delete watcher;
+		return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::InsertWatcher>
+// Add a watcher to the list and the type index
+//-----------------------------------------------------------------------------
+bool Manager::InsertWatcher(Watcher* _watcher)
 {
 	// Ensure this watcher is not already on the list
 	m_notificationMutex->Lock();
 	for (list<Watcher*>::iterator it = m_watchers.begin(); it != m_watchers.end(); ++it)
 	{
-		if (((*it)->m_callback == _watcher) && ((*it)->m_context == _context))
+		if (((*it)->m_callback == _watcher->m_callback) && ((*it)->m_context == _watcher->m_context))
 		{
 			// Already in the list
 			m_notificationMutex->Unlock();
@@ -3729,7 +4041,14 @@ bool Manager::AddWatcher(pfnOnNotification_t _watcher, void* _context)
 		}
 	}
 
-	m_watchers.push_back(new Watcher(_watcher, _context));
+	m_watchers.push_back(_watcher);
+	for (uint32 i = 0; i < NotificationFilter::TypeCount; ++i)
+	{
+		if (_watcher->m_filter.MatchesType((Notification::NotificationType) i))
+		{
+			m_watchersByType[i].push_back(_watcher);
+		}
+	}
 	m_notificationMutex->Unlock();
 	return true;
 }
@@ -3741,43 +4060,138 @@ bool Manager::AddWatcher(pfnOnNotification_t _watcher, void* _context)
 bool Manager::RemoveWatcher(pfnOnNotification_t _watcher, void* _context)
 {
 	m_notificationMutex->Lock();
-	list<Watcher*>::iterator it = m_watchers.begin();
-	while (it != m_watchers.end())
+	for (list<Watcher*>::iterator it = m_watchers.begin(); it != m_watchers.end(); ++it)
 	{
 		if (((*it)->m_callback == _watcher) && ((*it)->m_context == _context))
 		{
-			delete (*it);
-			list<Watcher*>::iterator next = m_watchers.erase(it);
-			for (list<list<Watcher*>::iterator*>::iterator extIt = m_watcherIterators.begin(); extIt != m_watcherIterators.end(); ++extIt)
+			Watcher* watcher = *it;
+			for (uint32 i = 0; i < NotificationFilter::TypeCount; ++i)
 			{
-				if ((**extIt) == it)
-				{
-					(**extIt) = next;
-				}
+				RemoveWatcherFromList(m_watchersByType[i], watcher);
 			}
+			RemoveWatcherFromList(m_watchers, watcher);
+			if (watcher->m_queue)
+			{
+				// This may be called from the watcher's own delivery thread, so
+				// the queue is only deleted once that thread has exited.
+				watcher->m_queue->Stop();
+				m_retiredQueues.push_back(watcher->m_queue);
+			}
+			delete watcher;
 			m_notificationMutex->Unlock();
 			return true;
 		}
-		++it;
 	}
 
 	m_notificationMutex->Unlock();
 	return false;
 }
 
+//-----------------------------------------------------------------------------
+// <Manager::GetWatcherStatistics>
+// Get the delivery statistics of a queued watcher
+//-----------------------------------------------------------------------------
+bool Manager::GetWatcherStatistics(pfnOnNotification_t _watcher, void* _context, WatcherStatistics* _data)
+{
+	Internal::LockGuard LG(m_notificationMutex);
+	for (list<Watcher*>::iterator it = m_watchers.begin(); it != m_watchers.end(); ++it)
+	{
+		if (((*it)->m_callback == _watcher) && ((*it)->m_context == _context))
+		{
+			if (!(*it)->m_queue)
+			{
+				return false;
+			}
+			(*it)->m_queue->GetStatistics(_data);
+			return true;
+		}
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::ReapWatcherQueues>
+// Delete the queues of removed watchers once their threads have exited.
+// Called with m_notificationMutex held.
+//-----------------------------------------------------------------------------
+void Manager::ReapWatcherQueues()
+{
+	list<Internal::WatcherQueue*>::iterator it = m_retiredQueues.begin();
+	while (it != m_retiredQueues.end())
+	{
+		if ((*it)->IsFinished())
+		{
+			delete *it;
+			it = m_retiredQueues.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::RemoveWatcherFromList>
+// Erase a watcher from one of the watcher lists.  Watchers may remove
+// themselves from within a callback, so any iterator NotifyWatchers has on
+// the erased entry is moved to the next one.
+//-----------------------------------------------------------------------------
+void Manager::RemoveWatcherFromList(list<Watcher*>& _list, Watcher* _watcher)
+{
+	for (list<Watcher*>::iterator it = _list.begin(); it != _list.end(); ++it)
+	{
+		if (*it == _watcher)
+		{
+			list<Watcher*>::iterator next = _list.erase(it);
+			for (list<list<Watcher*>::iterator*>::iterator extIt = m_watcherIterators.begin(); extIt != m_watcherIterators.end(); ++extIt)
+			{
+				if ((**extIt) == it)
+				{
+					(**extIt) = next;
+				}
+			}
+			return;
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 // <Manager::NotifyWatchers>
 // Notify any watching objects of a value change
 //-----------------------------------------------------------------------------
 void Manager::NotifyWatchers(Notification* _notification)
 {
+	// Only the watchers that asked for this type of notification are visited
+	uint32 type = _notification->GetType();
+	list<Watcher*>& watchers = (type < NotificationFilter::TypeCount) ? m_watchersByType[type] : m_watchers;
+
 	m_notificationMutex->Lock();
-	list<Watcher*>::iterator it = m_watchers.begin();
+	if (type < NotificationFilter::TypeCount)
+	{
+		m_notificationCounts[type]++;
+	}
+	if (!m_retiredQueues.empty())
+	{
+		ReapWatcherQueues();
+	}
+	list<Watcher*>::iterator it = watchers.begin();
 	m_watcherIterators.push_back(&it);
-	while (it != m_watchers.end())
+	while (it != watchers.end())
 	{
 		Watcher* pWatcher = *(it++);
-		pWatcher->m_callback(_notification, pWatcher->m_context);
+		if (pWatcher->m_filter.Matches(_notification))
+		{
+			if (pWatcher->m_queue)
+			{
+				// Queued watchers get their own copy, delivered on their own thread
+				pWatcher->m_queue->Push(new Notification(*_notification));
+			}
+			else
+			{
+				pWatcher->m_callback(_notification, pWatcher->m_context);
+			}
+		}
 	}
 	m_watcherIterators.pop_back();
 	m_notificationMutex->Unlock();
@@ -4813,6 +5227,80 @@ switch (_data->m_routeSpeed)
 return "Unknown";
 }
 
+//-----------------------------------------------------------------------------
+// <Manager::GetMetrics>
+// Render the statistics of all ready drivers in the Prometheus text format
+//-----------------------------------------------------------------------------
+string Manager::GetMetrics()
+{
+	static char const* c_notificationTypeNames[NotificationFilter::TypeCount] =
+	{ "ValueAdded", "ValueRemoved", "ValueChanged", "ValueRefreshed", "Group", "NodeNew", "NodeAdded", "NodeRemoved", "NodeProtocolInfo", "NodeNaming", "NodeEvent", "PollingDisabled", "PollingEnabled", "SceneEvent", "CreateButton", "DeleteButton", "ButtonOn", "ButtonOff", "DriverReady", "DriverFailed", "DriverReset", "EssentialNodeQueriesComplete", "NodeQueriesComplete", "AwakeNodesQueried", "AllNodesQueriedSomeDead", "AllNodesQueried", "Notification", "DriverRemoved", "ControllerCommand", "NodeReset", "UserAlerts", "ManufacturerSpecificDBReady" };
+
+	Internal::MetricsSnapshot snapshot;
+	{
+		Internal::LockGuard LG(m_metricsMutex);
+		Internal::LockGuard DLG(m_driverMutex);
+		for (map<uint32, Driver*>::iterator it = m_readyDrivers.begin(); it != m_readyDrivers.end(); ++it)
+		{
+			it->second->CollectMetrics(snapshot);
+		}
+	}
+
+	uint32 counts[NotificationFilter::TypeCount];
+	{
+		Internal::LockGuard LG(m_notificationMutex);
+		memcpy(counts, m_notificationCounts, sizeof(counts));
+	}
+	for (uint32 i = 0; i < NotificationFilter::TypeCount; ++i)
+	{
+		snapshot.AddCounter("ozw_notifications_total", "Notifications passed to the watchers, by type.", string("type=\"") + c_notificationTypeNames[i] + "\"", counts[i]);
+	}
+	return snapshot.Render();
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::GetMemoryUsage>
+// Describe the memory held by each subsystem and each node
+//-----------------------------------------------------------------------------
+string Manager::GetMemoryUsage()
+{
+	return Internal::MemoryAccounting::GetReport();
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::GetNodeMemoryUsage>
+// Get the memory held by a node
+//-----------------------------------------------------------------------------
+uint64 Manager::GetNodeMemoryUsage(uint32 const _homeId, uint8 const _nodeId, uint32* o_objects)
+{
+	Internal::MemoryAccounting::Usage usage = Internal::MemoryAccounting::GetNodeUsage(_homeId, _nodeId);
+	if (o_objects)
+	{
+		*o_objects = usage.m_objects;
+	}
+	return usage.m_bytes;
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::LogMemoryUsage>
+// Write the memory report to the log
+//-----------------------------------------------------------------------------
+void Manager::LogMemoryUsage()
+{
+	string report = Internal::MemoryAccounting::GetReport();
+	size_t pos = 0;
+	while (pos < report.size())
+	{
+		size_t end = report.find('\n', pos);
+		if (end == string::npos)
+		{
+			end = report.size();
+		}
+		Log::Write(LogLevel_Info, "mgr,     %s", report.substr(pos, end - pos).c_str());
+		pos = end + 1;
+	}
+}
+
 //-----------------------------------------------------------------------------
 // <Manager::GetMetaData>
 // Retrieve MetaData about a Node.
@@ -38,6 +38,8 @@
 #include "Defs.h"
 #include "Driver.h"
 #include "Group.h"
+#include "Notification.h"
+#include "ValueHistory.h"
 #include "value_classes/ValueID.h"
 
 namespace OpenZWave
@@ -54,6 +56,7 @@ namespace OpenZWave
 			class ValueStore;
 		}
 		class Msg;
+		class WatcherQueue;
 	}
 	class Options;
 	class Node;
@@ -368,6 +371,8 @@ namespace OpenZWave
 			void SetDriverReady(Driver* _driver, bool success); /**< Indicate that the Driver is ready to be used, and send the notification callback. */
 			list<Driver*> m_pendingDrivers; /**< Drivers that are in the process of reading saved data and querying their Z-Wave network for basic information. */
 			map<uint32, Driver*> m_readyDrivers; /**< Drivers that are ready to be used by the application. */
+			Internal::Platform::Mutex* m_driverMutex; /**< Held while the lists above are changed, and while they are walked to collect metrics. */
+			Internal::Platform::Mutex* m_metricsMutex; /**< Held while metrics are collected and while a driver is deleted, so a driver is never deleted mid-collection. */
 
 		//-----------------------------------------------------------------------------
 		//	Polling Z-Wave devices
@@ -636,6 +641,38 @@ namespace OpenZWave
 
 			void SyncronizeNodeNeighbors(uint32 const _homeId, uint8 const _nodeId);
 
+			/**
+			 * \brief Get the number of hops between the controller and a node
+			 *
+			 * The count is the shortest path through the network graph built from every node's neighbor list.
+			 * \param _homeId The Home ID of the Z-Wave controller that manages the node.
+			 * \param _nodeId The ID of the node to query.
+			 * \return 0 for the controller, 1 for its direct neighbors and so on, or -1 if no route is known.
+			 * \sa GetNodeNeighbors, SyncronizeNodeNeighbors
+			 */
+			int32 GetNodeHopCount(uint32 const _homeId, uint8 const _nodeId);
+
+			/**
+			 * \brief Get the nodes whose failure would split the network
+			 *
+			 * \param _homeId The Home ID of the Z-Wave controller.
+			 * \param o_nodes Pointer to an array of node IDs.  The caller must delete[] the array.
+			 * \return The number of nodes in the array.
+			 * \sa GetNodesWithoutRedundantRoutes
+			 */
+			uint32 GetArticulationPoints(uint32 const _homeId, uint8** o_nodes);
+
+			/**
+			 * \brief Get the nodes that a single failed node or link would cut off from the controller
+			 *
+			 * These nodes have only one route to the controller.  Adding a repeater near them gives them a second one.
+			 * \param _homeId The Home ID of the Z-Wave controller.
+			 * \param o_nodes Pointer to an array of node IDs.  The caller must delete[] the array.
+			 * \return The number of nodes in the array.
+			 * \sa GetArticulationPoints
+			 */
+			uint32 GetNodesWithoutRedundantRoutes(uint32 const _homeId, uint8** o_nodes);
+
 			/**
 			 * \brief Get the manufacturer name of a device
 			 * The manufacturer name would normally be handled by the Manufacturer Specific command class,
@@ -1403,6 +1440,34 @@ namespace OpenZWave
 			 */
 			bool SetValueListSelection(ValueID const& _id, string const& _selectedItem);
 
+			/**
+			 * \brief Sets the same bool value on a group of nodes.
+			 * Values of Basic, SwitchBinary and SwitchMultilevel Command Classes on awake, listening nodes are
+			 * sent together in a single multicast frame, followed by a Get to each node to confirm the new state.
+			 * Any other values (secured Command Classes, endpoints, sleeping nodes...) are set individually.
+			 * \param _ids The unique identifiers of the bool values. They must all belong to the same network.
+			 * \param _value The new value of the bools.
+			 * \return true if any of the values were set.  Returns false if any value is not a ValueID::ValueType_Bool.
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_CANNOT_CONVERT_VALUEID if any of the Values is of a different type
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_HOMEID if the Driver cannot be found
+			 * \sa SetValue
+			 */
+			bool SetValueMulticast(vector<ValueID> const& _ids, bool const _value);
+
+			/**
+			 * \brief Sets the same byte value on a group of nodes.
+			 * Values of Basic, SwitchBinary and SwitchMultilevel Command Classes on awake, listening nodes are
+			 * sent together in a single multicast frame, followed by a Get to each node to confirm the new state.
+			 * Any other values (secured Command Classes, endpoints, sleeping nodes...) are set individually.
+			 * \param _ids The unique identifiers of the byte values. They must all belong to the same network.
+			 * \param _value The new value of the bytes.
+			 * \return true if any of the values were set.  Returns false if any value is not a ValueID::ValueType_Byte.
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_CANNOT_CONVERT_VALUEID if any of the Values is of a different type
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_HOMEID if the Driver cannot be found
+			 * \sa SetValue
+			 */
+			bool SetValueMulticast(vector<ValueID> const& _ids, uint8 const _value);
+
 			/**
 			 * \brief Refreshes the specified value from the Z-Wave network.
 			 * A call to this function causes the library to send a message to the network to retrieve the current value
@@ -1426,6 +1491,68 @@ namespace OpenZWave
 			 */
 			void SetChangeVerified(ValueID const& _id, bool _verify);
 
+			/**
+			 * \brief Sets filters that limit the ValueChanged and ValueRefreshed notifications sent for a value.
+			 * This is useful for meters and sensors that report far more often, or in far smaller steps,
+			 * than the application cares about.  Defaults for a device can also be set per Command Class or
+			 * per value index in the device configuration with the NotifyDeadband (in thousandths of the
+			 * value's unit), NotifyMinInterval and NotifyTrailingEdge compatibility flags.
+			 * \param _id The unique identifier of the value to filter.
+			 * \param _deadband Changes smaller than this are not notified. Only applies to Byte, Short, Int and Decimal values. 0 to disable.
+			 * \param _minInterval Minimum time in milliseconds between two notifications of the same type. 0 to disable.
+			 * \param _trailingEdge if true, the last value held back by _minInterval is notified once the interval has expired.
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_VALUEID if the ValueID is invalid
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_HOMEID if the Driver cannot be found
+			 * \sa Manager::GetNotificationFilter
+			 */
+			void SetNotificationFilter(ValueID const& _id, float const _deadband, int32 const _minInterval, bool const _trailingEdge);
+
+			/**
+			 * \brief Gets the notification filters set for a value.
+			 * \param _id The unique identifier of the value.
+			 * \param o_deadband Pointer to a float that will be filled with the deadband.
+			 * \param o_minInterval Pointer to an int32 that will be filled with the minimum interval in milliseconds.
+			 * \param o_trailingEdge Pointer to a bool that will be set to true if held back values are delivered once the interval expires.
+			 * \return true if the value was found.
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_VALUEID if the ValueID is invalid
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_HOMEID if the Driver cannot be found
+			 * \sa Manager::SetNotificationFilter
+			 */
+			bool GetNotificationFilter(ValueID const& _id, float* o_deadband, int32* o_minInterval, bool* o_trailingEdge);
+
+			/**
+			 * \brief Gets the recent history of a numeric value.
+			 * History is only kept when the ValueHistorySize option is non zero, and only for
+			 * Byte, Short, Int and Decimal values.  Each tier holds at most ValueHistorySize
+			 * entries and drops the oldest as new ones arrive.  The history is recorded
+			 * without blocking the driver, so this can be called as often as needed.
+			 * \param _id The unique identifier of the value.
+			 * \param _tier Every update (ValueHistoryTier_Samples), or the minimum, maximum and average per period.
+			 * \param _from Earliest entry to return, in milliseconds since 1970-01-01 UTC.
+			 * \param _to Latest entry to return, in milliseconds since 1970-01-01 UTC.
+			 * \param o_entries Pointer to a vector that will be filled with the entries, oldest first.
+			 * \return true if any history has been recorded for the value.
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_VALUEID if the ValueID is invalid
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_HOMEID if the Driver cannot be found
+			 * \see ValueHistoryEntry
+			 */
+			bool GetValueHistory(ValueID const& _id, ValueHistoryTier const _tier, uint64 const _from, uint64 const _to, vector<ValueHistoryEntry>* o_entries);
+
+			/**
+			 * \brief Gets the progress of a value the node is moving towards a target.
+			 * Dimmers and color bulbs report a target and a duration when they ramp.  The value
+			 * keeps its last confirmed level until the ramp is over and it is refreshed, and is
+			 * not polled in the meantime.  This estimates the level reached so far, by
+			 * interpolating between the last reported level and the target.
+			 * \param _id The unique identifier of the value.
+			 * \param o_estimate Pointer to a string that will be filled with the estimated level, in the format of GetValueAsString.  Levels that are not numbers or colors are not interpolated.
+			 * \param o_remaining Pointer to a uint32 that will be filled with the milliseconds left until the target should be reached.
+			 * \return true if the value is in a transition.
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_VALUEID if the ValueID is invalid
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_HOMEID if the Driver cannot be found
+			 */
+			bool GetValueTransition(ValueID const& _id, string* o_estimate, uint32* o_remaining);
+
 			/**
 			 * \brief determine if value changes upon a refresh should be verified.  If so, the
 			 * library will immediately refresh the value a second time whenever a change is observed.  This helps to filter
@@ -1650,6 +1777,22 @@ namespace OpenZWave
 			 */
 			bool SetConfigParam(uint32 const _homeId, uint8 const _nodeId, uint8 const _param, int32 _value, uint8 const _size = 2);
 
+			/**
+			 * \brief Set the values of consecutive configurable parameters of the same size in a device.
+			 * Devices that support version 2 or later of the Configuration command class receive several
+			 * parameters per frame.  Other devices receive one frame per parameter, as with SetConfigParam.
+			 * This method returns immediately, without waiting for confirmation from the device that the
+			 * changes have been made.
+			 * \param _homeId The Home ID of the Z-Wave controller that manages the node.
+			 * \param _nodeId The ID of the node to configure.
+			 * \param _firstParam The index of the first parameter.
+			 * \param _values The values of _firstParam and the parameters that follow it.
+			 * \param _size The number of bytes of each parameter: 1, 2 or 4.
+			 * \return true if the node supports the Configuration command class.
+			 * \see SetConfigParam, RequestAllConfigParams
+			 */
+			bool SetConfigParams(uint32 const _homeId, uint8 const _nodeId, uint16 const _firstParam, vector<int32> const& _values, uint8 const _size);
+
 			/**
 			 * \brief Request the value of a configurable parameter from a device.
 			 * Some devices have various parameters that can be configured to control the device behavior.
@@ -1669,6 +1812,8 @@ namespace OpenZWave
 
 			/**
 			 * \brief Request the values of all known configurable parameters from a device.
+			 * Devices that support version 2 or later of the Configuration command class are asked for
+			 * runs of consecutive parameters of the same size in one frame.
 			 * \param _homeId The Home ID of the Z-Wave controller that manages the node.
 			 * \param _nodeId The ID of the node to configure.
 			 * \see SetConfigParam, ValueID, Notification
@@ -1804,6 +1949,68 @@ namespace OpenZWave
 			 */
 			bool AddWatcher(pfnOnNotification_t _watcher, void* _context);
 
+			/**
+			 * \brief Add a notification watcher that only receives some notifications.
+			 * Notifications are routed through an index built from the filters, so watchers are not
+			 * called for notification types they did not ask for.
+			 * \param _watcher pointer to a function that will be called by the notification system.
+			 * \param _context pointer to user defined data that will be passed to the watcher function with each notification.
+			 * \param _filter the notifications that the watcher wants to receive.
+			 * \return true if the watcher was successfully added.
+			 * \see RemoveWatcher, Notification, NotificationFilter
+			 */
+			bool AddWatcher(pfnOnNotification_t _watcher, void* _context, NotificationFilter const& _filter);
+
+			/**
+			 * \brief What a queued watcher does when its queue is full.
+			 * \see AddWatcher
+			 */
+			enum WatcherOverflow
+			{
+				WatcherOverflow_DropOldest = 0, /**< Discard the oldest queued notification to make room */
+				WatcherOverflow_DropNewest /**< Discard the notification that did not fit */
+			};
+
+			/**
+			 * \brief Delivery statistics of a queued watcher.
+			 * \see GetWatcherStatistics
+			 */
+			struct WatcherStatistics
+			{
+					uint32 m_queued; /**< Notifications currently waiting for delivery */
+					uint32 m_maxQueued; /**< Largest number of notifications that have been waiting at once */
+					uint32 m_delivered; /**< Notifications passed to the watcher */
+					uint32 m_dropped; /**< Notifications discarded because the queue was full */
+					uint32 m_lastLag; /**< Time in ms the most recently delivered notification spent in the queue */
+					uint32 m_maxLag; /**< Longest time in ms any notification has spent in the queue */
+			};
+
+			/**
+			 * \brief Add a notification watcher that is called from its own thread.
+			 * Notifications for this watcher are copied into a bounded queue and delivered by a thread
+			 * dedicated to it, so the driver thread never waits for the watcher.  Notifications
+			 * can therefore arrive after the state they describe has changed again.  A callback that
+			 * is already running may still complete after RemoveWatcher returns.
+			 * \param _watcher pointer to a function that will be called by the notification system.
+			 * \param _context pointer to user defined data that will be passed to the watcher function with each notification.
+			 * \param _filter the notifications that the watcher wants to receive.
+			 * \param _queueSize the maximum number of notifications waiting for delivery.
+			 * \param _overflow which notification to discard when the queue is full.
+			 * \return true if the watcher was successfully added.
+			 * \see RemoveWatcher, GetWatcherStatistics, NotificationFilter
+			 */
+			bool AddWatcher(pfnOnNotification_t _watcher, void* _context, NotificationFilter const& _filter, uint32 const _queueSize, WatcherOverflow const _overflow = WatcherOverflow_DropOldest);
+
+			/**
+			 * \brief Get the delivery statistics of a queued watcher.
+			 * \param _watcher pointer to a function that was passed to AddWatcher.
+			 * \param _context pointer to user defined data passed in that same call to AddWatcher.
+			 * \param _data pointer to a structure that receives the statistics.
+			 * \return true if the watcher exists and is queued.
+			 * \see AddWatcher
+			 */
+			bool GetWatcherStatistics(pfnOnNotification_t _watcher, void* _context, WatcherStatistics* _data);
+
 			/**
 			 * \brief Remove a notification watcher.
 			 * \param _watcher pointer to a function that must match that passed to a previous call to AddWatcher
@@ -1821,16 +2028,26 @@ namespace OpenZWave
 			{
 					pfnOnNotification_t m_callback;
 					void* m_context;
+					NotificationFilter m_filter;
+					Internal::WatcherQueue* m_queue;			// NULL if the watcher is called on the driver thread
 
-					Watcher(pfnOnNotification_t _callback, void* _context) :
-							m_callback(_callback), m_context(_context)
+					Watcher(pfnOnNotification_t _callback, void* _context, NotificationFilter const& _filter, Internal::WatcherQueue* _queue) :
+							m_callback(_callback), m_context(_context), m_filter(_filter), m_queue(_queue)
 					{
 					}
 			};
 
+			bool InsertWatcher(Watcher* _watcher);				// Add a watcher to the list and the type index, unless it is already registered.
+
 			list<Watcher*> m_watchers;							// List of all the registered watchers.
+			list<Watcher*> m_watchersByType[NotificationFilter::TypeCount];	// Watchers interested in each notification type, in registration order.
+
+			void RemoveWatcherFromList(list<Watcher*>& _list, Watcher* _watcher);	// Erase a watcher from a list, moving any iterator currently on it.
+			void ReapWatcherQueues();							// Delete the queues of removed watchers whose threads have exited.
+			list<Internal::WatcherQueue*> m_retiredQueues;		// Queues of removed watchers, waiting for their delivery threads to exit.
 			list<list<Watcher*>::iterator*> m_watcherIterators;					// Iterators currently operating on the list of watchers
 			Internal::Platform::Mutex* m_notificationMutex;
+			uint32 m_notificationCounts[NotificationFilter::TypeCount];			// Notifications passed to NotifyWatchers, by type.  Guarded by m_notificationMutex.
 
 			//-----------------------------------------------------------------------------
 			// Controller commands
@@ -2627,6 +2844,44 @@ namespace OpenZWave
 			 */
 			static string GetNodeRouteSpeed(Node::NodeData *_data);
 
+			/**
+			 * \brief Get the statistics of all drivers and nodes in the Prometheus text format.
+			 * This is the same text that is written to the MetricsFile option and served on
+			 * the MetricsPort option.  It includes message and error counters, send queue
+			 * depths, round trip time and poll lag histograms, per-node counters and
+			 * notification counts by type.
+			 * \return The metrics, one sample per line.
+			 */
+			string GetMetrics();
+
+			/**
+			 * \brief Get a report of the memory held by the library.
+			 * Bytes and object counts are given for command classes, values, groups, messages,
+			 * localization, the manufacturer specific database, notification types and device
+			 * classes, and then for each node broken down by command class and value type.
+			 * The counts come from the allocations themselves.  Memory held through the
+			 * strings and maps inside those objects is not included.  Memory is only counted
+			 * when the MemoryAccounting option is set.
+			 * \return The report, one line per entry.
+			 * \see GetNodeMemoryUsage, LogMemoryUsage
+			 */
+			string GetMemoryUsage();
+
+			/**
+			 * \brief Get the memory held by a node's command classes, values, groups and queued messages.
+			 * \param _homeId The Home ID of the Z-Wave controller that manages the node.
+			 * \param _nodeId The ID of the node to query.
+			 * \param o_objects If not NULL, receives the number of objects.
+			 * \return The number of bytes.
+			 * \see GetMemoryUsage
+			 */
+			uint64 GetNodeMemoryUsage(uint32 const _homeId, uint8 const _nodeId, uint32* o_objects = NULL);
+
+			/**
+			 * \brief Write the report returned by GetMemoryUsage to the log at the Info level.
+			 */
+			void LogMemoryUsage();
+
 			/*@}*/
 
 			//-----------------------------------------------------------------------------
@@ -35,6 +35,7 @@
 #include "Node.h"
 #include "platform/Ref.h"
 #include "Defs.h"
+#include "MemoryAccounting.h"
 
 namespace OpenZWave
 {
@@ -56,6 +57,14 @@ namespace OpenZWave
 				~ProductDescriptor()
 				{
 
+				}
+				static void* operator new(size_t _size)
+				{
+					return Internal::MemoryAccounting::Allocate(_size, Internal::MemoryAccounting::Category_ManufacturerSpecificDB);
+				}
+				static void operator delete(void* _ptr)
+				{
+					Internal::MemoryAccounting::Free(_ptr);
 				}
 				int64 GetKey() const
 				{
@@ -0,0 +1,308 @@
+//-----------------------------------------------------------------------------
+//
+//	MemoryAccounting.cpp
+//
+//	Counts the memory held by nodes and by the global tables
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+
+#include "MemoryAccounting.h"
+#include "Utils.h"
+#include "command_classes/CommandClasses.h"
+#include "value_classes/Value.h"
+#include "platform/Mutex.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		MemoryAccounting* MemoryAccounting::s_instance = NULL;
+
+		static char const* c_categoryNames[] =
+		{ "CommandClass", "Value", "Group", "Msg", "Localization", "ManufacturerSpecificDB", "NotificationCCTypes", "DeviceClasses" };
+
+//-----------------------------------------------------------------------------
+// <MemoryAccounting::Create>
+// Start accounting.  Objects allocated before this are never counted.
+//-----------------------------------------------------------------------------
+		bool MemoryAccounting::Create()
+		{
+			if (!s_instance)
+			{
+				s_instance = new MemoryAccounting();
+			}
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <MemoryAccounting::Destroy>
+// Stop accounting
+//-----------------------------------------------------------------------------
+		void MemoryAccounting::Destroy()
+		{
+			delete s_instance;
+			s_instance = NULL;
+		}
+
+//-----------------------------------------------------------------------------
+// <MemoryAccounting::MemoryAccounting>
+// Constructor
+//-----------------------------------------------------------------------------
+		MemoryAccounting::MemoryAccounting() :
+				m_mutex(new Platform::Mutex())
+		{
+			for (uint32 i = 0; i < Category_Count; ++i)
+			{
+				m_categories[i].m_bytes = 0;
+				m_categories[i].m_objects = 0;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <MemoryAccounting::~MemoryAccounting>
+// Destructor
+//-----------------------------------------------------------------------------
+		MemoryAccounting::~MemoryAccounting()
+		{
+			m_mutex->Release();
+		}
+
+//-----------------------------------------------------------------------------
+// <MemoryAccounting::Allocate>
+// Allocate and count the memory for an accounted object
+//-----------------------------------------------------------------------------
+		void* MemoryAccounting::Allocate(size_t _size, Category _category)
+		{
+			void* ptr = malloc(_size ? _size : 1);
+			if (!ptr)
+			{
+				throw std::bad_alloc();
+			}
+
+			if (MemoryAccounting* instance = s_instance)
+			{
+				LockGuard LG(instance->m_mutex);
+				Block& block = instance->m_blocks[ptr];
+				block.m_size = _size;
+				block.m_category = _category;
+				block.m_attributed = false;
+				block.m_homeId = 0;
+				block.m_nodeId = 0;
+				block.m_key = 0;
+				Add(instance->m_categories[_category], _size);
+			}
+			return ptr;
+		}
+
+//-----------------------------------------------------------------------------
+// <MemoryAccounting::Free>
+// Uncount and release the memory of an accounted object
+//-----------------------------------------------------------------------------
+		void MemoryAccounting::Free(void* _ptr)
+		{
+			if (!_ptr)
+			{
+				return;
+			}
+
+			if (MemoryAccounting* instance = s_instance)
+			{
+				LockGuard LG(instance->m_mutex);
+				std::map<void const*, Block>::iterator it = instance->m_blocks.find(_ptr);
+				if (it != instance->m_blocks.end())
+				{
+					Block const& block = it->second;
+					Subtract(instance->m_categories[block.m_category], block.m_size);
+					if (block.m_attributed)
+					{
+						NodeUsage& node = instance->m_nodes[NodeKey(block.m_homeId, block.m_nodeId)];
+						Subtract(node.m_categories[block.m_category], block.m_size);
+						if (block.m_category == Category_CommandClass)
+						{
+							Subtract(node.m_commandClasses[block.m_key], block.m_size);
+						}
+						else if (block.m_category == Category_Value)
+						{
+							Subtract(node.m_valueTypes[block.m_key], block.m_size);
+						}
+					}
+					instance->m_blocks.erase(it);
+				}
+			}
+			free(_ptr);
+		}
+
+//-----------------------------------------------------------------------------
+// <MemoryAccounting::Attribute>
+// Charge an accounted object to a node
+//-----------------------------------------------------------------------------
+		void MemoryAccounting::Attribute(void const* _ptr, uint32 const _homeId, uint8 const _nodeId, uint8 const _key)
+		{
+			MemoryAccounting* instance = s_instance;
+			if (!instance)
+			{
+				return;
+			}
+
+			LockGuard LG(instance->m_mutex);
+			std::map<void const*, Block>::iterator it = instance->m_blocks.find(_ptr);
+			if (it == instance->m_blocks.end() || it->second.m_attributed)
+			{
+				return;
+			}
+
+			Block& block = it->second;
+			block.m_attributed = true;
+			block.m_homeId = _homeId;
+			block.m_nodeId = _nodeId;
+			block.m_key = _key;
+
+			NodeUsage& node = instance->m_nodes[NodeKey(_homeId, _nodeId)];
+			Add(node.m_categories[block.m_category], block.m_size);
+			if (block.m_category == Category_CommandClass)
+			{
+				Add(node.m_commandClasses[_key], block.m_size);
+			}
+			else if (block.m_category == Category_Value)
+			{
+				Add(node.m_valueTypes[_key], block.m_size);
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <MemoryAccounting::GetNodeUsage>
+// Total memory charged to a node
+//-----------------------------------------------------------------------------
+		MemoryAccounting::Usage MemoryAccounting::GetNodeUsage(uint32 const _homeId, uint8 const _nodeId)
+		{
+			Usage total =
+			{ 0, 0 };
+			MemoryAccounting* instance = s_instance;
+			if (!instance)
+			{
+				return total;
+			}
+
+			LockGuard LG(instance->m_mutex);
+			std::map<uint64, NodeUsage>::const_iterator it = instance->m_nodes.find(NodeKey(_homeId, _nodeId));
+			if (it != instance->m_nodes.end())
+			{
+				for (uint32 i = 0; i < Category_Count; ++i)
+				{
+					total.m_bytes += it->second.m_categories[i].m_bytes;
+					total.m_objects += it->second.m_categories[i].m_objects;
+				}
+			}
+			return total;
+		}
+
+//-----------------------------------------------------------------------------
+// <MemoryAccounting::GetReport>
+// Describe the memory held by each category and each node
+//-----------------------------------------------------------------------------
+		string MemoryAccounting::GetReport()
+		{
+			MemoryAccounting* instance = s_instance;
+			if (!instance)
+			{
+				return "Memory accounting is not running.  Set the MemoryAccounting option to enable it\n";
+			}
+
+			char line[128];
+			string report = "Memory by category:\n";
+			LockGuard LG(instance->m_mutex);
+			for (uint32 i = 0; i < Category_Count; ++i)
+			{
+				snprintf(line, sizeof(line), "  %-24s %8u objects %12llu bytes\n", c_categoryNames[i], instance->m_categories[i].m_objects, (unsigned long long) instance->m_categories[i].m_bytes);
+				report += line;
+			}
+
+			for (std::map<uint64, NodeUsage>::const_iterator it = instance->m_nodes.begin(); it != instance->m_nodes.end(); ++it)
+			{
+				NodeUsage const& node = it->second;
+				Usage total =
+				{ 0, 0 };
+				for (uint32 i = 0; i < Category_Count; ++i)
+				{
+					total.m_bytes += node.m_categories[i].m_bytes;
+					total.m_objects += node.m_categories[i].m_objects;
+				}
+				if (!total.m_objects)
+				{
+					continue;
+				}
+
+				snprintf(line, sizeof(line), "Home 0x%.8x Node %d: %u objects %llu bytes\n", (uint32) (it->first >> 8), (uint8) (it->first & 0xff), total.m_objects, (unsigned long long) total.m_bytes);
+				report += line;
+				for (std::map<uint8, Usage>::const_iterator cit = node.m_commandClasses.begin(); cit != node.m_commandClasses.end(); ++cit)
+				{
+					if (cit->second.m_objects)
+					{
+						snprintf(line, sizeof(line), "  CommandClass %-32s %8u objects %12llu bytes\n", CC::CommandClasses::GetName(cit->first).c_str(), cit->second.m_objects, (unsigned long long) cit->second.m_bytes);
+						report += line;
+					}
+				}
+				for (std::map<uint8, Usage>::const_iterator vit = node.m_valueTypes.begin(); vit != node.m_valueTypes.end(); ++vit)
+				{
+					if (vit->second.m_objects)
+					{
+						snprintf(line, sizeof(line), "  Value %-39s %8u objects %12llu bytes\n", VC::Value::GetTypeNameFromEnum((ValueID::ValueType) vit->first), vit->second.m_objects, (unsigned long long) vit->second.m_bytes);
+						report += line;
+					}
+				}
+				for (uint32 i = Category_Group; i < Category_Count; ++i)
+				{
+					if (node.m_categories[i].m_objects)
+					{
+						snprintf(line, sizeof(line), "  %-45s %8u objects %12llu bytes\n", c_categoryNames[i], node.m_categories[i].m_objects, (unsigned long long) node.m_categories[i].m_bytes);
+						report += line;
+					}
+				}
+			}
+			return report;
+		}
+
+//-----------------------------------------------------------------------------
+// <MemoryAccounting::Add>
+// Count one object
+//-----------------------------------------------------------------------------
+		void MemoryAccounting::Add(Usage& _usage, size_t _size)
+		{
+			_usage.m_bytes += _size;
+			_usage.m_objects++;
+		}
+
+//-----------------------------------------------------------------------------
+// <MemoryAccounting::Subtract>
+// Uncount one object
+//-----------------------------------------------------------------------------
+		void MemoryAccounting::Subtract(Usage& _usage, size_t _size)
+		{
+			_usage.m_bytes -= _size;
+			_usage.m_objects--;
+		}
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,151 @@
+//-----------------------------------------------------------------------------
+//
+//	MemoryAccounting.h
+//
+//	Counts the memory held by nodes and by the global tables
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _MemoryAccounting_H
+#define _MemoryAccounting_H
+
+#include <stddef.h>
+#include <string>
+#include <map>
+
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class Mutex;
+		}
+
+		/** \brief Counts the bytes and objects allocated by each part of the library.
+		 *
+		 * The accounted classes route their operator new and operator delete through
+		 * Allocate() and Free(), so the sizes are those of the real allocations rather
+		 * than estimates.  Objects are charged to their category when allocated, and
+		 * also to a node once the node takes ownership of them (see Attribute()).
+		 * Memory owned indirectly through std::string and std::map members is not
+		 * included.
+		 *
+		 * Accounting only runs between Create() and Destroy(), which the Manager calls
+		 * when the MemoryAccounting option is set.  Otherwise Allocate() and Free() are
+		 * plain malloc() and free().
+		 */
+		class MemoryAccounting
+		{
+			public:
+				enum Category
+				{
+					Category_CommandClass = 0,
+					Category_Value,
+					Category_Group,
+					Category_Msg,
+					Category_Localization,
+					Category_ManufacturerSpecificDB,
+					Category_NotificationCCTypes,
+					Category_DeviceClasses,
+					Category_Count
+				};
+
+				struct Usage
+				{
+					uint64 m_bytes;
+					uint32 m_objects;
+				};
+
+				static bool Create();
+				static void Destroy();
+
+				/**
+				 * Allocate memory for an accounted object.  Throws std::bad_alloc on failure.
+				 */
+				static void* Allocate(size_t _size, Category _category);
+
+				/**
+				 * Release memory obtained from Allocate().
+				 */
+				static void Free(void* _ptr);
+
+				/**
+				 * Charge an object to a node.  _key is the command class ID for command
+				 * classes and the ValueID type for values.  Does nothing for objects that
+				 * were not allocated through Allocate().
+				 */
+				static void Attribute(void const* _ptr, uint32 const _homeId, uint8 const _nodeId, uint8 const _key = 0);
+
+				/**
+				 * Total memory charged to a node.
+				 */
+				static Usage GetNodeUsage(uint32 const _homeId, uint8 const _nodeId);
+
+				/**
+				 * Human readable report of every category and every node.
+				 */
+				static string GetReport();
+
+			private:
+				MemoryAccounting();
+				~MemoryAccounting();
+				MemoryAccounting(MemoryAccounting const&);					// prevent copy
+				MemoryAccounting& operator =(MemoryAccounting const&);		// prevent assignment
+
+				struct Block
+				{
+					size_t m_size;
+					Category m_category;
+					bool m_attributed;
+					uint32 m_homeId;
+					uint8 m_nodeId;
+					uint8 m_key;
+				};
+
+				struct NodeUsage
+				{
+					Usage m_categories[Category_Count];
+					std::map<uint8, Usage> m_commandClasses;			// Keyed by command class ID
+					std::map<uint8, Usage> m_valueTypes;				// Keyed by ValueID::ValueType
+				};
+
+				static void Add(Usage& _usage, size_t _size);
+				static void Subtract(Usage& _usage, size_t _size);
+				static uint64 NodeKey(uint32 const _homeId, uint8 const _nodeId)
+				{
+					return (((uint64) _homeId) << 8) | _nodeId;
+				}
+
+				Platform::Mutex* m_mutex;
+				std::map<void const*, Block> m_blocks;
+				Usage m_categories[Category_Count];
+				std::map<uint64, NodeUsage> m_nodes;
+
+				static MemoryAccounting* s_instance;
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_MemoryAccounting_H
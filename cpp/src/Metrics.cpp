@@ -0,0 +1,532 @@
+//-----------------------------------------------------------------------------
+//
+//	Metrics.cpp
+//
+//	Driver and node statistics in the Prometheus text exposition format
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(WIN32) && !defined(WINRT)
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#define OZW_METRICS_SOCKET_SUPPORTED
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+#include "Metrics.h"
+#include "Manager.h"
+#include "Options.h"
+#include "Utils.h"
+#include "platform/Event.h"
+#include "platform/Log.h"
+#include "platform/Mutex.h"
+#include "platform/Thread.h"
+#include "platform/TimeStamp.h"
+#include "platform/Wait.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+
+//-----------------------------------------------------------------------------
+// <MetricsHistogram::MetricsHistogram>
+// Constructor
+//-----------------------------------------------------------------------------
+		MetricsHistogram::MetricsHistogram(double const* _bounds, uint32 _count) :
+				m_bounds(_bounds, _bounds + _count), m_buckets(_count + 1, 0), m_count(0), m_sum(0), m_mutex(new Platform::Mutex())
+		{
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsHistogram::~MetricsHistogram>
+// Destructor
+//-----------------------------------------------------------------------------
+		MetricsHistogram::~MetricsHistogram()
+		{
+			m_mutex->Release();
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsHistogram::Observe>
+// Count a value in its bucket
+//-----------------------------------------------------------------------------
+		void MetricsHistogram::Observe(double _value)
+		{
+			size_t i = 0;
+			while (i < m_bounds.size() && _value > m_bounds[i])
+			{
+				++i;
+			}
+
+			LockGuard LG(m_mutex);
+			m_buckets[i]++;
+			m_count++;
+			m_sum += _value;
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsSnapshot::AddCounter>
+// Add a sample to a counter family
+//-----------------------------------------------------------------------------
+		void MetricsSnapshot::AddCounter(string const& _name, string const& _help, string const& _labels, double _value)
+		{
+			AppendSample(GetFamily(_name, _help, "counter").m_samples, _name, _labels, NULL, _value);
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsSnapshot::AddGauge>
+// Add a sample to a gauge family
+//-----------------------------------------------------------------------------
+		void MetricsSnapshot::AddGauge(string const& _name, string const& _help, string const& _labels, double _value)
+		{
+			AppendSample(GetFamily(_name, _help, "gauge").m_samples, _name, _labels, NULL, _value);
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsSnapshot::AddHistogram>
+// Add the cumulative buckets, sum and count of a histogram
+//-----------------------------------------------------------------------------
+		void MetricsSnapshot::AddHistogram(string const& _name, string const& _help, string const& _labels, MetricsHistogram const& _histogram)
+		{
+			// Copy under the lock so the buckets, sum and count are consistent
+			std::vector<uint64> buckets;
+			uint64 count;
+			double sum;
+			{
+				LockGuard LG(_histogram.m_mutex);
+				buckets = _histogram.m_buckets;
+				count = _histogram.m_count;
+				sum = _histogram.m_sum;
+			}
+
+			string& samples = GetFamily(_name, _help, "histogram").m_samples;
+			uint64 cumulative = 0;
+			char le[32];
+			for (size_t i = 0; i < buckets.size(); ++i)
+			{
+				cumulative += buckets[i];
+				if (i < _histogram.m_bounds.size())
+				{
+					snprintf(le, sizeof(le), "le=\"%.10g\"", _histogram.m_bounds[i]);
+				}
+				else
+				{
+					snprintf(le, sizeof(le), "le=\"+Inf\"");
+				}
+				AppendSample(samples, _name + "_bucket", _labels, le, (double) cumulative);
+			}
+			AppendSample(samples, _name + "_sum", _labels, NULL, sum);
+			AppendSample(samples, _name + "_count", _labels, NULL, (double) count);
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsSnapshot::Render>
+// Write every family in the text exposition format
+//-----------------------------------------------------------------------------
+		string MetricsSnapshot::Render() const
+		{
+			string out;
+			for (std::list<Family>::const_iterator it = m_families.begin(); it != m_families.end(); ++it)
+			{
+				out += "# HELP " + it->m_name + " " + it->m_help + "\n";
+				out += "# TYPE " + it->m_name + " " + it->m_type + "\n";
+				out += it->m_samples;
+			}
+			return out;
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsSnapshot::GetFamily>
+// Find a family by name, adding it if this is its first sample
+//-----------------------------------------------------------------------------
+		MetricsSnapshot::Family& MetricsSnapshot::GetFamily(string const& _name, string const& _help, char const* _type)
+		{
+			for (std::list<Family>::iterator it = m_families.begin(); it != m_families.end(); ++it)
+			{
+				if (it->m_name == _name)
+				{
+					return *it;
+				}
+			}
+
+			Family family;
+			family.m_name = _name;
+			family.m_help = _help;
+			family.m_type = _type;
+			m_families.push_back(family);
+			return m_families.back();
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsSnapshot::AppendSample>
+// Format one sample line
+//-----------------------------------------------------------------------------
+		void MetricsSnapshot::AppendSample(string& _out, string const& _name, string const& _labels, char const* _extraLabel, double _value)
+		{
+			_out += _name;
+			if (!_labels.empty() || _extraLabel)
+			{
+				_out += "{";
+				_out += _labels;
+				if (_extraLabel)
+				{
+					if (!_labels.empty())
+					{
+						_out += ",";
+					}
+					_out += _extraLabel;
+				}
+				_out += "}";
+			}
+
+			char value[32];
+			snprintf(value, sizeof(value), " %.10g\n", _value);
+			_out += value;
+		}
+
+		MetricsExporter* MetricsExporter::s_instance = NULL;
+
+//-----------------------------------------------------------------------------
+// <MetricsExporter::Create>
+// Start the exporter if the MetricsFile or MetricsPort option is set
+//-----------------------------------------------------------------------------
+		bool MetricsExporter::Create()
+		{
+			string path;
+			int32 port = 0;
+			int32 interval = 10;
+			Options::Get()->GetOptionAsString("MetricsFile", &path);
+			Options::Get()->GetOptionAsInt("MetricsPort", &port);
+			Options::Get()->GetOptionAsInt("MetricsInterval", &interval);
+			if ((path.empty() && port <= 0) || s_instance)
+			{
+				return true;
+			}
+			if (interval < 1)
+			{
+				Log::Write(LogLevel_Warning, "MetricsInterval must be at least 1 second, using 10");
+				interval = 10;
+			}
+
+			MetricsExporter* exporter = new MetricsExporter(path, port, interval);
+			if (!exporter->Open())
+			{
+				delete exporter;
+				return false;
+			}
+			s_instance = exporter;
+			s_instance->m_thread->Start(MetricsExporter::ExporterThreadEntryPoint, s_instance);
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsExporter::Destroy>
+// Stop the exporter thread
+//-----------------------------------------------------------------------------
+		void MetricsExporter::Destroy()
+		{
+			delete s_instance;
+			s_instance = NULL;
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsExporter::MetricsExporter>
+// Constructor
+//-----------------------------------------------------------------------------
+		MetricsExporter::MetricsExporter(string const& _path, int32 _port, int32 _interval) :
+				m_path(_path), m_port(_port), m_interval(_interval), m_listenFd(-1), m_thread(new Platform::Thread("metrics"))
+		{
+			m_wakeFds[0] = -1;
+			m_wakeFds[1] = -1;
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsExporter::~MetricsExporter>
+// Destructor.  Interrupts and stops the thread, then closes the sockets.
+//-----------------------------------------------------------------------------
+		MetricsExporter::~MetricsExporter()
+		{
+#ifdef OZW_METRICS_SOCKET_SUPPORTED
+			if (m_wakeFds[1] >= 0)
+			{
+				char c = 0;
+				if (write(m_wakeFds[1], &c, 1) < 0)
+				{
+					Log::Write(LogLevel_Warning, "Cannot wake the metrics thread: %s", strerror(errno));
+				}
+			}
+#endif
+			m_thread->Stop();
+			m_thread->Release();
+#ifdef OZW_METRICS_SOCKET_SUPPORTED
+			if (m_listenFd >= 0)
+			{
+				close(m_listenFd);
+			}
+			for (int i = 0; i < 2; ++i)
+			{
+				if (m_wakeFds[i] >= 0)
+				{
+					close(m_wakeFds[i]);
+				}
+			}
+#endif
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsExporter::Open>
+// Create the wake pipe and the listening socket
+//-----------------------------------------------------------------------------
+		bool MetricsExporter::Open()
+		{
+#ifdef OZW_METRICS_SOCKET_SUPPORTED
+			if (pipe(m_wakeFds) != 0)
+			{
+				Log::Write(LogLevel_Error, "Cannot create the metrics wake pipe: %s", strerror(errno));
+				return false;
+			}
+
+			if (m_port > 0)
+			{
+				m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+				if (m_listenFd < 0)
+				{
+					Log::Write(LogLevel_Error, "Cannot create the metrics socket: %s", strerror(errno));
+					return false;
+				}
+				fcntl(m_listenFd, F_SETFD, FD_CLOEXEC);
+
+				int on = 1;
+				setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+				// Only local scrapers are served; use a proxy to expose the metrics further
+				struct sockaddr_in addr;
+				memset(&addr, 0, sizeof(addr));
+				addr.sin_family = AF_INET;
+				addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+				addr.sin_port = htons((uint16) m_port);
+				if (bind(m_listenFd, (struct sockaddr*) &addr, sizeof(addr)) != 0 || listen(m_listenFd, 4) != 0)
+				{
+					Log::Write(LogLevel_Error, "Cannot listen for metrics scrapes on 127.0.0.1:%d: %s", m_port, strerror(errno));
+					return false;
+				}
+				Log::Write(LogLevel_Info, "Serving metrics on 127.0.0.1:%d", m_port);
+			}
+#else
+			if (m_port > 0)
+			{
+				Log::Write(LogLevel_Warning, "MetricsPort is not supported on this platform");
+				if (m_path.empty())
+				{
+					return false;
+				}
+			}
+#endif
+			if (!m_path.empty())
+			{
+				Log::Write(LogLevel_Info, "Writing metrics to %s every %d seconds", m_path.c_str(), m_interval);
+			}
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsExporter::ExporterThreadEntryPoint>
+// Entry point of the exporter thread
+//-----------------------------------------------------------------------------
+		void MetricsExporter::ExporterThreadEntryPoint(Platform::Event* _exitEvent, void* _context)
+		{
+			MetricsExporter* exporter = (MetricsExporter*) _context;
+			if (exporter)
+			{
+				exporter->ExporterThreadProc(_exitEvent);
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsExporter::ExporterThreadProc>
+// Rewrite the file on schedule and answer scrapes until asked to exit
+//-----------------------------------------------------------------------------
+		void MetricsExporter::ExporterThreadProc(Platform::Event* _exitEvent)
+		{
+#ifdef OZW_METRICS_SOCKET_SUPPORTED
+			uint64 const period = (uint64) m_interval * 1000000000ULL;
+			uint64 nextWrite = Platform::TimeStamp::Now();
+			while (true)
+			{
+				int timeout = -1;
+				if (!m_path.empty())
+				{
+					uint64 now = Platform::TimeStamp::Now();
+					if (now >= nextWrite)
+					{
+						WriteFile();
+						nextWrite = now + period;
+					}
+					timeout = (int) ((nextWrite - now) / 1000000) + 1;
+				}
+
+				struct pollfd fds[2];
+				nfds_t count = 1;
+				fds[0].fd = m_wakeFds[0];
+				fds[0].events = POLLIN;
+				fds[0].revents = 0;
+				if (m_listenFd >= 0)
+				{
+					fds[1].fd = m_listenFd;
+					fds[1].events = POLLIN;
+					fds[1].revents = 0;
+					count = 2;
+				}
+
+				int res = poll(fds, count, timeout);
+				if (res < 0 && errno != EINTR)
+				{
+					Log::Write(LogLevel_Error, "Metrics thread poll failed: %s", strerror(errno));
+					return;
+				}
+				if (fds[0].revents)
+				{
+					// The destructor wants us to exit
+					return;
+				}
+				if (count == 2 && (fds[1].revents & POLLIN))
+				{
+					ServeClient();
+				}
+			}
+#else
+			while (true)
+			{
+				WriteFile();
+				if (Platform::Wait::Single(_exitEvent, m_interval * 1000) == 0)
+				{
+					return;
+				}
+			}
+#endif
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsExporter::WriteFile>
+// Write a snapshot to a temporary file and rename it over MetricsFile
+//-----------------------------------------------------------------------------
+		void MetricsExporter::WriteFile()
+		{
+			string text = Manager::Get()->GetMetrics();
+			string tmpPath = m_path + ".tmp";
+
+			FILE* file = fopen(tmpPath.c_str(), "w");
+			if (!file)
+			{
+				Log::Write(LogLevel_Warning, "Cannot write metrics to %s", tmpPath.c_str());
+				return;
+			}
+			bool ok = (fwrite(text.data(), 1, text.size(), file) == text.size());
+			ok = (fclose(file) == 0) && ok;
+			if (!ok)
+			{
+				Log::Write(LogLevel_Warning, "Cannot write metrics to %s", tmpPath.c_str());
+				remove(tmpPath.c_str());
+				return;
+			}
+
+#ifndef OZW_METRICS_SOCKET_SUPPORTED
+			// rename does not replace an existing file here, so there is a brief window without one
+			remove(m_path.c_str());
+#endif
+			if (rename(tmpPath.c_str(), m_path.c_str()) != 0)
+			{
+				Log::Write(LogLevel_Warning, "Cannot replace metrics file %s", m_path.c_str());
+				remove(tmpPath.c_str());
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <MetricsExporter::ServeClient>
+// Accept one connection and answer it with a fresh snapshot
+//-----------------------------------------------------------------------------
+		void MetricsExporter::ServeClient()
+		{
+#ifdef OZW_METRICS_SOCKET_SUPPORTED
+			int fd = accept(m_listenFd, NULL, NULL);
+			if (fd < 0)
+			{
+				return;
+			}
+
+			// Bound the time a slow or idle client can hold up the thread
+			struct timeval tv;
+			tv.tv_sec = 1;
+			tv.tv_usec = 0;
+			setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+			setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+			// Read the request headers.  Any path is answered with the metrics.
+			char request[1024];
+			size_t received = 0;
+			while (received < sizeof(request) - 1)
+			{
+				ssize_t n = recv(fd, request + received, sizeof(request) - 1 - received, 0);
+				if (n <= 0)
+				{
+					break;
+				}
+				received += (size_t) n;
+				request[received] = 0;
+				if (strstr(request, "\r\n\r\n") || strstr(request, "\n\n"))
+				{
+					break;
+				}
+			}
+
+			string body = Manager::Get()->GetMetrics();
+			char header[160];
+			snprintf(header, sizeof(header), "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %u\r\nConnection: close\r\n\r\n", (unsigned int) body.size());
+			string response = header + body;
+
+			size_t sent = 0;
+			while (sent < response.size())
+			{
+				ssize_t n = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+				if (n <= 0)
+				{
+					break;
+				}
+				sent += (size_t) n;
+			}
+			close(fd);
+#endif
+		}
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,174 @@
+//-----------------------------------------------------------------------------
+//
+//	Metrics.h
+//
+//	Driver and node statistics in the Prometheus text exposition format
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _Metrics_H
+#define _Metrics_H
+
+#include <string>
+#include <vector>
+#include <list>
+
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class Event;
+			class Mutex;
+			class Thread;
+		}
+
+		/** \brief A histogram with fixed bucket bounds.
+		 *
+		 * Observations are counted in the first bucket whose upper bound is greater
+		 * than or equal to the value.  Bucket counts are stored non-cumulatively and
+		 * made cumulative when rendered.
+		 */
+		class MetricsHistogram
+		{
+			public:
+				/**
+				 * Constructor.
+				 * \param _bounds Upper bounds of the buckets, in increasing order.  An implicit +Inf bucket follows the last one.
+				 * \param _count Number of entries in _bounds.
+				 */
+				MetricsHistogram(double const* _bounds, uint32 _count);
+				~MetricsHistogram();
+
+				/**
+				 * Record one observation.  May be called from any thread.
+				 */
+				void Observe(double _value);
+
+			private:
+				MetricsHistogram(MetricsHistogram const&);					// prevent copy
+				MetricsHistogram& operator =(MetricsHistogram const&);		// prevent assignment
+
+				friend class MetricsSnapshot;
+
+				std::vector<double> m_bounds;
+				std::vector<uint64> m_buckets;						// m_bounds.size()+1 entries, the last one being +Inf
+				uint64 m_count;
+				double m_sum;
+				Platform::Mutex* m_mutex;
+		};
+
+		/** \brief Collects samples and renders them in the Prometheus text format.
+		 *
+		 * Samples may be added in any order.  They are grouped by metric name so that
+		 * every family is rendered as one block under its HELP and TYPE lines, as the
+		 * format requires, even when several drivers contribute to the same family.
+		 */
+		class MetricsSnapshot
+		{
+			public:
+				/**
+				 * Add a sample to a counter family.
+				 * \param _name Metric name, which should end in _total.
+				 * \param _help Description written on the family's HELP line.
+				 * \param _labels Label set without braces, for example home_id="0x0184a2b3",node="5".  May be empty.
+				 * \param _value The counter's current value.
+				 */
+				void AddCounter(string const& _name, string const& _help, string const& _labels, double _value);
+
+				/**
+				 * Add a sample to a gauge family.
+				 * \see AddCounter
+				 */
+				void AddGauge(string const& _name, string const& _help, string const& _labels, double _value);
+
+				/**
+				 * Add the buckets, sum and count of a histogram to a histogram family.
+				 * \see AddCounter
+				 */
+				void AddHistogram(string const& _name, string const& _help, string const& _labels, MetricsHistogram const& _histogram);
+
+				/**
+				 * Render every family in the order it was first added.
+				 */
+				string Render() const;
+
+			private:
+				struct Family
+				{
+						string m_name;
+						string m_help;
+						char const* m_type;
+						string m_samples;
+				};
+
+				Family& GetFamily(string const& _name, string const& _help, char const* _type);
+				static void AppendSample(string& _out, string const& _name, string const& _labels, char const* _extraLabel, double _value);
+
+				std::list<Family> m_families;
+		};
+
+		/** \brief Publishes the metrics of all drivers on a local socket and/or in a file.
+		 *
+		 * Created by the Manager when the MetricsFile or MetricsPort option is set.
+		 * A thread rewrites MetricsFile every MetricsInterval seconds, replacing it
+		 * atomically so a reader never sees a partial file.  When MetricsPort is set
+		 * the same thread answers HTTP requests on 127.0.0.1 with a fresh snapshot.
+		 */
+		class MetricsExporter
+		{
+			public:
+				/**
+				 * Start the exporter if either option is set.
+				 * \return false if the exporter was configured but could not be started.
+				 */
+				static bool Create();
+				static void Destroy();
+
+			private:
+				MetricsExporter(string const& _path, int32 _port, int32 _interval);
+				~MetricsExporter();
+				MetricsExporter(MetricsExporter const&);					// prevent copy
+				MetricsExporter& operator =(MetricsExporter const&);		// prevent assignment
+
+				bool Open();
+				static void ExporterThreadEntryPoint(Platform::Event* _exitEvent, void* _context);
+				void ExporterThreadProc(Platform::Event* _exitEvent);
+				void WriteFile();
+				void ServeClient();
+
+				static MetricsExporter* s_instance;
+
+				string m_path;
+				int32 m_port;
+				int32 m_interval;									// Seconds between file updates
+				int m_listenFd;
+				int m_wakeFds[2];									// Written to by the destructor to interrupt the thread
+				Platform::Thread* m_thread;
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_Metrics_H
@@ -34,6 +34,7 @@
 #include "platform/Log.h"
 #include "command_classes/MultiInstance.h"
 #include "command_classes/Security.h"
+#include "command_classes/Supervision.h"
 #include "aes/aescpp.h"
 
 namespace OpenZWave
@@ -52,7 +53,7 @@ namespace OpenZWave
 				uint8 const _expectedReply,			// = 0
 				uint8 const _expectedCommandClassId	// = 0
 				) :
-				m_logText(_logText), m_bFinal(false), m_bCallbackRequired(_bCallbackRequired), m_callbackId(0), m_expectedReply(0), m_expectedCommandClassId(_expectedCommandClassId), m_length(4), m_targetNodeId(_targetNodeId), m_sendAttempts(0), m_maxSendAttempts( MAX_TRIES), m_instance(1), m_endPoint(0), m_flags(0), m_encrypted(false), m_noncerecvd(false), m_homeId(0), m_resendDuetoCANorNAK(false)
+				m_logText(_logText), m_bFinal(false), m_bCallbackRequired(_bCallbackRequired), m_callbackId(0), m_expectedReply(0), m_expectedCommandClassId(_expectedCommandClassId), m_length(4), m_targetNodeId(_targetNodeId), m_sendAttempts(0), m_maxSendAttempts( MAX_TRIES), m_instance(1), m_endPoint(0), m_flags(0), m_sessionId(0), m_encrypted(false), m_noncerecvd(false), m_homeId(0), m_resendDuetoCANorNAK(false)
 		{
 			if (_bReplyRequired)
 			{
@@ -102,6 +103,16 @@ namespace OpenZWave
 			}
 		}
 
+//-----------------------------------------------------------------------------
+// <Msg::SetSupervision>
+// Wrap the command in a Supervision Get when the message is finalized
+//-----------------------------------------------------------------------------
+		void Msg::SetSupervision(uint8 const _sessionId)
+		{
+			m_sessionId = _sessionId;
+			m_flags |= m_Supervision;
+		}
+
 //-----------------------------------------------------------------------------
 // <Msg::Append>
 // Add a byte to the message
@@ -135,6 +146,12 @@ namespace OpenZWave
 				return;
 			}
 
+			// Supervision goes inside any Multi-Channel/Instance encapsulation
+			if ((m_flags & m_Supervision) != 0)
+			{
+				SupervisionEncap();
+			}
+
 			// Deal with Multi-Channel/Instance encapsulation
 			if ((m_flags & (m_MultiChannel | m_MultiInstance)) != 0)
 			{
@@ -199,6 +216,20 @@ namespace OpenZWave
 			}
 		}
 
+//-----------------------------------------------------------------------------
+// <Msg::GetSendDataPayload>
+// Node Id, data length and the (unencrypted) data of a finalized
+// FUNC_ID_ZW_SEND_DATA message
+//-----------------------------------------------------------------------------
+		std::string Msg::GetSendDataPayload() const
+		{
+			if (!m_bFinal || m_buffer[3] != FUNC_ID_ZW_SEND_DATA)
+			{
+				return string();
+			}
+			return string((char const*) &m_buffer[4], m_buffer[5] + 2);
+		}
+
 //-----------------------------------------------------------------------------
 // <Msg::GetAsString>
 // Create a string containing the raw data
@@ -280,6 +311,36 @@ namespace OpenZWave
 			}
 		}
 
+//-----------------------------------------------------------------------------
+// <Msg::SupervisionEncap>
+// Encapsulate the data inside a Supervision Get
+//-----------------------------------------------------------------------------
+		void Msg::SupervisionEncap()
+		{
+			char str[256];
+			if (m_buffer[3] != FUNC_ID_ZW_SEND_DATA)
+			{
+				return;
+			}
+
+			for (uint32 i = m_length - 1; i >= 6; --i)
+			{
+				m_buffer[i + 4] = m_buffer[i];
+			}
+
+			// Ask for status updates, so a node that takes time to apply the
+			// command reports Working first and then the final result
+			m_buffer[9] = m_buffer[5];
+			m_buffer[5] += 4;
+			m_buffer[6] = Internal::CC::Supervision::StaticGetCommandClassId();
+			m_buffer[7] = Internal::CC::Supervision::SupervisionCmd_Get;
+			m_buffer[8] = 0x80 | (m_sessionId & 0x3f);
+			m_length += 4;
+
+			snprintf(str, sizeof(str), "Supervised (session=%d): %s", m_sessionId, m_logText.c_str());
+			m_logText = str;
+		}
+
 //-----------------------------------------------------------------------------
 // <Node::GetDriver>
 // Get a pointer to our driver
@@ -32,6 +32,7 @@
 #include <string>
 #include <string.h>
 #include "Defs.h"
+#include "MemoryAccounting.h"
 //#include "Driver.h"
 
 namespace OpenZWave
@@ -54,14 +55,24 @@ namespace OpenZWave
 				{
 					m_MultiChannel = 0x01,		// Indicate MultiChannel encapsulation
 					m_MultiInstance = 0x02,		// Indicate MultiInstance encapsulation
+					m_Supervision = 0x04,		// Indicate Supervision encapsulation
 				};
 
 				Msg(string const& _logtext, uint8 _targetNodeId, uint8 const _msgType, uint8 const _function, bool const _bCallbackRequired, bool const _bReplyRequired = true, uint8 const _expectedReply = 0, uint8 const _expectedCommandClassId = 0);
+				static void* operator new(size_t _size)
+				{
+					return Internal::MemoryAccounting::Allocate(_size, Internal::MemoryAccounting::Category_Msg);
+				}
+				static void operator delete(void* _ptr)
+				{
+					Internal::MemoryAccounting::Free(_ptr);
+				}
 				~Msg()
 				{
 				}
 
 				void SetInstance(OpenZWave::Internal::CC::CommandClass * _cc, uint8 const _instance);	// Used to enable wrapping with MultiInstance/MultiChannel during finalize.
+				void SetSupervision(uint8 const _sessionId);	// Used to enable wrapping with Supervision during finalize.
 
 				void Append(uint8 const _data);
 				void AppendArray(const uint8* const _data, const uint8 _length);
@@ -140,6 +151,7 @@ namespace OpenZWave
 				}
 				uint8* GetBuffer();
 				string GetAsString();
+				string GetSendDataPayload() const;
 
 				uint8 GetSendAttempts() const
 				{
@@ -231,6 +243,7 @@ namespace OpenZWave
 			private:
 
 				void MultiEncap();						// Encapsulate the data inside a MultiInstance/Multicommand message
+				void SupervisionEncap();				// Encapsulate the data inside a Supervision Get
 				string m_logText;
 				bool m_bFinal;
 				bool m_bCallbackRequired;
@@ -249,6 +262,7 @@ namespace OpenZWave
 				uint8 m_instance;
 				uint8 m_endPoint;				// Endpoint to use if the message must be wrapped in a multiInstance or multiChannel command class
 				uint8 m_flags;
+				uint8 m_sessionId;				// Session to use if the message must be wrapped in a Supervision Get
 
 				bool m_encrypted;
 				bool m_noncerecvd;
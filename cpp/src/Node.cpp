@@ -38,6 +38,7 @@
 #include "Notification.h"
 #include "Msg.h"
 #include "ZWSecurity.h"
+#include "Topology.h"
 #include "platform/Log.h"
 #include "platform/Mutex.h"
 #include "Utils.h"
@@ -52,6 +53,7 @@
 #include "command_classes/ControllerReplication.h"
 #include "command_classes/ManufacturerSpecific.h"
 #include "command_classes/MultiInstance.h"
+#include "command_classes/MultiCmd.h"
 #include "command_classes/MultiChannelAssociation.h"
 #include "command_classes/Security.h"
 #include "command_classes/WakeUp.h"
@@ -100,6 +102,7 @@ static char const* c_queryStageNames[] =
 //-----------------------------------------------------------------------------
 Node::Node(uint32 const _homeId, uint8 const _nodeId) :
 		m_queryStage(QueryStage_None), m_queryPending(false), m_queryConfiguration(false), m_queryRetries(0), m_protocolInfoReceived(false), m_basicprotocolInfoReceived(false), m_nodeInfoReceived(false), m_nodePlusInfoReceived(false), m_manufacturerSpecificClassReceived(false), m_nodeInfoSupported(true), m_refreshonNodeInfoFrame(true), m_nodeAlive(true),	// assome live node
+		m_productCacheRecord(false), m_productCacheIdentified(false), m_productCacheHit(false), m_productCacheReplaying(false),
 		m_listening(true),	// assume we start out listening
 		m_frequentListening(false), m_beaming(false), m_routing(false), m_maxBaudRate(0), m_version(0), m_security(false), m_homeId(_homeId), m_nodeId(_nodeId), m_basic(0), m_generic(0), m_specific(0), m_type(""), m_addingNode(false), m_manufacturerName(""), m_productName(""), m_nodeName(""), m_location(""), m_manufacturerId(0), m_productType(0), m_productId(0), m_deviceType(0), m_role(0), m_nodeType(0), m_secured(false), m_nodeCache( NULL), m_Product( NULL), m_fileConfigRevision(0), m_loadedConfigRevision(
 				0), m_latestConfigRevision(0), m_values(new Internal::VC::ValueStore()), m_sentCnt(0), m_sentFailed(0), m_retries(0), m_receivedCnt(0), m_receivedDups(0), m_receivedUnsolicited(0), m_lastRequestRTT(0), m_lastResponseRTT(0), m_averageRequestRTT(0), m_averageResponseRTT(0), m_quality(0), m_lastReceivedMessage(), m_errors(0), m_txStatusReportSupported(false), m_txTime(0), m_hops(0), m_ackChannel(0), m_lastTxChannel(0), m_routeScheme((TXSTATUS_ROUTING_SCHEME) 0), m_routeUsed
@@ -126,6 +129,9 @@ Node::~Node()
 	// Remove any messages from queues
 	GetDriver()->RemoveQueues(m_nodeId);
 
+	// Drop the node's links from the network graph
+	GetDriver()->m_topology->RemoveNode(m_nodeId);
+
 	// Remove the values from the poll list
 	for (Internal::VC::ValueStore::Iterator it = m_values->Begin(); it != m_values->End(); ++it)
 	{
@@ -196,6 +202,14 @@ void Node::AdvanceQueries()
 				// Init the node query process
 				m_queryStage = QueryStage_ProtocolInfo;
 				m_queryRetries = 0;
+
+				// A full interview is recorded for the product cache, or replayed from it
+				bool productCache = false;
+				Options::Get()->GetOptionAsBool("ProductCache", &productCache);
+				m_productCacheRecord = productCache && (GetDriver()->GetControllerNodeId() != m_nodeId);
+				m_productCacheIdentified = false;
+				m_productCacheHit = false;
+				m_productReports.clear();
 				break;
 			}
 			case QueryStage_ProtocolInfo:
@@ -300,6 +314,10 @@ void Node::AdvanceQueries()
 				{
 					m_queryPending = pluscc->RequestState(Internal::CC::CommandClass::RequestFlag_Static, 1, Driver::MsgQueue_Query);
 				}
+				if (m_productCacheRecord && RequestProductIdentity())
+				{
+					m_queryPending = true;
+				}
 				if (m_queryPending)
 				{
 					addQSC = m_queryPending;
@@ -321,6 +339,11 @@ void Node::AdvanceQueries()
 				 */
 				Log::Write(LogLevel_Detail, m_nodeId, "QueryStage_SecurityReport");
 
+				/* Whether a node was included securely is not a property of its product, so
+				 * the supported report is always requested rather than taken from the product
+				 * cache.  The cache is consulted here for the stages that follow.
+				 */
+				LookupProductCache();
 				Internal::CC::Security* seccc = static_cast<Internal::CC::Security*>(GetCommandClass(Internal::CC::Security::StaticGetCommandClassId()));
 
 				if (seccc)
@@ -358,6 +381,8 @@ void Node::AdvanceQueries()
 				{
 					vcc = static_cast<Internal::CC::Version*>(AddCommandClass(Internal::CC::Version::StaticGetCommandClassId()));
 				}
+				// Versions cached for this product do not need to be requested again
+				ReplayProductReports(vcc->GetCommandClassId(), 1);
 				Log::Write(LogLevel_Info, m_nodeId, "Requesting Versions");
 				for (map<uint8, Internal::CC::CommandClass*>::const_iterator it = m_commandClassMap.begin(); it != m_commandClassMap.end(); ++it)
 				{
@@ -413,8 +438,17 @@ void Node::AdvanceQueries()
 					if (cc)
 					{
 						cc->SetInstance(1);
-						m_queryPending = cc->Init();
-						addQSC = m_queryPending;
+						if (m_productCacheIdentified && !cc->HasStaticRequest(Internal::CC::CommandClass::StaticRequest_Values))
+						{
+							// The report was received for the product cache, before this stage
+							Log::Write(LogLevel_Detail, m_nodeId, "Manufacturer Specific report already received");
+							cc->LoadConfigXML();
+						}
+						else
+						{
+							m_queryPending = cc->Init();
+							addQSC = m_queryPending;
+						}
 					}
 					if (!m_queryPending)
 					{
@@ -435,6 +469,10 @@ void Node::AdvanceQueries()
 					{
 						Log::Write(LogLevel_Detail, m_nodeId, "Skipping RequestInstances() because MultiChannel CC is \"after mark\"");
 					}
+					else if (ReplayProductReports(micc->GetCommandClassId(), 1))
+					{
+						Log::Write(LogLevel_Detail, m_nodeId, "Instances of this product are already known");
+					}
 					else
 					{
 						m_queryPending = micc->RequestInstances();
@@ -646,6 +684,7 @@ void Node::AdvanceQueries()
 				ClearAddingNode();
 				// Notify the watchers that the queries are complete for this node
 				Log::Write(LogLevel_Detail, m_nodeId, "QueryStage_Complete");
+				StoreProductCache();
 				Notification* notification = new Notification(Notification::Type_NodeQueriesComplete);
 				notification->SetHomeAndNodeIds(m_homeId, m_nodeId);
 				GetDriver()->QueueNotification(notification);
@@ -753,6 +792,187 @@ void Node::SetQueryStage(QueryStage const _stage, bool const _advance	// = true
 	}
 }
 
+//-----------------------------------------------------------------------------
+// <Node::WarmStart>
+// Skip the CacheLoad query stages and trust the cached data
+//-----------------------------------------------------------------------------
+bool Node::WarmStart()
+{
+	/* ReadXML clamps a completed interview to QueryStage_Session, and only keeps
+	 * m_nodeCache if the cached stage was past CacheLoad. Anything less than that
+	 * has to go through the normal query process.
+	 */
+	if (m_queryStage != QueryStage_Session || m_nodeCache == NULL)
+	{
+		return false;
+	}
+	if (GetDriver()->GetControllerNodeId() == m_nodeId)
+	{
+		return false;
+	}
+	Log::Write(LogLevel_Info, m_nodeId, "Warm Start: Trusting cached data for node %d (%s %s)", m_nodeId, GetManufacturerName().c_str(), GetProductName().c_str());
+	m_queryStage = QueryStage_Complete;
+	m_queryPending = false;
+	m_queryRetries = 0;
+
+	Notification* notification = new Notification(Notification::Type_NodeQueriesComplete);
+	notification->SetHomeAndNodeIds(m_homeId, m_nodeId);
+	GetDriver()->QueueNotification(notification);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// <Node::RequestProductIdentity>
+// Ask for the product identity and firmware ahead of the SecurityReport stage
+//-----------------------------------------------------------------------------
+bool Node::RequestProductIdentity()
+{
+	/* Identical devices only benefit once one of them has been interviewed */
+	if (m_productCacheIdentified || Internal::ProductCache::IsEmpty())
+	{
+		return false;
+	}
+	Internal::CC::ManufacturerSpecific* mcc = static_cast<Internal::CC::ManufacturerSpecific*>(GetCommandClass(Internal::CC::ManufacturerSpecific::StaticGetCommandClassId()));
+	if (!mcc)
+	{
+		return false;
+	}
+
+	Log::Write(LogLevel_Detail, m_nodeId, "Requesting the product identity for the product cache");
+	m_productCacheIdentified = true;
+	mcc->SetInstance(1);
+	mcc->SetStaticRequest(Internal::CC::CommandClass::StaticRequest_Values);
+	bool res = mcc->Init();
+	if (Internal::CC::Version* vcc = static_cast<Internal::CC::Version*>(GetCommandClass(Internal::CC::Version::StaticGetCommandClassId())))
+	{
+		res |= vcc->RequestValue(Internal::CC::CommandClass::RequestFlag_Static, 0, 1, Driver::MsgQueue_Query);
+	}
+	return res;
+}
+
+//-----------------------------------------------------------------------------
+// <Node::LookupProductCache>
+// Use the cached interview of this product, if there is one
+//-----------------------------------------------------------------------------
+void Node::LookupProductCache()
+{
+	if (!m_productCacheRecord || !m_productCacheIdentified)
+	{
+		return;
+	}
+
+	/* Only trust an identity and firmware read from the device during this interview */
+	Internal::CC::ManufacturerSpecific* mcc = static_cast<Internal::CC::ManufacturerSpecific*>(GetCommandClass(Internal::CC::ManufacturerSpecific::StaticGetCommandClassId()));
+	if (!mcc || mcc->HasStaticRequest(Internal::CC::CommandClass::StaticRequest_Values))
+	{
+		return;
+	}
+	string firmware;
+	if (Internal::CC::Version* vcc = static_cast<Internal::CC::Version*>(GetCommandClass(Internal::CC::Version::StaticGetCommandClassId())))
+	{
+		firmware = vcc->GetApplicationVersion();
+		if (firmware.empty())
+		{
+			return;
+		}
+	}
+
+	string key = Internal::ProductCache::GetKey(m_manufacturerId, m_productType, m_productId, firmware);
+	if (!Internal::ProductCache::Get(key, m_productReports))
+	{
+		Log::Write(LogLevel_Info, m_nodeId, "Product %s is not in the product cache", key.c_str());
+		return;
+	}
+	Log::Write(LogLevel_Info, m_nodeId, "Product %s is in the product cache: using %d cached reports", key.c_str(), (int) m_productReports.size());
+	m_productCacheHit = true;
+	m_productCacheRecord = false;
+}
+
+//-----------------------------------------------------------------------------
+// <Node::StoreProductCache>
+// Save the reports of a full interview to the product cache
+//-----------------------------------------------------------------------------
+void Node::StoreProductCache()
+{
+	if (!m_productCacheRecord)
+	{
+		return;
+	}
+	m_productCacheRecord = false;
+	if (!m_manufacturerSpecificClassReceived)
+	{
+		return;
+	}
+	string firmware;
+	if (Internal::CC::Version* vcc = static_cast<Internal::CC::Version*>(GetCommandClass(Internal::CC::Version::StaticGetCommandClassId())))
+	{
+		firmware = vcc->GetApplicationVersion();
+		if (firmware.empty())
+		{
+			return;
+		}
+	}
+
+	string key = Internal::ProductCache::GetKey(m_manufacturerId, m_productType, m_productId, firmware);
+	Log::Write(LogLevel_Info, m_nodeId, "Saving %d reports of product %s to the product cache", (int) m_productReports.size(), key.c_str());
+	Internal::ProductCache::Add(key, m_productReports);
+	m_productReports.clear();
+}
+
+//-----------------------------------------------------------------------------
+// <Node::RecordProductReport>
+// Keep a capability report for the product cache
+//-----------------------------------------------------------------------------
+void Node::RecordProductReport(uint8 const _commandClassId, uint8 const* _data, uint32 const _length, uint32 const _instance)
+{
+	if (!m_productCacheRecord || m_productCacheReplaying || m_queryStage == QueryStage_Complete)
+	{
+		return;
+	}
+	Internal::ProductReport report;
+	report.m_commandClassId = _commandClassId;
+	report.m_instance = (uint8) _instance;
+	report.m_data.assign(_data, _data + _length);
+	m_productReports.push_back(report);
+}
+
+//-----------------------------------------------------------------------------
+// <Node::ReplayProductReports>
+// Handle the reports cached for this product instead of asking the device
+//-----------------------------------------------------------------------------
+bool Node::ReplayProductReports(uint8 const _commandClassId, uint32 const _instance)
+{
+	if (!m_productCacheHit)
+	{
+		return false;
+	}
+	Internal::CC::CommandClass* cc = GetCommandClass(_commandClassId);
+	if (!cc)
+	{
+		return false;
+	}
+
+	/* Replaying a report can replay the reports of another command class */
+	bool replaying = m_productCacheReplaying;
+	bool replayed = false;
+	m_productCacheReplaying = true;
+	for (size_t i = 0; i < m_productReports.size(); ++i)
+	{
+		Internal::ProductReport const& report = m_productReports[i];
+		if (report.m_commandClassId == _commandClassId && report.m_instance == _instance)
+		{
+			cc->HandleMsg(&report.m_data[0], (uint32) report.m_data.size(), _instance);
+			replayed = true;
+		}
+	}
+	m_productCacheReplaying = replaying;
+	if (replayed)
+	{
+		Log::Write(LogLevel_Info, m_nodeId, "Used the cached %s reports of instance %d", cc->GetCommandClassName().c_str(), _instance);
+	}
+	return replayed;
+}
+
 //-----------------------------------------------------------------------------
 // <Node::GetQueryStageName>
 // Gets the query stage name
@@ -1020,6 +1240,7 @@ void Node::ReadXML(TiXmlElement const* _node)
 						++i;
 					}
 				}
+				GetDriver()->m_topology->SetNeighbors(m_nodeId, m_neighbors);
 			}
 			else if (!strcmp(str, "CommandClasses"))
 			{
@@ -2081,6 +2302,11 @@ void Node::ApplicationCommandHandler(uint8 const* _data, bool encrypted
 		}
 
 		pCommandClass->ReceivedCntIncr();
+		if (Internal::CC::MultiCmd* multiCmd = static_cast<Internal::CC::MultiCmd*>(GetCommandClass(Internal::CC::MultiCmd::StaticGetCommandClassId())))
+		{
+			// Match the report up with a Get sent inside a Multi Command frame
+			multiCmd->ReplyReceived(_data[5], (_data[4] > 1) ? _data[6] : 0, 0);
+		}
 		if (!pCommandClass->IsAfterMark())
 		{
 			if (!pCommandClass->HandleMsg(&_data[6], _data[4]))
@@ -2178,6 +2404,7 @@ Internal::CC::CommandClass* Node::AddCommandClass(uint8 const _commandClassId)
 	if (Internal::CC::CommandClass* pCommandClass = Internal::CC::CommandClasses::CreateCommandClass(_commandClassId, m_homeId, m_nodeId))
 	{
 		m_commandClassMap[_commandClassId] = pCommandClass;
+		Internal::MemoryAccounting::Attribute(pCommandClass, m_homeId, m_nodeId, _commandClassId);
 
 
 		/* Only Request the CC Version if we are equal or after QueryStage_SecurityReport */
@@ -2296,6 +2523,21 @@ bool Node::SetConfigParam(uint8 const _param, int32 _value, uint8 const _size)
 	return false;
 }
 
+//-----------------------------------------------------------------------------
+// <Node::SetConfigParams>
+// Set consecutive configuration parameters of the same size in a device
+//-----------------------------------------------------------------------------
+bool Node::SetConfigParams(uint16 const _firstParam, vector<int32> const& _values, uint8 const _size)
+{
+	if (Internal::CC::Configuration* cc = static_cast<Internal::CC::Configuration*>(GetCommandClass(Internal::CC::Configuration::StaticGetCommandClassId())))
+	{
+		cc->SetBulk(_firstParam, _values, _size);
+		return true;
+	}
+
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 // <Node::RequestConfigParam>
 // Request the value of a configuration parameter from the device
@@ -2314,25 +2556,16 @@ void Node::RequestConfigParam(uint8 const _param)
 //-----------------------------------------------------------------------------
 bool Node::RequestAllConfigParams(uint32 const _requestFlags)
 {
-	bool res = false;
 	if (Internal::CC::Configuration* cc = static_cast<Internal::CC::Configuration*>(GetCommandClass(Internal::CC::Configuration::StaticGetCommandClassId())))
 	{
-		// Go through all the values in the value store, and request all those which are in the Configuration command class
-		for (Internal::VC::ValueStore::Iterator it = m_values->Begin(); it != m_values->End(); ++it)
-		{
-			Internal::VC::Value* value = it->second;
-			if (value->GetID().GetCommandClassId() == Internal::CC::Configuration::StaticGetCommandClassId() && !value->IsWriteOnly())
-			{
-				/* put the ConfigParams Request into the MsgQueue_Query queue. This is so MsgQueue_Send doesn't get backlogged with a
-				 * lot of ConfigParams requests, and should help speed up any user generated messages being sent out (as the MsgQueue_Send has a higher
-				 * priority than MsgQueue_Query
-				 */
-				res |= cc->RequestValue(_requestFlags, value->GetID().GetIndex(), 1, Driver::MsgQueue_Query);
-			}
-		}
+		/* put the ConfigParams Request into the MsgQueue_Query queue. This is so MsgQueue_Send doesn't get backlogged with a
+		 * lot of ConfigParams requests, and should help speed up any user generated messages being sent out (as the MsgQueue_Send has a higher
+		 * priority than MsgQueue_Query
+		 */
+		return cc->RequestAllParameters(_requestFlags, Driver::MsgQueue_Query);
 	}
 
-	return res;
+	return false;
 }
 
 //-----------------------------------------------------------------------------
@@ -2353,6 +2586,23 @@ bool Node::RequestDynamicValues()
 	return res;
 }
 //-----------------------------------------------------------------------------
+// <Node::RefreshDynamicValues>
+// Request an update of all dynamic values at the lowest queue priority
+//-----------------------------------------------------------------------------
+bool Node::RefreshDynamicValues()
+{
+	bool res = false;
+	for (map<uint8, Internal::CC::CommandClass*>::const_iterator it = m_commandClassMap.begin(); it != m_commandClassMap.end(); ++it)
+	{
+		if (!it->second->IsAfterMark())
+		{
+			res |= it->second->RequestStateForAllInstances(Internal::CC::CommandClass::RequestFlag_Dynamic, Driver::MsgQueue_Poll);
+		}
+	}
+
+	return res;
+}
+//-----------------------------------------------------------------------------
 // <Node::RefreshValuesOnWakeup>
 // Request an update of all known dynamic values from the device
 //-----------------------------------------------------------------------------
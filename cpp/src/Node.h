@@ -33,6 +33,8 @@
 #include <list>
 #include <map>
 #include "Defs.h"
+#include "MemoryAccounting.h"
+#include "ProductCache.h"
 #include "value_classes/ValueID.h"
 #include "value_classes/ValueList.h"
 #include "Msg.h"
@@ -51,6 +53,7 @@ namespace OpenZWave
 			class CommandClass;
 			class Association;
 			class AssociationCommandConfiguration;
+			class Configuration;
 			class ControllerReplication;
 			class Hail;
 			class ManufacturerSpecific;
@@ -88,6 +91,7 @@ namespace OpenZWave
 			friend class Internal::CC::Association;
 			friend class Internal::CC::AssociationCommandConfiguration;
 			friend class Internal::CC::CommandClass;
+			friend class Internal::CC::Configuration;
 			friend class Internal::CC::ControllerReplication;
 			friend class Internal::CC::Hail;
 			friend class Internal::CC::ManufacturerSpecific;
@@ -189,6 +193,15 @@ namespace OpenZWave
 			 */
 			void SetQueryStage(QueryStage const _stage, bool const _advance = true);
 
+			/**
+			 * Used by the WarmStart option. If the cache for this node recorded a completed
+			 * interview (static, association and neighbor stages done), the cached data is
+			 * trusted as-is and the node is moved straight to QueryStage_Complete without
+			 * any traffic. Dynamic values are refreshed later via RefreshDynamicValues.
+			 * \return true if the node was warm started, false if it needs a normal CacheLoad.
+			 */
+			bool WarmStart();
+
 			/**
 			 * Returns the current query stage enum.
 			 * \return Enum value with the current query stage.
@@ -273,6 +286,43 @@ namespace OpenZWave
 		private:
 			void SetStaticRequests();
 
+			/**
+			 * Used by the ProductCache option.  Send the Manufacturer Specific and Version
+			 * Gets ahead of the SecurityReport stage, so the product is known before the
+			 * stages that can be replayed from the cache.
+			 * \return true if any message was sent.
+			 */
+			bool RequestProductIdentity();
+
+			/**
+			 * Look the product up in the product cache, once its identity and firmware
+			 * have been read from the device during this interview.  On a hit, the cached
+			 * reports are replayed by the later stages instead of querying the device.
+			 */
+			void LookupProductCache();
+
+			/**
+			 * Save the reports recorded during a full interview to the product cache.
+			 */
+			void StoreProductCache();
+
+			/**
+			 * Keep a report that describes the capabilities of the device, if this
+			 * interview is being recorded for the product cache.
+			 */
+			void RecordProductReport(uint8 const _commandClassId, uint8 const* _data, uint32 const _length, uint32 const _instance);
+
+			/**
+			 * Pass the cached reports of a command class instance to its HandleMsg.
+			 * \return true if any report was replayed.
+			 */
+			bool ReplayProductReports(uint8 const _commandClassId, uint32 const _instance);
+
+			bool IsReplayingProductReports() const
+			{
+				return m_productCacheReplaying;
+			}
+
 			QueryStage m_queryStage;
 			bool m_queryPending;
 			bool m_queryConfiguration;
@@ -286,6 +336,12 @@ namespace OpenZWave
 			bool m_refreshonNodeInfoFrame;
 			bool m_nodeAlive;
 
+			bool m_productCacheRecord;						// Record the capability reports of this interview for the product cache
+			bool m_productCacheIdentified;					// The identity Gets were sent ahead of the SecurityReport stage
+			bool m_productCacheHit;							// m_productReports holds the cached reports of this product
+			bool m_productCacheReplaying;
+			std::vector<Internal::ProductReport> m_productReports;
+
 			//-----------------------------------------------------------------------------
 			// Capabilities
 			//-----------------------------------------------------------------------------
@@ -678,6 +734,7 @@ namespace OpenZWave
 			//-----------------------------------------------------------------------------
 		private:
 			bool SetConfigParam(uint8 const _param, int32 _value, uint8 const _size);
+			bool SetConfigParams(uint16 const _firstParam, vector<int32> const& _values, uint8 const _size);
 			void RequestConfigParam(uint8 const _param);
 			bool RequestAllConfigParams(uint32 const _requestFlags);
 
@@ -687,6 +744,12 @@ namespace OpenZWave
 		private:
 			bool RequestDynamicValues();
 		public:
+			/**
+			 * Request the dynamic values of a warm started node on the Poll queue,
+			 * so the refresh only runs when nothing else is waiting to be sent.
+			 * \return true if any requests were queued.
+			 */
+			bool RefreshDynamicValues();
 			//-----------------------------------------------------------------------------
 			// Refresh Dynamic Values from CommandClasses on Wakeup
 			//-----------------------------------------------------------------------------
@@ -722,6 +785,14 @@ namespace OpenZWave
 			{
 				public:
 					DeviceClass(TiXmlElement const* _el);
+					static void* operator new(size_t _size)
+					{
+						return Internal::MemoryAccounting::Allocate(_size, Internal::MemoryAccounting::Category_DeviceClasses);
+					}
+					static void operator delete(void* _ptr)
+					{
+						Internal::MemoryAccounting::Free(_ptr);
+					}
 					~DeviceClass()
 					{
 						delete[] m_mandatoryCommandClasses;
@@ -25,6 +25,9 @@
 //
 //-----------------------------------------------------------------------------
 
+#include <string.h>
+#include <atomic>
+#include <new>
 #include "Defs.h"
 #include "Notification.h"
 #include "Driver.h"
@@ -32,6 +35,63 @@
 
 using namespace OpenZWave;
 
+// Free list of released notifications, guarded by a spin lock since it is only held for a push or a pop
+static uint32 const c_notificationPoolSize = 256;
+static void* s_notificationPool[c_notificationPoolSize];
+static uint32 s_notificationPoolCount = 0;
+static std::atomic_flag s_notificationPoolLock = ATOMIC_FLAG_INIT;
+
+//-----------------------------------------------------------------------------
+// <Notification::operator new>
+// Reuse a released notification if there is one
+//-----------------------------------------------------------------------------
+void* Notification::operator new(size_t _size)
+{
+	if (_size == sizeof(Notification))
+	{
+		void* ptr = NULL;
+		while (s_notificationPoolLock.test_and_set(std::memory_order_acquire))
+		{
+		}
+		if (s_notificationPoolCount)
+		{
+			ptr = s_notificationPool[--s_notificationPoolCount];
+		}
+		s_notificationPoolLock.clear(std::memory_order_release);
+		if (ptr)
+		{
+			return ptr;
+		}
+	}
+	return ::operator new(sizeof(Notification) > _size ? sizeof(Notification) : _size);
+}
+
+//-----------------------------------------------------------------------------
+// <Notification::operator delete>
+// Keep a released notification for reuse unless the free list is full
+//-----------------------------------------------------------------------------
+void Notification::operator delete(void* _ptr)
+{
+	if (!_ptr)
+	{
+		return;
+	}
+
+	while (s_notificationPoolLock.test_and_set(std::memory_order_acquire))
+	{
+	}
+	if (s_notificationPoolCount < c_notificationPoolSize)
+	{
+		s_notificationPool[s_notificationPoolCount++] = _ptr;
+		_ptr = NULL;
+	}
+	s_notificationPoolLock.clear(std::memory_order_release);
+	if (_ptr)
+	{
+		::operator delete(_ptr);
+	}
+}
+
 //-----------------------------------------------------------------------------
 // <Notification::GetAsString>
 // Return a string representation of OZW
@@ -342,6 +402,122 @@ string Notification::GetAsString() const
 
 }
 
+//-----------------------------------------------------------------------------
+// <NotificationFilter::NotificationFilter>
+// Constructor.  An empty filter matches every notification
+//-----------------------------------------------------------------------------
+NotificationFilter::NotificationFilter() :
+		m_homeId(0), m_anyNode(true), m_anyType(true), m_anyCommandClass(true), m_genres(0)
+{
+	memset(m_nodes, 0, sizeof(m_nodes));
+	memset(m_types, 0, sizeof(m_types));
+	memset(m_commandClasses, 0, sizeof(m_commandClasses));
+}
+
+//-----------------------------------------------------------------------------
+// <NotificationFilter::SetHomeId>
+// Only match notifications from one network
+//-----------------------------------------------------------------------------
+NotificationFilter& NotificationFilter::SetHomeId(uint32 const _homeId)
+{
+	m_homeId = _homeId;
+	return *this;
+}
+
+//-----------------------------------------------------------------------------
+// <NotificationFilter::AddNode>
+// Add a node to the set to match
+//-----------------------------------------------------------------------------
+NotificationFilter& NotificationFilter::AddNode(uint8 const _nodeId)
+{
+	SetBit(m_nodes, _nodeId);
+	m_anyNode = false;
+	return *this;
+}
+
+//-----------------------------------------------------------------------------
+// <NotificationFilter::AddType>
+// Add a notification type to the set to match
+//-----------------------------------------------------------------------------
+NotificationFilter& NotificationFilter::AddType(Notification::NotificationType const _type)
+{
+	if ((uint32) _type < TypeCount)
+	{
+		SetBit(m_types, _type);
+		m_anyType = false;
+	}
+	return *this;
+}
+
+//-----------------------------------------------------------------------------
+// <NotificationFilter::AddCommandClass>
+// Add a command class to the set to match
+//-----------------------------------------------------------------------------
+NotificationFilter& NotificationFilter::AddCommandClass(uint8 const _commandClassId)
+{
+	SetBit(m_commandClasses, _commandClassId);
+	m_anyCommandClass = false;
+	return *this;
+}
+
+//-----------------------------------------------------------------------------
+// <NotificationFilter::AddGenre>
+// Add a value genre to the set to match
+//-----------------------------------------------------------------------------
+NotificationFilter& NotificationFilter::AddGenre(ValueID::ValueGenre const _genre)
+{
+	if (_genre < ValueID::ValueGenre_Count)
+	{
+		m_genres |= (1u << _genre);
+	}
+	return *this;
+}
+
+//-----------------------------------------------------------------------------
+// <NotificationFilter::MatchesType>
+// Test whether the filter selects a notification type
+//-----------------------------------------------------------------------------
+bool NotificationFilter::MatchesType(Notification::NotificationType const _type) const
+{
+	return m_anyType || (((uint32) _type < TypeCount) && TestBit(m_types, _type));
+}
+
+//-----------------------------------------------------------------------------
+// <NotificationFilter::Matches>
+// Test whether a notification passes the filter
+//-----------------------------------------------------------------------------
+bool NotificationFilter::Matches(Notification const* _notification) const
+{
+	if (!MatchesType(_notification->GetType()))
+	{
+		return false;
+	}
+
+	ValueID const& valueId = _notification->GetValueID();
+	if (m_homeId && (m_homeId != valueId.GetHomeId()))
+	{
+		return false;
+	}
+	if (!m_anyNode && !TestBit(m_nodes, valueId.GetNodeId()))
+	{
+		return false;
+	}
+
+	// Command class and genre only narrow notifications about values
+	if (valueId.GetCommandClassId() != 0)
+	{
+		if (!m_anyCommandClass && !TestBit(m_commandClasses, valueId.GetCommandClassId()))
+		{
+			return false;
+		}
+		if (m_genres && !(m_genres & (1u << valueId.GetGenre())))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 std::ostream& operator<<(std::ostream &os, const Notification &dt)
 {
 	os << dt.GetAsString();
@@ -52,6 +52,7 @@ namespace OpenZWave
 			class ValueStore;
 		}
 		class ManufacturerSpecificDB;
+		class WatcherQueue;
 	}
 	/** \brief Provides a container for data sent via the notification callback
 	 *    handler installed by a call to Manager::AddWatcher.
@@ -74,6 +75,7 @@ namespace OpenZWave
 			friend class Internal::CC::WakeUp;
 			friend class Internal::CC::ApplicationStatus;
 			friend class Internal::ManufacturerSpecificDB;
+			friend class Internal::WatcherQueue;
 			/* allow us to Stream a Notification */
 			//friend std::ostream &operator<<(std::ostream &os, const Notification &dt);
 
@@ -309,6 +311,10 @@ namespace OpenZWave
 			{
 			}
 
+			// Notifications are recycled through a small free list instead of the heap
+			static void* operator new(size_t _size);
+			static void operator delete(void* _ptr);
+
 			void SetHomeAndNodeIds(uint32 const _homeId, uint8 const _nodeId)
 			{
 				m_valueId = ValueID(_homeId, _nodeId);
@@ -376,6 +382,84 @@ namespace OpenZWave
 			string m_comport;
 	};
 
+	/** \brief Selects the notifications a watcher is interested in.
+	 *
+	 *    Pass a filter to Manager::AddWatcher to receive only part of the
+	 *    notification traffic.  A newly constructed filter matches every
+	 *    notification.  Each criterion that is set narrows it further, and a
+	 *    notification must satisfy all of them.  Within one criterion (for
+	 *    example a set of nodes) any listed entry matches.
+	 *
+	 *    The command class and genre criteria only apply to notifications that
+	 *    refer to a value.  Node, driver and network notifications are not
+	 *    excluded by them.
+	 */
+	class OPENZWAVE_EXPORT NotificationFilter
+	{
+		public:
+			enum
+			{
+				TypeCount = Notification::Type_ManufacturerSpecificDBReady + 1 /**< Number of notification types a filter can select */
+			};
+
+			NotificationFilter();
+
+			/**
+			 * \brief Only match notifications from one Z-Wave network.
+			 * \param _homeId the Home ID of the network.  Zero matches every network.
+			 */
+			NotificationFilter& SetHomeId(uint32 const _homeId);
+
+			/**
+			 * \brief Add a node to the set of nodes to match.
+			 */
+			NotificationFilter& AddNode(uint8 const _nodeId);
+
+			/**
+			 * \brief Add a notification type to the set of types to match.
+			 */
+			NotificationFilter& AddType(Notification::NotificationType const _type);
+
+			/**
+			 * \brief Add a command class to the set of command classes to match.
+			 */
+			NotificationFilter& AddCommandClass(uint8 const _commandClassId);
+
+			/**
+			 * \brief Add a genre to the set of value genres to match.
+			 */
+			NotificationFilter& AddGenre(ValueID::ValueGenre const _genre);
+
+			/**
+			 * \brief Test whether the filter selects a notification type.
+			 */
+			bool MatchesType(Notification::NotificationType const _type) const;
+
+			/**
+			 * \brief Test whether a notification passes the filter.
+			 */
+			bool Matches(Notification const* _notification) const;
+
+		private:
+			static bool TestBit(uint32 const* _bits, uint32 const _index)
+			{
+				return ((_bits[_index >> 5] & (1u << (_index & 0x1f))) != 0);
+			}
+			static void SetBit(uint32* _bits, uint32 const _index)
+			{
+				_bits[_index >> 5] |= (1u << (_index & 0x1f));
+			}
+
+			uint32 m_homeId;
+			bool m_anyNode;
+			bool m_anyType;
+			bool m_anyCommandClass;
+			uint32 m_nodes[8];
+			uint32 m_types[(TypeCount + 31) / 32];
+			uint32 m_commandClasses[8];
+			uint32 m_genres;
+	};
+
 } //namespace OpenZWave
 
 std::ostream& operator<<(std::ostream &os, const OpenZWave::Notification &dt);
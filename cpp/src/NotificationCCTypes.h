@@ -32,6 +32,7 @@
 #include <string>
 #include <map>
 #include "Defs.h"
+#include "MemoryAccounting.h"
 #include "Driver.h"
 #include "command_classes/CommandClass.h"
 
@@ -56,6 +57,14 @@ namespace OpenZWave
 				class NotificationEventParams
 				{
 					public:
+						static void* operator new(size_t _size)
+						{
+							return Internal::MemoryAccounting::Allocate(_size, Internal::MemoryAccounting::Category_NotificationCCTypes);
+						}
+						static void operator delete(void* _ptr)
+						{
+							Internal::MemoryAccounting::Free(_ptr);
+						}
 						uint32 id;
 						string name;
 						NotificationEventParamTypes type;
@@ -64,6 +73,14 @@ namespace OpenZWave
 				class NotificationEvents
 				{
 					public:
+						static void* operator new(size_t _size)
+						{
+							return Internal::MemoryAccounting::Allocate(_size, Internal::MemoryAccounting::Category_NotificationCCTypes);
+						}
+						static void operator delete(void* _ptr)
+						{
+							Internal::MemoryAccounting::Free(_ptr);
+						}
 						uint32 id;
 						string name;
 						std::map<uint32, std::shared_ptr<NotificationCCTypes::NotificationEventParams> > EventParams;
@@ -71,6 +88,14 @@ namespace OpenZWave
 				class NotificationTypes
 				{
 					public:
+						static void* operator new(size_t _size)
+						{
+							return Internal::MemoryAccounting::Allocate(_size, Internal::MemoryAccounting::Category_NotificationCCTypes);
+						}
+						static void operator delete(void* _ptr)
+						{
+							Internal::MemoryAccounting::Free(_ptr);
+						}
 						uint32 id;
 						string name;
 						std::map<uint32, std::shared_ptr<NotificationCCTypes::NotificationEvents> > Events;
@@ -132,6 +132,21 @@ Options* Options::Create(string const& _configPath, string const& _userPath, str
 		s_instance->AddOptionString("ReloadAfterUpdate", "AWAKE", false);			// Should we automatically Reload Nodes after a update
 		s_instance->AddOptionString("Language", "", false);			// Language we should use
 		s_instance->AddOptionBool("IncludeInstanceLabel", true);						// Should we include the Instance Label in Value Labels on MultiInstance Devices
+		s_instance->AddOptionBool("WarmStart", false);						// if true, nodes with a complete cache entry skip the CacheLoad/Session/Dynamic query stages on startup
+		s_instance->AddOptionInt("WarmStartRefreshDelay", 2000);				// Milliseconds between the background dynamic value refreshes of warm started nodes
+		s_instance->AddOptionBool("MultiCmdBatching", false);				// if true, commands queued for a sleeping node that supports COMMAND_CLASS_MULTI_CMD are packed into Multi Command frames when it wakes up
+		s_instance->AddOptionString("ValueTableFile", "", false);				// if set, the current state of every value is mirrored into this memory mapped file (for example /dev/shm/ozw-values)
+		s_instance->AddOptionInt("ValueTableSize", 4096);					// Number of value slots in the ValueTableFile
+		s_instance->AddOptionInt("ValueHistorySize", 0);					// if non zero, the recent history of every numeric value is kept in memory, with this many entries per tier (see Manager::GetValueHistory)
+		s_instance->AddOptionInt("ValueHistoryResolution", 60);				// Seconds per entry of the downsampled value history.  The coarse tier uses 60 times this.
+		s_instance->AddOptionBool("ValueHistoryPersist", false);				// if true, the value histories are saved alongside the cache and restored on startup
+		s_instance->AddOptionString("MetricsFile", "", false);				// if set, driver and node statistics are written to this file in the Prometheus text format
+		s_instance->AddOptionInt("MetricsPort", 0);						// if non zero, the same statistics are served over HTTP on 127.0.0.1 at this port
+		s_instance->AddOptionInt("MetricsInterval", 10);					// Seconds between rewrites of the MetricsFile
+		s_instance->AddOptionString("CaptureFile", "", false);				// if set, every serial frame to and from each controller is recorded in this file, with the controller path added to its name, for replay with ControllerInterface_Replay
+		s_instance->AddOptionInt("ReplaySpeed", 1);						// Speed-up factor when replaying a capture.  1 keeps the recorded timing, 0 replays as fast as possible
+		s_instance->AddOptionBool("ProductCache", false);					// if true, nodes with the same manufacturer, product and firmware as a node already interviewed reuse its version, endpoint and supported type reports (saved in ozwproducts.xml in the UserPath)
+		s_instance->AddOptionBool("MemoryAccounting", false);				// if true, the memory held by each subsystem and node is counted (see Manager::GetMemoryUsage).  This locks a mutex on every allocation of the accounted classes
 #if defined WINRT
 				s_instance->AddOptionInt( "ThreadTerminateTimeout", -1);						// Since threads cannot be terminated in WinRT, Thread::Terminate will simply wait for them to exit on there own
 #endif
@@ -0,0 +1,232 @@
+//-----------------------------------------------------------------------------
+//
+//	ProductCache.cpp
+//
+//	Interview results shared between nodes of the same product
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ProductCache.h"
+#include "Options.h"
+#include "Utils.h"
+#include "platform/Log.h"
+#include "platform/Mutex.h"
+#include "tinyxml.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		static int const c_productCacheVersion = 1;
+
+		std::map<string, std::vector<ProductReport> > ProductCache::s_products;
+		bool ProductCache::s_loaded = false;
+		Platform::Mutex* ProductCache::s_mutex = new Platform::Mutex();
+
+//-----------------------------------------------------------------------------
+// <ProductCache::GetKey>
+// The key of a product
+//-----------------------------------------------------------------------------
+		string ProductCache::GetKey(uint16 const _manufacturerId, uint16 const _productType, uint16 const _productId, string const& _firmware)
+		{
+			char str[32];
+			snprintf(str, sizeof(str), "%.4x:%.4x:%.4x:", _manufacturerId, _productType, _productId);
+			return str + _firmware;
+		}
+
+//-----------------------------------------------------------------------------
+// <ProductCache::IsEmpty>
+// Whether any product has been cached
+//-----------------------------------------------------------------------------
+		bool ProductCache::IsEmpty()
+		{
+			LockGuard LG(s_mutex);
+			Load();
+			return s_products.empty();
+		}
+
+//-----------------------------------------------------------------------------
+// <ProductCache::Get>
+// Copy the reports cached for a product
+//-----------------------------------------------------------------------------
+		bool ProductCache::Get(string const& _key, std::vector<ProductReport>& _reports)
+		{
+			LockGuard LG(s_mutex);
+			Load();
+			std::map<string, std::vector<ProductReport> >::const_iterator it = s_products.find(_key);
+			if (it == s_products.end())
+			{
+				return false;
+			}
+			_reports = it->second;
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <ProductCache::Add>
+// Cache the reports of a product and save the cache
+//-----------------------------------------------------------------------------
+		void ProductCache::Add(string const& _key, std::vector<ProductReport> const& _reports)
+		{
+			LockGuard LG(s_mutex);
+			Load();
+			s_products[_key] = _reports;
+			Save();
+		}
+
+//-----------------------------------------------------------------------------
+// <ProductCache::Load>
+// Read the cache file, the first time the cache is used
+//-----------------------------------------------------------------------------
+		void ProductCache::Load()
+		{
+			if (s_loaded)
+			{
+				return;
+			}
+			s_loaded = true;
+
+			string filename = GetFileName();
+			TiXmlDocument doc;
+			if (!doc.LoadFile(filename.c_str(), TIXML_ENCODING_UTF8))
+			{
+				return;
+			}
+			doc.SetUserData((void *) filename.c_str());
+
+			TiXmlElement const* productsElement = doc.RootElement();
+			int intVal;
+			if (TIXML_SUCCESS != productsElement->QueryIntAttribute("version", &intVal) || intVal != c_productCacheVersion)
+			{
+				Log::Write(LogLevel_Warning, "Product cache %s has an unknown version - Ignoring", filename.c_str());
+				return;
+			}
+
+			for (TiXmlElement const* productElement = productsElement->FirstChildElement("Product"); productElement; productElement = productElement->NextSiblingElement("Product"))
+			{
+				char const* key = productElement->Attribute("key");
+				if (!key)
+				{
+					continue;
+				}
+
+				std::vector<ProductReport>& reports = s_products[key];
+				for (TiXmlElement const* reportElement = productElement->FirstChildElement("Report"); reportElement; reportElement = reportElement->NextSiblingElement("Report"))
+				{
+					ProductReport report;
+					if (TIXML_SUCCESS != reportElement->QueryIntAttribute("commandclass", &intVal))
+					{
+						continue;
+					}
+					report.m_commandClassId = (uint8) intVal;
+					if (TIXML_SUCCESS != reportElement->QueryIntAttribute("instance", &intVal))
+					{
+						continue;
+					}
+					report.m_instance = (uint8) intVal;
+
+					char const* data = reportElement->GetText();
+					while (data && *data)
+					{
+						char* end;
+						unsigned long byte = strtoul(data, &end, 16);
+						if (end == data)
+						{
+							break;
+						}
+						report.m_data.push_back((uint8) byte);
+						data = end;
+					}
+					if (!report.m_data.empty())
+					{
+						reports.push_back(report);
+					}
+				}
+			}
+			Log::Write(LogLevel_Info, "Loaded %d products from the product cache", (int) s_products.size());
+		}
+
+//-----------------------------------------------------------------------------
+// <ProductCache::Save>
+// Write every cached product to the cache file
+//-----------------------------------------------------------------------------
+		void ProductCache::Save()
+		{
+			char str[16];
+
+			TiXmlDocument doc;
+			TiXmlDeclaration* decl = new TiXmlDeclaration("1.0", "utf-8", "");
+			TiXmlElement* productsElement = new TiXmlElement("Products");
+			doc.LinkEndChild(decl);
+			doc.LinkEndChild(productsElement);
+
+			productsElement->SetAttribute("xmlns", "https://github.com/OpenZWave/open-zwave");
+			snprintf(str, sizeof(str), "%d", c_productCacheVersion);
+			productsElement->SetAttribute("version", str);
+
+			for (std::map<string, std::vector<ProductReport> >::const_iterator it = s_products.begin(); it != s_products.end(); ++it)
+			{
+				TiXmlElement* productElement = new TiXmlElement("Product");
+				productElement->SetAttribute("key", it->first.c_str());
+
+				for (std::vector<ProductReport>::const_iterator rit = it->second.begin(); rit != it->second.end(); ++rit)
+				{
+					TiXmlElement* reportElement = new TiXmlElement("Report");
+					snprintf(str, sizeof(str), "%d", rit->m_commandClassId);
+					reportElement->SetAttribute("commandclass", str);
+					snprintf(str, sizeof(str), "%d", rit->m_instance);
+					reportElement->SetAttribute("instance", str);
+
+					string data;
+					for (size_t i = 0; i < rit->m_data.size(); ++i)
+					{
+						snprintf(str, sizeof(str), i ? " %.2x" : "%.2x", rit->m_data[i]);
+						data += str;
+					}
+					reportElement->LinkEndChild(new TiXmlText(data.c_str()));
+					productElement->LinkEndChild(reportElement);
+				}
+				productsElement->LinkEndChild(productElement);
+			}
+
+			string filename = GetFileName();
+			if (!doc.SaveFile(filename.c_str()))
+			{
+				Log::Write(LogLevel_Warning, "Unable to save the product cache to %s", filename.c_str());
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <ProductCache::GetFileName>
+// The cache file, in the UserPath
+//-----------------------------------------------------------------------------
+		string ProductCache::GetFileName()
+		{
+			string userPath;
+			Options::Get()->GetOptionAsString("UserPath", &userPath);
+			return userPath + "ozwproducts.xml";
+		}
+	} // namespace Internal
+} // namespace OpenZWave
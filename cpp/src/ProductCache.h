@@ -0,0 +1,105 @@
+//-----------------------------------------------------------------------------
+//
+//	ProductCache.h
+//
+//	Interview results shared between nodes of the same product
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _ProductCache_H
+#define _ProductCache_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class Mutex;
+		}
+
+		/** \brief A report received during an interview, as it was passed to the command class.
+		 */
+		struct ProductReport
+		{
+				uint8 m_commandClassId;
+				uint8 m_instance;
+				std::vector<uint8> m_data;		// The bytes passed to HandleMsg, including the trailing one counted by its length
+		};
+
+		/** \brief Interview results shared between nodes of the same product.
+		 *
+		 * Used by the ProductCache option.  Once a node has been fully interviewed,
+		 * the reports that describe its capabilities (command class versions, endpoints
+		 * and supported sensor and meter types) are kept
+		 * under its manufacturer ID, product type, product ID and application version.
+		 * A later node with the same identity is populated by replaying those reports
+		 * rather than asking the device again.  Security reports are never cached, as
+		 * secure inclusion differs between nodes of the same product.  The cache is saved as ozwproducts.xml
+		 * in the UserPath.
+		 */
+		class ProductCache
+		{
+			public:
+				/**
+				 * The key of a product.  _firmware is the application version reported by
+				 * the Version command class, or empty if the node does not support it.
+				 */
+				static string GetKey(uint16 const _manufacturerId, uint16 const _productType, uint16 const _productId, string const& _firmware);
+
+				/**
+				 * \return true if no product has been cached yet.
+				 */
+				static bool IsEmpty();
+
+				/**
+				 * Copy the reports cached for a product.
+				 * \return false if the product is not in the cache.
+				 */
+				static bool Get(string const& _key, std::vector<ProductReport>& _reports);
+
+				/**
+				 * Cache the reports of a product and save the cache.
+				 */
+				static void Add(string const& _key, std::vector<ProductReport> const& _reports);
+
+			private:
+				ProductCache();
+
+				static void Load();
+				static void Save();
+				static string GetFileName();
+
+				static std::map<string, std::vector<ProductReport> > s_products;
+				static bool s_loaded;
+				static Platform::Mutex* s_mutex;
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_ProductCache_H
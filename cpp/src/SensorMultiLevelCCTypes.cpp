@@ -41,6 +41,8 @@ namespace OpenZWave
 		SensorMultiLevelCCTypes *SensorMultiLevelCCTypes::m_instance = NULL;
 		std::map<uint32, std::shared_ptr<SensorMultiLevelCCTypes::SensorMultiLevelTypes> > SensorMultiLevelCCTypes::SensorTypes;
 		uint32 SensorMultiLevelCCTypes::m_revision(0);
+		SensorMultiLevelCCTypes::SensorMultiLevelTypes const* SensorMultiLevelCCTypes::m_denseTypes[256];
+		SensorMultiLevelCCTypes::SensorMultiLevelScales const* SensorMultiLevelCCTypes::m_denseScales[256][SensorMultiLevelCCTypes::DenseScaleCount];
 
 		SensorMultiLevelCCTypes::SensorMultiLevelCCTypes()
 		{
@@ -174,9 +176,31 @@ namespace OpenZWave
 			exit(0);
 #endif
 			delete pDoc;
+			BuildLookup();
 			return true;
 		}
 
+		void SensorMultiLevelCCTypes::BuildLookup()
+		{
+			memset(m_denseTypes, 0, sizeof(m_denseTypes));
+			memset(m_denseScales, 0, sizeof(m_denseScales));
+			for (std::map<uint32, std::shared_ptr<SensorMultiLevelTypes> >::const_iterator it = SensorTypes.begin(); it != SensorTypes.end(); ++it)
+			{
+				if (it->first > 0xff)
+				{
+					continue;
+				}
+				m_denseTypes[it->first] = it->second.get();
+				for (SensorScales::const_iterator it2 = it->second->allSensorScales.begin(); it2 != it->second->allSensorScales.end(); ++it2)
+				{
+					if (it2->first < DenseScaleCount)
+					{
+						m_denseScales[it->first][it2->first] = it2->second.get();
+					}
+				}
+			}
+		}
+
 		std::string SensorMultiLevelCCTypes::GetSensorName(uint32 type)
 		{
 			if (SensorTypes.find(type) != SensorTypes.end())
@@ -194,7 +218,7 @@ namespace OpenZWave
 				Log::Write(LogLevel_Warning, "SensorMultiLevelCCTypes::GetSensorUnit - Unknown SensorType %d", type);
 				return "";
 			}
-			SensorScales ss = SensorTypes.at(type)->allSensorScales;
+			SensorScales const& ss = SensorTypes.at(type)->allSensorScales;
 			if (ss.find(scale) == ss.end())
 			{
 				Log::Write(LogLevel_Warning, "SensorMultiLevelCCTypes::GetSensorUnit - Unknown SensorScale %d", scale);
@@ -210,7 +234,7 @@ namespace OpenZWave
 				Log::Write(LogLevel_Warning, "SensorMultiLevelCCTypes::GetSensorUnit - Unknown SensorType %d", type);
 				return "";
 			}
-			SensorScales ss = SensorTypes.at(type)->allSensorScales;
+			SensorScales const& ss = SensorTypes.at(type)->allSensorScales;
 			if (ss.find(scale) == ss.end())
 			{
 				Log::Write(LogLevel_Warning, "SensorMultiLevelCCTypes::GetSensorUnit - Unknown SensorScale %d", scale);
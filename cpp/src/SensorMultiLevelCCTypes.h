@@ -66,6 +66,7 @@ namespace OpenZWave
 				SensorMultiLevelCCTypes();
 				~SensorMultiLevelCCTypes();
 				static bool ReadXML();
+				static void BuildLookup();
 			public:
 				static SensorMultiLevelCCTypes* Get();
 				static bool Create();
@@ -74,6 +75,18 @@ namespace OpenZWave
 				string GetSensorUnitName(uint32, uint8);
 				const SensorScales GetSensorScales(uint32);
 
+				/* Lookups for the report path, from tables built when the config file is
+				 * read.  They return NULL for an unknown type or scale and never log.
+				 */
+				SensorMultiLevelTypes const* FindSensorType(uint8 _type) const
+				{
+					return m_denseTypes[_type];
+				}
+				SensorMultiLevelScales const* FindSensorScale(uint8 _type, uint8 _scale) const
+				{
+					return (_scale < DenseScaleCount) ? m_denseScales[_type][_scale] : NULL;
+				}
+
 				//-----------------------------------------------------------------------------
 				// Instance Functions
 				//-----------------------------------------------------------------------------
@@ -81,6 +94,13 @@ namespace OpenZWave
 				static SensorMultiLevelCCTypes* m_instance;
 				static std::map<uint32, std::shared_ptr<SensorMultiLevelCCTypes::SensorMultiLevelTypes> > SensorTypes;
 				static uint32 m_revision;
+
+				enum
+				{
+					DenseScaleCount = 4		// A report's scale field is two bits
+				};
+				static SensorMultiLevelTypes const* m_denseTypes[256];
+				static SensorMultiLevelScales const* m_denseScales[256][DenseScaleCount];
 		};
 	} // namespace Internal
 } // namespace OpenZWave
@@ -54,7 +54,7 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 		TimerThread::TimerThread(Driver *_driver) :
 //m_driver( _driver ),
-				m_timerEvent(new Internal::Platform::Event()), m_timerMutex(new Internal::Platform::Mutex()), m_timerTimeout(Internal::Platform::Wait::Timeout_Infinite)
+				m_sequence(0), m_timerEvent(new Internal::Platform::Event()), m_timerMutex(new Internal::Platform::Mutex()), m_timerTimeout(Internal::Platform::Wait::Timeout_Infinite)
 		{
 		}
 
@@ -66,7 +66,7 @@ namespace OpenZWave
 		{
 			{
 				LockGuard LG(m_timerMutex);
-				for (list<TimerEventEntry *>::iterator it = m_timerEventList.begin(); it != m_timerEventList.end(); ++it)
+				for (vector<TimerEventEntry *>::iterator it = m_timerHeap.begin(); it != m_timerHeap.end(); ++it)
 				{
 					delete (*it);
 				}
@@ -83,9 +83,9 @@ namespace OpenZWave
 		{
 			Log::Write(LogLevel_Info, "Timer: thread starting");
 
-			Internal::Platform::Wait* waitObjects[2];
-			waitObjects[0] = _exitEvent;
-			waitObjects[1] = m_timerEvent;
+			Internal::Platform::WaitSet waitObjects;
+			waitObjects.Add(_exitEvent);
+			waitObjects.Add(m_timerEvent);
 			uint32 count = 2;
 
 			// Initially no timer events so infinite timeout.
@@ -94,7 +94,7 @@ namespace OpenZWave
 			while (1)
 			{
 				Log::Write(LogLevel_Detail, "Timer: waiting with timeout %d ms", m_timerTimeout);
-				int32 res = Internal::Platform::Wait::Multiple(waitObjects, count, m_timerTimeout);
+				int32 res = waitObjects.Multiple(count, m_timerTimeout);
 
 				if (res == 0)
 				{
@@ -105,29 +105,32 @@ namespace OpenZWave
 				else
 				{
 					// Timeout or new entry to timer list.
-					m_timerTimeout = Internal::Platform::Wait::Timeout_Infinite;
-
-					// Go through all waiting actions, and see if any need to be performed.
 					LockGuard LG(m_timerMutex);
-					list<TimerEventEntry *>::iterator it = m_timerEventList.begin();
-					while (it != m_timerEventList.end())
+					m_timerEvent->Reset();
+
+					// Perform the actions that are due, earliest first.  Each one is taken
+					// out of the heap before its callback runs, and the callback may set or
+					// delete other events.
+					uint64 now = Now();
+					while (!m_timerHeap.empty() && m_timerHeap[0]->deadline <= now)
 					{
-						int32 tr = (*it)->timestamp.TimeRemaining();
-						if (tr <= 0)
-						{
-							// Expired so perform action and remove from list.
-							Log::Write(LogLevel_Info, "Timer: delayed event");
-							TimerEventEntry *te = *(it++);
-							te->instance->TimerFireEvent(te);
-						}
-						else
-						{
-							// Time remaining.
-							m_timerTimeout = (m_timerTimeout == Internal::Platform::Wait::Timeout_Infinite) ? tr : std::min(m_timerTimeout, tr);
-							++it;
-						}
+						Log::Write(LogLevel_Info, "Timer: delayed event");
+						TimerEventEntry *te = m_timerHeap[0];
+						Unlink(te);
+						te->instance->TimerFireEvent(te);
+						now = Now();
+					}
+
+					// Sleep until the next one
+					if (m_timerHeap.empty())
+					{
+						m_timerTimeout = Internal::Platform::Wait::Timeout_Infinite;
+					}
+					else
+					{
+						uint64 remaining = m_timerHeap[0]->deadline - now;
+						m_timerTimeout = (remaining > 0x7fffffff) ? 0x7fffffff : (int32) remaining;
 					}
-					m_timerEvent->Reset();
 				}
 			} // while( 1 )
 		}
@@ -139,14 +142,21 @@ namespace OpenZWave
 		{
 			Log::Write(LogLevel_Info, "Timer: adding event in %d ms", _milliseconds);
 			TimerEventEntry *te = new TimerEventEntry();
-			te->timestamp.SetTime(_milliseconds);
+			te->deadline = Now() + ((_milliseconds > 0) ? _milliseconds : 0);
 			te->callback = _callback;
 			te->instance = _instance;
 			te->id = id;
-			// Don't want driver thread and timer thread accessing list at the same time.
+			// Don't want driver thread and timer thread accessing the heap at the same time.
 			LockGuard LG(m_timerMutex);
-			m_timerEventList.push_back(te);
-			m_timerEvent->Set();
+			te->sequence = m_sequence++;
+			m_timerHeap.push_back(te);
+			SiftUp(m_timerHeap.size() - 1);
+
+			// The thread only needs to wake up if this is now the first event due
+			if (te->heapIndex == 0)
+			{
+				m_timerEvent->Set();
+			}
 			return te;
 		}
 
@@ -158,15 +168,120 @@ namespace OpenZWave
 		void TimerThread::TimerDelEvent(TimerEventEntry *te)
 		{
 			LockGuard LG(m_timerMutex);
-			list<TimerEventEntry *>::iterator it = find(m_timerEventList.begin(), m_timerEventList.end(), te);
-			if (it != m_timerEventList.end())
+			// An event whose callback is running has already left the heap
+			if (te->heapIndex < m_timerHeap.size() && m_timerHeap[te->heapIndex] == te)
 			{
-				delete ((*it));
-				m_timerEventList.erase(it);
+				Unlink(te);
 			}
-			else
+			delete te;
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerThread::GetPendingEvents>
+// Number of events waiting to fire
+//-----------------------------------------------------------------------------
+		size_t TimerThread::GetPendingEvents()
+		{
+			LockGuard LG(m_timerMutex);
+			return m_timerHeap.size();
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerThread::Now>
+// Monotonic time in milliseconds
+//-----------------------------------------------------------------------------
+		uint64 TimerThread::Now()
+		{
+			return Internal::Platform::TimeStamp::Now() / 1000000;
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerThread::Earlier>
+// Heap order: by deadline, then in the order the events were set
+//-----------------------------------------------------------------------------
+		bool TimerThread::Earlier(TimerEventEntry const* _a, TimerEventEntry const* _b)
+		{
+			if (_a->deadline != _b->deadline)
+			{
+				return _a->deadline < _b->deadline;
+			}
+			return _a->sequence < _b->sequence;
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerThread::Place>
+// Store an event in a slot of the heap
+//-----------------------------------------------------------------------------
+		void TimerThread::Place(size_t _index, TimerEventEntry* _te)
+		{
+			m_timerHeap[_index] = _te;
+			_te->heapIndex = _index;
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerThread::SiftUp>
+// Move an event towards the root until its parent is due before it
+//-----------------------------------------------------------------------------
+		void TimerThread::SiftUp(size_t _index)
+		{
+			TimerEventEntry* te = m_timerHeap[_index];
+			while (_index > 0)
 			{
-				Log::Write(LogLevel_Warning, "Cant Find TimerEvent to Delete in TimerDelEvent");
+				size_t parent = (_index - 1) / 2;
+				if (!Earlier(te, m_timerHeap[parent]))
+				{
+					break;
+				}
+				Place(_index, m_timerHeap[parent]);
+				_index = parent;
+			}
+			Place(_index, te);
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerThread::SiftDown>
+// Move an event towards the leaves until it is due before its children
+//-----------------------------------------------------------------------------
+		void TimerThread::SiftDown(size_t _index)
+		{
+			TimerEventEntry* te = m_timerHeap[_index];
+			size_t size = m_timerHeap.size();
+			while (true)
+			{
+				size_t child = 2 * _index + 1;
+				if (child >= size)
+				{
+					break;
+				}
+				if (child + 1 < size && Earlier(m_timerHeap[child + 1], m_timerHeap[child]))
+				{
+					++child;
+				}
+				if (!Earlier(m_timerHeap[child], te))
+				{
+					break;
+				}
+				Place(_index, m_timerHeap[child]);
+				_index = child;
+			}
+			Place(_index, te);
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerThread::Unlink>
+// Take an event out of the heap, filling its slot with the last one
+//-----------------------------------------------------------------------------
+		void TimerThread::Unlink(TimerEventEntry* _te)
+		{
+			size_t index = _te->heapIndex;
+			TimerEventEntry* last = m_timerHeap.back();
+			m_timerHeap.pop_back();
+			_te->heapIndex = (size_t) -1;
+			if (last != _te)
+			{
+				Place(index, last);
+				SiftUp(index);
+				SiftDown(last->heapIndex);
 			}
 		}
 
@@ -191,6 +306,25 @@ namespace OpenZWave
 		}
 		;
 //-----------------------------------------------------------------------------
+// <Timer::Timer>
+// Copy Constructor.  The events stay with the original, which deletes them.
+//-----------------------------------------------------------------------------
+		Timer::Timer(Timer const& _other) :
+				m_driver(_other.m_driver)
+		{
+		}
+
+//-----------------------------------------------------------------------------
+// <Timer::operator =>
+// Assignment.  Each instance keeps its own events.
+//-----------------------------------------------------------------------------
+		Timer& Timer::operator =(Timer const& _other)
+		{
+			m_driver = _other.m_driver;
+			return *this;
+		}
+
+//-----------------------------------------------------------------------------
 // <Timer::~Timer>
 // Deconstuctor for Timer SubClass
 //-----------------------------------------------------------------------------
@@ -208,10 +342,14 @@ namespace OpenZWave
 		{
 			if (m_driver)
 			{
-				TimerThread::TimerEventEntry *te = m_driver->GetTimer()->TimerSetEvent(_milliseconds, _callback, this, id);
+				TimerThread* thread = m_driver->GetTimer();
+				// Register the event here before the thread can fire it
+				LockGuard LG(thread->m_timerMutex);
+				TimerThread::TimerEventEntry *te = thread->TimerSetEvent(_milliseconds, _callback, this, id);
 				if (te)
 				{
-					m_timerEventList.push_back(te);
+					m_timerEvents.insert(te);
+					m_timerEventIds.insert(std::make_pair(id, te));
 					return te;
 				}
 				Log::Write(LogLevel_Warning, "Could Not Register Timer Callback");
@@ -232,12 +370,14 @@ namespace OpenZWave
 		{
 			if (m_driver)
 			{
-				list<TimerThread::TimerEventEntry *>::iterator it = m_timerEventList.begin();
-				while (it != m_timerEventList.end())
+				TimerThread* thread = m_driver->GetTimer();
+				LockGuard LG(thread->m_timerMutex);
+				for (std::set<TimerThread::TimerEventEntry *>::iterator it = m_timerEvents.begin(); it != m_timerEvents.end(); ++it)
 				{
-					m_driver->GetTimer()->TimerDelEvent((*it));
-					it = m_timerEventList.erase(it);
+					thread->TimerDelEvent((*it));
 				}
+				m_timerEvents.clear();
+				m_timerEventIds.clear();
 			}
 			else
 			{
@@ -261,11 +401,13 @@ namespace OpenZWave
 		{
 			if (m_driver)
 			{
-				list<TimerThread::TimerEventEntry *>::iterator it = find(m_timerEventList.begin(), m_timerEventList.end(), te);
-				if (it != m_timerEventList.end())
+				TimerThread* thread = m_driver->GetTimer();
+				LockGuard LG(thread->m_timerMutex);
+				// te is only dereferenced once we know it has not been deleted
+				if (m_timerEvents.find(te) != m_timerEvents.end())
 				{
-					m_driver->GetTimer()->TimerDelEvent((*it));
-					m_timerEventList.erase(it);
+					Forget(te);
+					thread->TimerDelEvent(te);
 				}
 				else
 				{
@@ -288,16 +430,17 @@ namespace OpenZWave
 		{
 			if (m_driver)
 			{
-				for (list<TimerThread::TimerEventEntry *>::iterator it = m_timerEventList.begin(); it != m_timerEventList.end(); it++)
+				TimerThread* thread = m_driver->GetTimer();
+				LockGuard LG(thread->m_timerMutex);
+				std::multimap<uint32, TimerThread::TimerEventEntry *>::iterator it = m_timerEventIds.lower_bound(id);
+				if (it != m_timerEventIds.end() && it->first == id)
 				{
-					if ((*it)->id == id)
-					{
-						m_driver->GetTimer()->TimerDelEvent((*it));
-						m_timerEventList.erase(it);
-						return;
-					}
+					TimerThread::TimerEventEntry *te = it->second;
+					Forget(te);
+					thread->TimerDelEvent(te);
+					return;
 				}
-				Log::Write(LogLevel_Warning, "Cant Find TimerEvent %d to Delete in TimerDelEvent", id);
+				Log::Write(LogLevel_Detail, "No TimerEvent %d to Delete in TimerDelEvent", id);
 				return;
 			}
 			else
@@ -315,7 +458,31 @@ namespace OpenZWave
 		void Timer::TimerFireEvent(TimerThread::TimerEventEntry *te)
 		{
 			te->callback(te->id);
-			TimerDelEvent(te);
+
+			// The callback may have deleted the event itself
+			if (m_timerEvents.find(te) != m_timerEvents.end())
+			{
+				Forget(te);
+				m_driver->GetTimer()->TimerDelEvent(te);
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <Timer::Forget>
+// Stop tracking an event of this instance
+//-----------------------------------------------------------------------------
+		void Timer::Forget(TimerThread::TimerEventEntry *te)
+		{
+			m_timerEvents.erase(te);
+			std::pair<std::multimap<uint32, TimerThread::TimerEventEntry *>::iterator, std::multimap<uint32, TimerThread::TimerEventEntry *>::iterator> range = m_timerEventIds.equal_range(te->id);
+			for (std::multimap<uint32, TimerThread::TimerEventEntry *>::iterator it = range.first; it != range.second; ++it)
+			{
+				if (it->second == te)
+				{
+					m_timerEventIds.erase(it);
+					break;
+				}
+			}
 		}
 	} // namespace Internal
 } // namespace OpenZWave
@@ -38,6 +38,10 @@ using std::tr1::bind;
 using std::tr1::function;
 #endif
 
+#include <map>
+#include <set>
+#include <vector>
+
 #include "Defs.h"
 #include "platform/Event.h"
 #include "platform/Mutex.h"
@@ -46,15 +50,25 @@ using std::tr1::function;
 namespace OpenZWave
 {
 	class Driver;
+	namespace Testing
+	{
+		class TimerThreadTest;
+	}
 	namespace Internal
 	{
 		class Timer;
 		/** \brief The TimerThread class makes it possible to schedule events to happen
 		 *  at a certain time in the future.
+		 *
+		 *  Pending events are kept in a binary min-heap ordered by their deadline, so
+		 *  scheduling and cancelling an event are O(log n) and the thread only looks at
+		 *  the events that are due.  Deadlines are taken from the monotonic clock, so
+		 *  setting the wall clock does not delay or advance them.
 		 */
 		class OPENZWAVE_EXPORT TimerThread
 		{
 				friend class Timer;
+				friend class OpenZWave::Testing::TimerThreadTest;
 				//-----------------------------------------------------------------------------
 				//  Timer based actions
 				//-----------------------------------------------------------------------------
@@ -75,7 +89,9 @@ namespace OpenZWave
 				struct TimerEventEntry
 				{
 						Timer *instance;
-						Internal::Platform::TimeStamp timestamp;
+						uint64 deadline;		// Monotonic time in milliseconds when the event is due
+						uint64 sequence;		// Orders events with the same deadline by when they were set
+						size_t heapIndex;		// Position in m_timerHeap
 						TimerCallback callback;
 						uint32 id;
 				};
@@ -104,14 +120,27 @@ namespace OpenZWave
 				 */
 				void TimerDelEvent(TimerEventEntry *);
 
+				/**
+				 * Number of events waiting to fire.
+				 */
+				size_t GetPendingEvents();
+
 				/**
 				 * Main class entry point for the timer thread. Contains the main timer loop.
 				 * \param _exitEvent Exit event indicating the thread should exit
 				 */
 				void TimerThreadProc(Internal::Platform::Event* _exitEvent);
 
-				/** A list of upcoming timer events */
-				list<TimerEventEntry *> m_timerEventList;
+				static uint64 Now();
+				static bool Earlier(TimerEventEntry const* _a, TimerEventEntry const* _b);
+				void SiftUp(size_t _index);
+				void SiftDown(size_t _index);
+				void Place(size_t _index, TimerEventEntry* _te);
+				void Unlink(TimerEventEntry* _te);
+
+				/** Upcoming timer events, as a min-heap on their deadline */
+				std::vector<TimerEventEntry *> m_timerHeap;
+				uint64 m_sequence;
 
 				Internal::Platform::Event* m_timerEvent;   // Event to signal new timed action requested
 				Internal::Platform::Mutex* m_timerMutex;   // Serialize access to class members
@@ -137,6 +166,14 @@ namespace OpenZWave
 				 */
 
 				Timer();
+				/**
+				 * \brief Copy Constructor.  The copy has the same Driver, but none of the events.
+				 */
+				Timer(Timer const& _other);
+				/**
+				 * \brief Assignment.  The events of either instance are not copied.
+				 */
+				Timer& operator =(Timer const& _other);
 				/**
 				 * \brief Destructor
 				 */
@@ -158,7 +195,9 @@ namespace OpenZWave
 				 */
 				void TimerDelEvent(TimerThread::TimerEventEntry *te);
 				/**
-				 * \brief Delete a Specific Event Registered to this instance
+				 * \brief Delete a Specific Event Registered to this instance.  If several
+				 * events have the ID, the one set first is deleted.  It is not an error if
+				 * there is none, so this can cancel an event that may already have fired.
 				 * \param id The ID of the Timer To Delete
 				 */
 				void TimerDelEvent(uint32 id);
@@ -174,8 +213,11 @@ namespace OpenZWave
 				 */
 				void TimerFireEvent(TimerThread::TimerEventEntry *te);
 			private:
+				void Forget(TimerThread::TimerEventEntry *te);
+
 				Driver* m_driver;
-				list<TimerThread::TimerEventEntry *> m_timerEventList;
+				std::set<TimerThread::TimerEventEntry *> m_timerEvents;					// Events of this instance, found without dereferencing them
+				std::multimap<uint32, TimerThread::TimerEventEntry *> m_timerEventIds;	// The same events, by ID
 
 		};
 	} // namespace Internal
@@ -0,0 +1,344 @@
+//-----------------------------------------------------------------------------
+//
+//	Topology.cpp
+//
+//	Graph of the Z-Wave network built from the nodes' neighbor lists
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <string.h>
+#include <algorithm>
+#include <deque>
+
+#include "Topology.h"
+#include "Utils.h"
+#include "platform/Mutex.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+
+//-----------------------------------------------------------------------------
+// <Topology::Topology>
+// Constructor
+//-----------------------------------------------------------------------------
+		Topology::Topology() :
+				m_mutex(new Platform::Mutex()), m_dirty(true), m_analysedController(0)
+		{
+			memset(m_bitmaps, 0, sizeof(m_bitmaps));
+			memset(m_known, 0, sizeof(m_known));
+		}
+
+//-----------------------------------------------------------------------------
+// <Topology::~Topology>
+// Destructor
+//-----------------------------------------------------------------------------
+		Topology::~Topology()
+		{
+			m_mutex->Release();
+		}
+
+//-----------------------------------------------------------------------------
+// <Topology::SetNeighbors>
+// Record a node's neighbor bitmap
+//-----------------------------------------------------------------------------
+		void Topology::SetNeighbors(uint8 const _nodeId, uint8 const* _bitmap)
+		{
+			if (_nodeId == 0 || _nodeId > MaxNodes)
+			{
+				return;
+			}
+
+			LockGuard LG(m_mutex);
+			if (m_known[_nodeId] && !memcmp(m_bitmaps[_nodeId], _bitmap, BitmapSize))
+			{
+				return;
+			}
+			memcpy(m_bitmaps[_nodeId], _bitmap, BitmapSize);
+			m_known[_nodeId] = true;
+			m_dirty = true;
+		}
+
+//-----------------------------------------------------------------------------
+// <Topology::RemoveNode>
+// Forget a node
+//-----------------------------------------------------------------------------
+		void Topology::RemoveNode(uint8 const _nodeId)
+		{
+			if (_nodeId == 0 || _nodeId > MaxNodes)
+			{
+				return;
+			}
+
+			LockGuard LG(m_mutex);
+			if (m_known[_nodeId])
+			{
+				memset(m_bitmaps[_nodeId], 0, BitmapSize);
+				m_known[_nodeId] = false;
+				m_dirty = true;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <Topology::GetHopCount>
+// Links on the shortest path from the controller to a node
+//-----------------------------------------------------------------------------
+		int32 Topology::GetHopCount(uint8 const _controllerId, uint8 const _nodeId)
+		{
+			if (_nodeId == 0 || _nodeId > MaxNodes)
+			{
+				return -1;
+			}
+
+			LockGuard LG(m_mutex);
+			Analyse(_controllerId);
+			return m_hops[_nodeId];
+		}
+
+//-----------------------------------------------------------------------------
+// <Topology::GetArticulationPoints>
+// Nodes whose failure would split the network
+//-----------------------------------------------------------------------------
+		void Topology::GetArticulationPoints(uint8 const _controllerId, std::vector<uint8>& _nodes)
+		{
+			LockGuard LG(m_mutex);
+			Analyse(_controllerId);
+			_nodes = m_articulationPoints;
+		}
+
+//-----------------------------------------------------------------------------
+// <Topology::GetNodesWithoutRedundantRoutes>
+// Nodes that a single failure would cut off from the controller
+//-----------------------------------------------------------------------------
+		void Topology::GetNodesWithoutRedundantRoutes(uint8 const _controllerId, std::vector<uint8>& _nodes)
+		{
+			LockGuard LG(m_mutex);
+			Analyse(_controllerId);
+			_nodes = m_singleRoute;
+		}
+
+//-----------------------------------------------------------------------------
+// <Topology::Analyse>
+// Rebuild the adjacency lists and everything derived from them
+//-----------------------------------------------------------------------------
+		void Topology::Analyse(uint8 const _controllerId)
+		{
+			if (!m_dirty && m_analysedController == _controllerId)
+			{
+				return;
+			}
+			m_dirty = false;
+			m_analysedController = _controllerId;
+
+			// Link two known nodes if either one reports the other
+			for (uint32 i = 0; i <= MaxNodes; ++i)
+			{
+				m_adjacency[i].clear();
+				m_hops[i] = -1;
+			}
+			for (uint32 a = 1; a <= MaxNodes; ++a)
+			{
+				if (!m_known[a])
+				{
+					continue;
+				}
+				for (uint32 b = a + 1; b <= MaxNodes; ++b)
+				{
+					if (!m_known[b])
+					{
+						continue;
+					}
+					uint32 bitA = a - 1;
+					uint32 bitB = b - 1;
+					if ((m_bitmaps[a][bitB >> 3] & (1 << (bitB & 7))) || (m_bitmaps[b][bitA >> 3] & (1 << (bitA & 7))))
+					{
+						m_adjacency[a].push_back((uint8) b);
+						m_adjacency[b].push_back((uint8) a);
+					}
+				}
+			}
+
+			m_articulationPoints.clear();
+			m_singleRoute.clear();
+			if (_controllerId == 0 || _controllerId > MaxNodes || !m_known[_controllerId])
+			{
+				return;
+			}
+
+			// Hop counts by breadth first search from the controller
+			std::deque<uint8> queue;
+			m_hops[_controllerId] = 0;
+			queue.push_back(_controllerId);
+			while (!queue.empty())
+			{
+				uint8 node = queue.front();
+				queue.pop_front();
+				for (size_t i = 0; i < m_adjacency[node].size(); ++i)
+				{
+					uint8 next = m_adjacency[node][i];
+					if (m_hops[next] < 0)
+					{
+						m_hops[next] = m_hops[node] + 1;
+						queue.push_back(next);
+					}
+				}
+			}
+
+			// Articulation points and bridges of the controller's component, by an
+			// iterative depth first search that tracks the lowest discovery time
+			// reachable from each subtree
+			std::vector<int32> disc(MaxNodes + 1, -1);
+			std::vector<int32> low(MaxNodes + 1, 0);
+			std::vector<uint8> parent(MaxNodes + 1, 0);
+			std::vector<size_t> nextEdge(MaxNodes + 1, 0);
+			std::vector<bool> isArticulation(MaxNodes + 1, false);
+			std::vector<std::pair<uint8, uint8> > bridges;
+			std::vector<uint8> stack;
+			int32 time = 0;
+			uint32 rootChildren = 0;
+
+			disc[_controllerId] = low[_controllerId] = time++;
+			stack.push_back(_controllerId);
+			while (!stack.empty())
+			{
+				uint8 node = stack.back();
+				if (nextEdge[node] < m_adjacency[node].size())
+				{
+					uint8 next = m_adjacency[node][nextEdge[node]++];
+					if (disc[next] < 0)
+					{
+						parent[next] = node;
+						disc[next] = low[next] = time++;
+						stack.push_back(next);
+						if (node == _controllerId)
+						{
+							rootChildren++;
+						}
+					}
+					else if (next != parent[node])
+					{
+						low[node] = std::min(low[node], disc[next]);
+					}
+					continue;
+				}
+
+				// All of node's links have been explored
+				stack.pop_back();
+				if (node != _controllerId)
+				{
+					uint8 up = parent[node];
+					low[up] = std::min(low[up], low[node]);
+					if (up != _controllerId && low[node] >= disc[up])
+					{
+						isArticulation[up] = true;
+					}
+					if (low[node] > disc[up])
+					{
+						bridges.push_back(std::make_pair(up, node));
+					}
+				}
+			}
+			if (rootChildren > 1)
+			{
+				isArticulation[_controllerId] = true;
+			}
+			for (uint32 i = 1; i <= MaxNodes; ++i)
+			{
+				if (isArticulation[i])
+				{
+					m_articulationPoints.push_back((uint8) i);
+				}
+			}
+
+			// A node has no redundant route if losing one other node (not the
+			// controller) or one link disconnects it from the controller
+			std::vector<bool> single(MaxNodes + 1, false);
+			std::vector<bool> reached;
+			for (size_t i = 0; i < m_articulationPoints.size(); ++i)
+			{
+				uint8 skip = m_articulationPoints[i];
+				if (skip == _controllerId)
+				{
+					continue;
+				}
+				Reach(_controllerId, skip, 0, 0, reached);
+				for (uint32 n = 1; n <= MaxNodes; ++n)
+				{
+					if (n != skip && m_hops[n] > 0 && !reached[n])
+					{
+						single[n] = true;
+					}
+				}
+			}
+			for (size_t i = 0; i < bridges.size(); ++i)
+			{
+				Reach(_controllerId, 0, bridges[i].first, bridges[i].second, reached);
+				for (uint32 n = 1; n <= MaxNodes; ++n)
+				{
+					if (m_hops[n] > 0 && !reached[n])
+					{
+						single[n] = true;
+					}
+				}
+			}
+			for (uint32 i = 1; i <= MaxNodes; ++i)
+			{
+				if (single[i])
+				{
+					m_singleRoute.push_back((uint8) i);
+				}
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <Topology::Reach>
+// Mark the nodes reachable from the controller without one node or one link
+//-----------------------------------------------------------------------------
+		void Topology::Reach(uint8 const _controllerId, uint8 const _skipNode, uint8 const _skipFrom, uint8 const _skipTo, std::vector<bool>& _reached) const
+		{
+			_reached.assign(MaxNodes + 1, false);
+			std::deque<uint8> queue;
+			_reached[_controllerId] = true;
+			queue.push_back(_controllerId);
+			while (!queue.empty())
+			{
+				uint8 node = queue.front();
+				queue.pop_front();
+				for (size_t i = 0; i < m_adjacency[node].size(); ++i)
+				{
+					uint8 next = m_adjacency[node][i];
+					if (next == _skipNode || _reached[next])
+					{
+						continue;
+					}
+					if ((node == _skipFrom && next == _skipTo) || (node == _skipTo && next == _skipFrom))
+					{
+						continue;
+					}
+					_reached[next] = true;
+					queue.push_back(next);
+				}
+			}
+		}
+	} // namespace Internal
+} // namespace OpenZWave
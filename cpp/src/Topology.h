@@ -0,0 +1,115 @@
+//-----------------------------------------------------------------------------
+//
+//	Topology.h
+//
+//	Graph of the Z-Wave network built from the nodes' neighbor lists
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _Topology_H
+#define _Topology_H
+
+#include <vector>
+
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class Mutex;
+		}
+
+		/** \brief Adjacency graph of a Z-Wave network.
+		 *
+		 * Each node's neighbor bitmap (from FUNC_ID_ZW_GET_ROUTING_INFO or the cache) is
+		 * stored as it arrives.  Two nodes are linked if either lists the other.  The
+		 * analysis (hop counts, articulation points and nodes without a redundant route)
+		 * is rebuilt on the first query after a change, so updates stay cheap while a
+		 * network is being interviewed.
+		 */
+		class Topology
+		{
+			public:
+				enum
+				{
+					MaxNodes = 232,					/**< Highest node ID that can appear in a neighbor bitmap */
+					BitmapSize = 29					/**< Bytes in a neighbor bitmap */
+				};
+
+				Topology();
+				~Topology();
+
+				/**
+				 * Record the neighbor bitmap reported for a node.
+				 */
+				void SetNeighbors(uint8 const _nodeId, uint8 const* _bitmap);
+
+				/**
+				 * Forget a node and every link to it.
+				 */
+				void RemoveNode(uint8 const _nodeId);
+
+				/**
+				 * Number of links on the shortest path from the controller to a node.
+				 * \return 0 for the controller itself, or -1 if the node cannot be reached.
+				 */
+				int32 GetHopCount(uint8 const _controllerId, uint8 const _nodeId);
+
+				/**
+				 * Nodes whose failure would cut other nodes off from the rest of the network.
+				 * Only the part of the network connected to the controller is considered.
+				 */
+				void GetArticulationPoints(uint8 const _controllerId, std::vector<uint8>& _nodes);
+
+				/**
+				 * Nodes that the controller can reach, but only through a single node or a
+				 * single link whose failure would cut them off.  These are the places
+				 * where an extra repeater adds a second route.
+				 */
+				void GetNodesWithoutRedundantRoutes(uint8 const _controllerId, std::vector<uint8>& _nodes);
+
+			private:
+				Topology(Topology const&);					// prevent copy
+				Topology& operator =(Topology const&);		// prevent assignment
+
+				void Analyse(uint8 const _controllerId);
+				void Reach(uint8 const _controllerId, uint8 const _skipNode, uint8 const _skipFrom, uint8 const _skipTo, std::vector<bool>& _reached) const;
+
+				uint8 m_bitmaps[MaxNodes + 1][BitmapSize];	// Neighbor bitmaps as reported, indexed by node ID
+				bool m_known[MaxNodes + 1];					// Nodes that have reported their neighbors and not been removed
+				Platform::Mutex* m_mutex;
+
+				// Analysis, valid while m_dirty is false and for m_analysedController only
+				bool m_dirty;
+				uint8 m_analysedController;
+				std::vector<uint8> m_adjacency[MaxNodes + 1];
+				int32 m_hops[MaxNodes + 1];
+				std::vector<uint8> m_articulationPoints;
+				std::vector<uint8> m_singleRoute;
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_Topology_H
@@ -0,0 +1,275 @@
+//-----------------------------------------------------------------------------
+//
+//	ValueHistory.cpp
+//
+//	Recent history of a numeric value, kept in memory
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+
+#include "ValueHistory.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+
+//-----------------------------------------------------------------------------
+// <ValueHistory::ValueHistory>
+// Constructor
+//-----------------------------------------------------------------------------
+		ValueHistory::ValueHistory(uint32 const _size, uint32 const _resolution) :
+				m_size(_size ? _size : 1), m_resolution(_resolution ? _resolution : 1), m_sequence(0)
+		{
+			for (uint32 i = 0; i < ValueHistoryTier_Count; ++i)
+			{
+				m_rings[i].m_entries = new ValueHistoryEntry[m_size];
+				m_rings[i].m_head = 0;
+				m_rings[i].m_count = 0;
+			}
+			m_rings[ValueHistoryTier_Samples].m_period = 0;
+			m_rings[ValueHistoryTier_Resolution].m_period = (uint64) m_resolution * 1000;
+			m_rings[ValueHistoryTier_Coarse].m_period = (uint64) m_resolution * 1000 * CoarseFactor;
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueHistory::~ValueHistory>
+// Destructor
+//-----------------------------------------------------------------------------
+		ValueHistory::~ValueHistory()
+		{
+			for (uint32 i = 0; i < ValueHistoryTier_Count; ++i)
+			{
+				delete[] m_rings[i].m_entries;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueHistory::Add>
+// Record an update in every tier
+//-----------------------------------------------------------------------------
+		void ValueHistory::Add(uint64 const _time, double const _value)
+		{
+			BeginWrite();
+			ValueHistoryEntry sample;
+			sample.m_time = _time;
+			sample.m_min = sample.m_max = sample.m_avg = _value;
+			sample.m_count = 1;
+			Append(m_rings[ValueHistoryTier_Samples], sample);
+			Accumulate(m_rings[ValueHistoryTier_Resolution], _time, _value);
+			Accumulate(m_rings[ValueHistoryTier_Coarse], _time, _value);
+			EndWrite();
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueHistory::Get>
+// Copy the entries of a tier that lie in a time range
+//-----------------------------------------------------------------------------
+		uint32 ValueHistory::Get(ValueHistoryTier const _tier, uint64 const _from, uint64 const _to, std::vector<ValueHistoryEntry>& _entries) const
+		{
+			if (_tier >= ValueHistoryTier_Count)
+			{
+				return 0;
+			}
+
+			Ring const& ring = m_rings[_tier];
+			size_t const start = _entries.size();
+			while (true)
+			{
+				uint32 before = *((uint32 const volatile*) &m_sequence);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (!(before & 1))
+				{
+					uint32 count = ring.m_count;
+					uint32 index = (ring.m_head + m_size - count) % m_size;
+					for (uint32 i = 0; i < count; ++i)
+					{
+						ValueHistoryEntry const& entry = ring.m_entries[index];
+						if (entry.m_time >= _from && entry.m_time <= _to)
+						{
+							_entries.push_back(entry);
+						}
+						if (++index == m_size)
+						{
+							index = 0;
+						}
+					}
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (before == *((uint32 const volatile*) &m_sequence))
+					{
+						break;
+					}
+				}
+
+				// An update arrived while copying
+				_entries.resize(start);
+			}
+			return (uint32) (_entries.size() - start);
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueHistory::Restore>
+// Append entries read back from disk
+//-----------------------------------------------------------------------------
+		void ValueHistory::Restore(ValueHistoryTier const _tier, std::vector<ValueHistoryEntry> const& _entries)
+		{
+			if (_tier >= ValueHistoryTier_Count)
+			{
+				return;
+			}
+
+			BeginWrite();
+			for (size_t i = 0; i < _entries.size(); ++i)
+			{
+				Append(m_rings[_tier], _entries[i]);
+			}
+			EndWrite();
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueHistory::Write>
+// Save every tier: an entry count followed by the entries, oldest first
+//-----------------------------------------------------------------------------
+		bool ValueHistory::Write(FILE* _file) const
+		{
+			for (uint32 i = 0; i < ValueHistoryTier_Count; ++i)
+			{
+				std::vector<ValueHistoryEntry> entries;
+				uint32 count = Get((ValueHistoryTier) i, 0, (uint64) -1, entries);
+				if (fwrite(&count, sizeof(count), 1, _file) != 1)
+				{
+					return false;
+				}
+				if (count && fwrite(&entries[0], sizeof(ValueHistoryEntry), count, _file) != count)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueHistory::Read>
+// Read the tiers saved by Write
+//-----------------------------------------------------------------------------
+		bool ValueHistory::Read(FILE* _file, std::vector<ValueHistoryEntry> _tiers[ValueHistoryTier_Count])
+		{
+			for (uint32 i = 0; i < ValueHistoryTier_Count; ++i)
+			{
+				uint32 count;
+				if (fread(&count, sizeof(count), 1, _file) != 1 || count > 0x100000)
+				{
+					return false;
+				}
+				_tiers[i].resize(count);
+				if (count && fread(&_tiers[i][0], sizeof(ValueHistoryEntry), count, _file) != count)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueHistory::Now>
+// Wall clock time in milliseconds
+//-----------------------------------------------------------------------------
+		uint64 ValueHistory::Now()
+		{
+			return (uint64) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueHistory::Append>
+// Add an entry to a ring, overwriting the oldest once it is full
+//-----------------------------------------------------------------------------
+		void ValueHistory::Append(Ring& _ring, ValueHistoryEntry const& _entry)
+		{
+			_ring.m_entries[_ring.m_head] = _entry;
+			if (++_ring.m_head == m_size)
+			{
+				_ring.m_head = 0;
+			}
+			if (_ring.m_count < m_size)
+			{
+				_ring.m_count++;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueHistory::Accumulate>
+// Fold an update into the current period of a downsampled ring
+//-----------------------------------------------------------------------------
+		void ValueHistory::Accumulate(Ring& _ring, uint64 const _time, double const _value)
+		{
+			if (_ring.m_count)
+			{
+				ValueHistoryEntry& last = _ring.m_entries[(_ring.m_head + m_size - 1) % m_size];
+
+				// Updates from before the current period (the clock was set back) are
+				// counted in it rather than starting the periods over
+				if (_time < last.m_time + _ring.m_period)
+				{
+					if (_value < last.m_min)
+					{
+						last.m_min = _value;
+					}
+					if (_value > last.m_max)
+					{
+						last.m_max = _value;
+					}
+					last.m_count++;
+					last.m_avg += (_value - last.m_avg) / last.m_count;
+					return;
+				}
+			}
+
+			ValueHistoryEntry entry;
+			entry.m_time = _time - (_time % _ring.m_period);
+			entry.m_min = entry.m_max = entry.m_avg = _value;
+			entry.m_count = 1;
+			Append(_ring, entry);
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueHistory::BeginWrite>
+// Make the sequence odd before changing the rings
+//-----------------------------------------------------------------------------
+		void ValueHistory::BeginWrite()
+		{
+			*((uint32 volatile*) &m_sequence) = m_sequence + 1;
+			std::atomic_thread_fence(std::memory_order_release);
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueHistory::EndWrite>
+// Make the sequence even again
+//-----------------------------------------------------------------------------
+		void ValueHistory::EndWrite()
+		{
+			std::atomic_thread_fence(std::memory_order_release);
+			*((uint32 volatile*) &m_sequence) = m_sequence + 1;
+		}
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,152 @@
+//-----------------------------------------------------------------------------
+//
+//	ValueHistory.h
+//
+//	Recent history of a numeric value, kept in memory
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _ValueHistory_H
+#define _ValueHistory_H
+
+#include <stdio.h>
+#include <vector>
+
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	/** \brief The tiers of a value's history.
+	 * \see Manager::GetValueHistory
+	 */
+	enum ValueHistoryTier
+	{
+		ValueHistoryTier_Samples = 0,		/**< Every update, as it was received */
+		ValueHistoryTier_Resolution,		/**< Minimum, maximum and average over each period of ValueHistoryResolution seconds */
+		ValueHistoryTier_Coarse,			/**< Minimum, maximum and average over each period of 60 x ValueHistoryResolution seconds */
+		ValueHistoryTier_Count
+	};
+
+	/** \brief One entry of a value's history.
+	 *
+	 * In the ValueHistoryTier_Samples tier, m_min, m_max and m_avg all hold the
+	 * value that was received and m_count is 1.
+	 * \see Manager::GetValueHistory
+	 */
+	struct ValueHistoryEntry
+	{
+			uint64 m_time;					/**< Milliseconds since 1970-01-01 UTC.  For the downsampled tiers, the start of the period. */
+			double m_min;
+			double m_max;
+			double m_avg;
+			uint32 m_count;					/**< Number of updates in the period */
+	};
+
+	namespace Internal
+	{
+		/** \brief Fixed size ring buffers holding the recent history of one value.
+		 *
+		 * Each tier keeps its newest entries and overwrites the oldest once full.  The
+		 * history is written only by the thread that handles the value's reports, which
+		 * never waits: readers copy the entries under a sequence lock and try again if
+		 * an update arrived while they were copying.
+		 */
+		class ValueHistory
+		{
+			public:
+				enum
+				{
+					CoarseFactor = 60				// Periods of the Resolution tier in one period of the Coarse tier
+				};
+
+				/**
+				 * \param _size Entries kept in each tier.
+				 * \param _resolution Length in seconds of the periods of the Resolution tier.
+				 */
+				ValueHistory(uint32 const _size, uint32 const _resolution);
+				~ValueHistory();
+
+				/**
+				 * Record an update.  Must only be called from one thread at a time.
+				 */
+				void Add(uint64 const _time, double const _value);
+
+				/**
+				 * Copy the entries of a tier whose time lies in [_from, _to], oldest first.
+				 * Can be called from any thread.
+				 * \return the number of entries copied.
+				 */
+				uint32 Get(ValueHistoryTier const _tier, uint64 const _from, uint64 const _to, std::vector<ValueHistoryEntry>& _entries) const;
+
+				/**
+				 * Append the entries of a tier saved by Write.  Used when the history is
+				 * read back from disk, before any update has been added.
+				 */
+				void Restore(ValueHistoryTier const _tier, std::vector<ValueHistoryEntry> const& _entries);
+
+				/**
+				 * Save every tier to a file opened by the caller, in a format read by Read.
+				 */
+				bool Write(FILE* _file) const;
+
+				/**
+				 * Read the tiers saved by Write.
+				 * \return false if the file is truncated.
+				 */
+				static bool Read(FILE* _file, std::vector<ValueHistoryEntry> _tiers[ValueHistoryTier_Count]);
+
+				uint32 GetResolution() const
+				{
+					return m_resolution;
+				}
+
+				/**
+				 * Wall clock time in milliseconds since 1970-01-01 UTC.
+				 */
+				static uint64 Now();
+
+			private:
+				ValueHistory(ValueHistory const&);					// prevent copy
+				ValueHistory& operator =(ValueHistory const&);		// prevent assignment
+
+				struct Ring
+				{
+						ValueHistoryEntry* m_entries;
+						uint32 m_head;				// Index the next entry will be written to
+						uint32 m_count;				// Number of entries in use
+						uint64 m_period;			// Length of a period in milliseconds, or 0 to keep every update
+				};
+
+				void Append(Ring& _ring, ValueHistoryEntry const& _entry);
+				void Accumulate(Ring& _ring, uint64 const _time, double const _value);
+				void BeginWrite();
+				void EndWrite();
+
+				uint32 m_size;
+				uint32 m_resolution;
+				uint32 m_sequence;					// Sequence lock counter, odd while an update is being written
+				Ring m_rings[ValueHistoryTier_Count];
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_ValueHistory_H
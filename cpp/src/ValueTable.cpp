@@ -0,0 +1,298 @@
+//-----------------------------------------------------------------------------
+//
+//	ValueTable.cpp
+//
+//	Shared memory table of current values for out-of-process readers
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <string.h>
+#include <atomic>
+
+#if !defined(WIN32) && !defined(WINRT)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#define OZW_VALUETABLE_SUPPORTED
+#endif
+
+#include "ValueTable.h"
+#include "Options.h"
+#include "Utils.h"
+#include "platform/Log.h"
+#include "platform/Mutex.h"
+#include "platform/TimeStamp.h"
+#include "value_classes/Value.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+
+		ValueTable* ValueTable::s_instance = NULL;
+
+//-----------------------------------------------------------------------------
+// <ValueTable::Create>
+// Create the table if the ValueTableFile option is set
+//-----------------------------------------------------------------------------
+		bool ValueTable::Create()
+		{
+			string path;
+			Options::Get()->GetOptionAsString("ValueTableFile", &path);
+			if (path.empty() || s_instance)
+			{
+				return true;
+			}
+
+			int32 slotCount = 4096;
+			Options::Get()->GetOptionAsInt("ValueTableSize", &slotCount);
+			if (slotCount < 1)
+			{
+				Log::Write(LogLevel_Warning, "ValueTableSize must be at least 1, using 4096");
+				slotCount = 4096;
+			}
+
+			ValueTable* table = new ValueTable(path, (uint32) slotCount);
+			if (!table->IsOpen())
+			{
+				delete table;
+				return false;
+			}
+			s_instance = table;
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueTable::Destroy>
+// Unmap the table
+//-----------------------------------------------------------------------------
+		void ValueTable::Destroy()
+		{
+			delete s_instance;
+			s_instance = NULL;
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueTable::ValueTable>
+// Constructor.  Creates and maps the table file.
+//-----------------------------------------------------------------------------
+		ValueTable::ValueTable(std::string const& _path, uint32 _slotCount) :
+				m_path(_path), m_fd(-1), m_size(sizeof(ValueTableHeader) + ((size_t) _slotCount * sizeof(ValueTableSlot))), m_header(NULL), m_slots(NULL), m_mutex(new Platform::Mutex())
+		{
+#ifdef OZW_VALUETABLE_SUPPORTED
+			m_fd = open(m_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+			if (m_fd < 0)
+			{
+				Log::Write(LogLevel_Error, "Cannot create value table %s: %s", m_path.c_str(), strerror(errno));
+				return;
+			}
+			if (ftruncate(m_fd, (off_t) m_size) != 0)
+			{
+				Log::Write(LogLevel_Error, "Cannot size value table %s: %s", m_path.c_str(), strerror(errno));
+				return;
+			}
+			void* map = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+			if (map == MAP_FAILED)
+			{
+				Log::Write(LogLevel_Error, "Cannot map value table %s: %s", m_path.c_str(), strerror(errno));
+				return;
+			}
+
+			// The file was truncated, so every slot starts out empty.  The magic number
+			// is written last so readers never see a partly initialised header.
+			m_header = (ValueTableHeader*) map;
+			m_slots = (ValueTableSlot*) (m_header + 1);
+			m_header->m_version = Version;
+			m_header->m_slotCount = _slotCount;
+			m_header->m_slotSize = sizeof(ValueTableSlot);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_header->m_magic = Magic;
+			Log::Write(LogLevel_Info, "Value table %s created with %d slots", m_path.c_str(), _slotCount);
+#else
+			Log::Write(LogLevel_Warning, "ValueTableFile is not supported on this platform");
+#endif
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueTable::~ValueTable>
+// Destructor.  The file is left in place for readers to see the final state.
+//-----------------------------------------------------------------------------
+		ValueTable::~ValueTable()
+		{
+#ifdef OZW_VALUETABLE_SUPPORTED
+			if (m_header)
+			{
+				munmap(m_header, m_size);
+			}
+			if (m_fd >= 0)
+			{
+				close(m_fd);
+			}
+#endif
+			m_mutex->Release();
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueTable::Publish>
+// Write the current state of a value into its slot
+//-----------------------------------------------------------------------------
+		void ValueTable::Publish(VC::Value* _value)
+		{
+			ValueTable* table = s_instance;
+			if (!table)
+			{
+				return;
+			}
+
+			ValueID const& id = _value->GetID();
+			double numeric = 0;
+			_value->GetNumericValue(&numeric);
+			string text = _value->GetAsString();
+
+			LockGuard LG(table->m_mutex);
+			ValueTableSlot* slot = table->FindSlot(id.GetHomeId(), id.GetId(), true);
+			if (!slot)
+			{
+				return;
+			}
+
+			table->BeginWrite(slot);
+			slot->m_flags = _value->IsSet() ? SlotFlag_Set : 0;
+			slot->m_type = (uint8) id.GetType();
+			slot->m_updated = Platform::TimeStamp::Now();
+			slot->m_numeric = numeric;
+			strncpy(slot->m_text, text.c_str(), sizeof(slot->m_text) - 1);
+			slot->m_text[sizeof(slot->m_text) - 1] = 0;
+			table->EndWrite(slot);
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueTable::Remove>
+// Mark the slot of a value as removed
+//-----------------------------------------------------------------------------
+		void ValueTable::Remove(ValueID const& _id)
+		{
+			ValueTable* table = s_instance;
+			if (!table)
+			{
+				return;
+			}
+
+			LockGuard LG(table->m_mutex);
+			ValueTableSlot* slot = table->FindSlot(_id.GetHomeId(), _id.GetId(), false);
+			if (slot)
+			{
+				table->BeginWrite(slot);
+				slot->m_flags = SlotFlag_Removed;
+				slot->m_updated = Platform::TimeStamp::Now();
+				table->EndWrite(slot);
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueTable::ReadSlot>
+// Take a consistent copy of a slot, for readers of the table
+//-----------------------------------------------------------------------------
+		bool ValueTable::ReadSlot(ValueTableSlot const* _slot, ValueTableSlot* _copy)
+		{
+			uint32 before = *((uint32 const volatile*) &_slot->m_sequence);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (before & 1)
+			{
+				return false;
+			}
+			memcpy(_copy, (void const*) _slot, sizeof(ValueTableSlot));
+			std::atomic_thread_fence(std::memory_order_acquire);
+			uint32 after = *((uint32 const volatile*) &_slot->m_sequence);
+			return (before == after);
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueTable::FindSlot>
+// Find the slot of a value, optionally assigning a new one
+//-----------------------------------------------------------------------------
+		ValueTableSlot* ValueTable::FindSlot(uint32 const _homeId, uint64 const _id, bool const _add)
+		{
+			uint32 const count = m_header->m_slotCount;
+			uint32 index = Hash(_homeId, _id, count);
+			for (uint32 i = 0; i < count; ++i)
+			{
+				ValueTableSlot* slot = &m_slots[index];
+				if (slot->m_homeId == 0)
+				{
+					if (!_add)
+					{
+						return NULL;
+					}
+
+					// Claim the empty slot.  The key is written inside the sequence lock
+					// so readers probing past it see either empty or the complete key.
+					BeginWrite(slot);
+					slot->m_id = _id;
+					slot->m_homeId = _homeId;
+					EndWrite(slot);
+					m_header->m_usedSlots++;
+					return slot;
+				}
+				if ((slot->m_homeId == _homeId) && (slot->m_id == _id))
+				{
+					return slot;
+				}
+				if (++index == count)
+				{
+					index = 0;
+				}
+			}
+
+			if (_add)
+			{
+				Log::Write(LogLevel_Warning, "Value table %s is full, increase ValueTableSize", m_path.c_str());
+			}
+			return NULL;
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueTable::BeginWrite>
+// Make the slot's sequence odd before changing it
+//-----------------------------------------------------------------------------
+		void ValueTable::BeginWrite(ValueTableSlot* _slot)
+		{
+			*((uint32 volatile*) &_slot->m_sequence) = _slot->m_sequence + 1;
+			std::atomic_thread_fence(std::memory_order_release);
+		}
+
+//-----------------------------------------------------------------------------
+// <ValueTable::EndWrite>
+// Make the slot's sequence even again and count the change
+//-----------------------------------------------------------------------------
+		void ValueTable::EndWrite(ValueTableSlot* _slot)
+		{
+			uint64 counter = m_header->m_changeCounter + 1;
+			_slot->m_changeCounter = counter;
+			std::atomic_thread_fence(std::memory_order_release);
+			*((uint32 volatile*) &_slot->m_sequence) = _slot->m_sequence + 1;
+			std::atomic_thread_fence(std::memory_order_release);
+			*((uint64 volatile*) &m_header->m_changeCounter) = counter;
+		}
+	} // namespace Internal
+} // namespace OpenZWave
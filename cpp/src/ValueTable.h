@@ -0,0 +1,166 @@
+//-----------------------------------------------------------------------------
+//
+//	ValueTable.h
+//
+//	Shared memory table of current values for out-of-process readers
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _ValueTable_H
+#define _ValueTable_H
+
+#include <string>
+
+#include "Defs.h"
+#include "value_classes/ValueID.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace VC
+		{
+			class Value;
+		}
+		namespace Platform
+		{
+			class Mutex;
+		}
+
+		/** \brief Layout of the header at the start of a value table file.
+		 *
+		 * The file named by the ValueTableFile option is a ValueTableHeader followed by
+		 * m_slotCount ValueTableSlot records.  A slot is found by hashing its Home ID
+		 * and ValueID (see ValueTable::Hash) and probing forward until the key or an
+		 * empty slot (m_homeId == 0) is found.  Slots are never reused, so a reader can
+		 * cache the index of a slot once found.
+		 */
+		struct ValueTableHeader
+		{
+				uint32 m_magic;						/**< ValueTable::Magic */
+				uint32 m_version;					/**< ValueTable::Version */
+				uint32 m_slotCount;					/**< Number of slots following the header */
+				uint32 m_slotSize;					/**< sizeof(ValueTableSlot) */
+				uint64 m_changeCounter;				/**< Incremented after every slot update.  Poll this to detect changes. */
+				uint32 m_usedSlots;					/**< Number of slots that have been assigned to a value */
+				uint32 m_reserved[9];
+		};
+
+		/** \brief Layout of one value in a value table file.
+		 *
+		 * Each slot is protected by a sequence lock.  m_sequence is odd while the slot is
+		 * being written.  To read a slot, load m_sequence (acquire), copy the slot, then
+		 * load m_sequence again; the copy is consistent if both loads returned the same
+		 * even number.  ValueTable::ReadSlot does this.
+		 */
+		struct ValueTableSlot
+		{
+				uint32 m_sequence;					/**< Sequence lock counter */
+				uint32 m_homeId;					/**< Home ID of the value, or zero if the slot is empty */
+				uint64 m_id;						/**< ValueID::GetId() of the value */
+				uint32 m_flags;						/**< ValueTable::SlotFlags */
+				uint8 m_type;						/**< ValueID::ValueType */
+				uint8 m_reserved[3];
+				uint64 m_updated;					/**< TimeStamp::Now() of the last update, in nanoseconds */
+				uint64 m_changeCounter;				/**< m_changeCounter of the header after the last update */
+				double m_numeric;					/**< The value as a number, for numeric and bool types */
+				char m_text[80];					/**< The value as returned by GetAsString, truncated and nul terminated */
+		};
+
+		/** \brief Mirrors the current state of every value into a memory-mapped file.
+		 *
+		 * Processes that only need current values can map the file read-only and poll
+		 * it without system calls or notifications.  Only supported on platforms with mmap.
+		 */
+		class ValueTable
+		{
+			public:
+				enum
+				{
+					Magic = 0x54565a4f,				// "OZVT"
+					Version = 1
+				};
+
+				enum SlotFlags
+				{
+					SlotFlag_Set = 0x01,			/**< The value has been read from the device */
+					SlotFlag_Removed = 0x02			/**< The value no longer exists */
+				};
+
+				/**
+				 * Create the table if the ValueTableFile option is set.
+				 * \return false if the option is set but the file could not be created.
+				 */
+				static bool Create();
+				static void Destroy();
+
+				/**
+				 * Add or refresh the slot of a value.  Does nothing when no table has been created.
+				 */
+				static void Publish(VC::Value* _value);
+
+				/**
+				 * Mark the slot of a value as removed.  Does nothing when no table has been created.
+				 */
+				static void Remove(ValueID const& _id);
+
+				/**
+				 * Hash used to choose the first slot probed for a value.
+				 */
+				static uint32 Hash(uint32 const _homeId, uint64 const _id, uint32 const _slotCount)
+				{
+					uint64 key = (((uint64) _homeId) << 32) ^ _id ^ (_id >> 29);
+					key *= 0x9e3779b97f4a7c15ULL;
+					return (uint32) ((key >> 32) % _slotCount);
+				}
+
+				/**
+				 * Take a consistent copy of a slot.
+				 * \return false if the slot was being written; try again.
+				 */
+				static bool ReadSlot(ValueTableSlot const* _slot, ValueTableSlot* _copy);
+
+			private:
+				ValueTable(std::string const& _path, uint32 _slotCount);
+				~ValueTable();
+
+				bool IsOpen() const
+				{
+					return m_header != NULL;
+				}
+				ValueTableSlot* FindSlot(uint32 const _homeId, uint64 const _id, bool const _add);
+				void BeginWrite(ValueTableSlot* _slot);
+				void EndWrite(ValueTableSlot* _slot);
+
+				static ValueTable* s_instance;
+
+				std::string m_path;
+				int m_fd;
+				size_t m_size;
+				ValueTableHeader* m_header;
+				ValueTableSlot* m_slots;
+				Platform::Mutex* m_mutex;				// Serializes the writers (one per driver thread)
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_ValueTable_H
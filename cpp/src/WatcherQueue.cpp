@@ -0,0 +1,193 @@
+//-----------------------------------------------------------------------------
+//
+//	WatcherQueue.cpp
+//
+//	Queued, asynchronous delivery of notifications to a watcher
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "WatcherQueue.h"
+#include "Notification.h"
+#include "Utils.h"
+#include "platform/Event.h"
+#include "platform/Log.h"
+#include "platform/Mutex.h"
+#include "platform/Thread.h"
+#include "platform/TimeStamp.h"
+#include "platform/Wait.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+
+//-----------------------------------------------------------------------------
+// <WatcherQueue::WatcherQueue>
+// Constructor.  Starts the delivery thread.
+//-----------------------------------------------------------------------------
+		WatcherQueue::WatcherQueue(Manager::pfnOnNotification_t _callback, void* _context, uint32 _maxSize, Manager::WatcherOverflow _overflow) :
+				m_callback(_callback), m_context(_context), m_maxSize(_maxSize ? _maxSize : 1), m_overflow(_overflow), m_mutex(new Platform::Mutex()), m_queueEvent(new Platform::Event()), m_stopEvent(new Platform::Event()), m_thread(new Platform::Thread("watcher")), m_finished(false)
+		{
+			memset(&m_stats, 0, sizeof(m_stats));
+			m_thread->Start(WatcherQueue::WatcherThreadEntryPoint, this);
+		}
+
+//-----------------------------------------------------------------------------
+// <WatcherQueue::~WatcherQueue>
+// Destructor
+//-----------------------------------------------------------------------------
+		WatcherQueue::~WatcherQueue()
+		{
+			m_stopEvent->Set();
+			m_thread->Stop();
+			m_thread->Release();
+
+			while (!m_queue.empty())
+			{
+				delete m_queue.front().m_notification;
+				m_queue.pop_front();
+			}
+
+			m_stopEvent->Release();
+			m_queueEvent->Release();
+			m_mutex->Release();
+		}
+
+//-----------------------------------------------------------------------------
+// <WatcherQueue::Push>
+// Queue a notification for the delivery thread
+//-----------------------------------------------------------------------------
+		void WatcherQueue::Push(Notification* _notification)
+		{
+			LockGuard LG(m_mutex);
+			if (m_queue.size() >= m_maxSize)
+			{
+				m_stats.m_dropped++;
+				if (m_overflow == Manager::WatcherOverflow_DropNewest)
+				{
+					delete _notification;
+					return;
+				}
+				delete m_queue.front().m_notification;
+				m_queue.pop_front();
+			}
+
+			Item item;
+			item.m_notification = _notification;
+			item.m_queuedAt = Platform::TimeStamp::Now();
+			m_queue.push_back(item);
+
+			m_stats.m_queued = (uint32) m_queue.size();
+			if (m_stats.m_queued > m_stats.m_maxQueued)
+			{
+				m_stats.m_maxQueued = m_stats.m_queued;
+			}
+			m_queueEvent->Set();
+		}
+
+//-----------------------------------------------------------------------------
+// <WatcherQueue::Stop>
+// Ask the delivery thread to exit
+//-----------------------------------------------------------------------------
+		void WatcherQueue::Stop()
+		{
+			m_stopEvent->Set();
+		}
+
+//-----------------------------------------------------------------------------
+// <WatcherQueue::IsFinished>
+// Test whether the delivery thread has exited
+//-----------------------------------------------------------------------------
+		bool WatcherQueue::IsFinished()
+		{
+			LockGuard LG(m_mutex);
+			return m_finished;
+		}
+
+//-----------------------------------------------------------------------------
+// <WatcherQueue::GetStatistics>
+// Copy the delivery statistics
+//-----------------------------------------------------------------------------
+		void WatcherQueue::GetStatistics(Manager::WatcherStatistics* _data)
+		{
+			LockGuard LG(m_mutex);
+			*_data = m_stats;
+		}
+
+//-----------------------------------------------------------------------------
+// <WatcherQueue::WatcherThreadEntryPoint>
+// Entry point of the delivery thread
+//-----------------------------------------------------------------------------
+		void WatcherQueue::WatcherThreadEntryPoint(Platform::Event* _exitEvent, void* _context)
+		{
+			WatcherQueue* queue = (WatcherQueue*) _context;
+			if (queue)
+			{
+				queue->WatcherThreadProc(_exitEvent);
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <WatcherQueue::WatcherThreadProc>
+// Deliver queued notifications to the watcher until asked to stop
+//-----------------------------------------------------------------------------
+		void WatcherQueue::WatcherThreadProc(Platform::Event* _exitEvent)
+		{
+			Platform::WaitSet waitObjects;
+			waitObjects.Add(_exitEvent);			// Thread must exit.
+			waitObjects.Add(m_stopEvent);			// Watcher has been removed.
+			waitObjects.Add(m_queueEvent);			// Notifications waiting to be delivered.
+
+			while (waitObjects.Multiple(waitObjects.GetCount()) == 2)
+			{
+				Item item;
+				{
+					LockGuard LG(m_mutex);
+					if (m_queue.empty())
+					{
+						m_queueEvent->Reset();
+						continue;
+					}
+					item = m_queue.front();
+					m_queue.pop_front();
+					m_stats.m_queued = (uint32) m_queue.size();
+
+					uint32 lag = (uint32) ((Platform::TimeStamp::Now() - item.m_queuedAt) / 1000000);
+					m_stats.m_lastLag = lag;
+					if (lag > m_stats.m_maxLag)
+					{
+						m_stats.m_maxLag = lag;
+					}
+					m_stats.m_delivered++;
+				}
+
+				m_callback(item.m_notification, m_context);
+				delete item.m_notification;
+			}
+
+			LockGuard LG(m_mutex);
+			m_finished = true;
+		}
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,120 @@
+//-----------------------------------------------------------------------------
+//
+//	WatcherQueue.h
+//
+//	Queued, asynchronous delivery of notifications to a watcher
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _WatcherQueue_H
+#define _WatcherQueue_H
+
+#include <deque>
+
+#include "Defs.h"
+#include "Manager.h"
+
+namespace OpenZWave
+{
+	class Notification;
+
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class Event;
+			class Mutex;
+			class Thread;
+		}
+
+		/** \brief Delivers notifications to one watcher on its own thread.
+		 *
+		 * The driver thread pushes copies of notifications into a bounded queue and
+		 * returns immediately.  A delivery thread owned by the queue calls the
+		 * watcher, so a slow watcher only delays its own notifications.
+		 */
+		class WatcherQueue
+		{
+			public:
+				WatcherQueue(Manager::pfnOnNotification_t _callback, void* _context, uint32 _maxSize, Manager::WatcherOverflow _overflow);
+
+				/**
+				 * Destructor.  Stops the delivery thread and discards any queued notifications.
+				 * Must not be called from the delivery thread.
+				 */
+				~WatcherQueue();
+
+				/**
+				 * Queue a notification for delivery.  The queue takes ownership of it.
+				 * If the queue is full, one notification is discarded according to the overflow setting.
+				 */
+				void Push(Notification* _notification);
+
+				/**
+				 * Ask the delivery thread to exit without waiting for it.  Safe to call from the
+				 * delivery thread itself, for example when a watcher removes itself.
+				 * \see IsFinished
+				 */
+				void Stop();
+
+				/**
+				 * Test whether the delivery thread has exited after a call to Stop, so the queue
+				 * can be deleted without waiting.
+				 */
+				bool IsFinished();
+
+				/**
+				 * Copy the queue's delivery statistics.
+				 */
+				void GetStatistics(Manager::WatcherStatistics* _data);
+
+			private:
+				WatcherQueue(WatcherQueue const&);					// prevent copy
+				WatcherQueue& operator =(WatcherQueue const&);		// prevent assignment
+
+				static void WatcherThreadEntryPoint(Platform::Event* _exitEvent, void* _context);
+				void WatcherThreadProc(Platform::Event* _exitEvent);
+
+				struct Item
+				{
+						Notification* m_notification;
+						uint64 m_queuedAt;								// TimeStamp::Now() when the item was queued
+				};
+
+				Manager::pfnOnNotification_t m_callback;
+				void* m_context;
+				uint32 m_maxSize;
+				Manager::WatcherOverflow m_overflow;
+
+				std::deque<Item> m_queue;
+				Platform::Mutex* m_mutex;							// Serialize access to the queue and statistics
+				Platform::Event* m_queueEvent;						// Signalled when the queue is not empty
+				Platform::Event* m_stopEvent;						// Signalled by Stop
+				Platform::Thread* m_thread;
+				bool m_finished;
+
+				Manager::WatcherStatistics m_stats;
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_WatcherQueue_H
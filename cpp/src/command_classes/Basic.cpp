@@ -159,7 +159,7 @@ namespace OpenZWave
 						{
 							/* Set the Target Value, if it is present */
 							if (_length == 4)
-								value->SetTargetValue(_data[2], _data[3]);
+								value->SetTargetValue(_data[2], decodeDuration(_data[3]));
 							value->OnValueRefreshed(_data[1]);
 							value->Release();
 						}
@@ -27,6 +27,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 #include "command_classes/CommandClasses.h"
 #include "command_classes/Color.h"
@@ -363,7 +364,7 @@ namespace OpenZWave
 					{
 						Log::Write(LogLevel_Info, GetNodeId(), "Received a updated Color from Device: %s", colorStr.c_str());
 						if (GetVersion() >= 3)
-							color->SetTargetValue(decodeColor(m_colorTargetValues), _data[4]);
+							color->SetTargetValue(decodeColor(m_colorTargetValues), decodeDuration(_data[4]));
 						color->OnValueRefreshed(colorStr);
 						color->Release();
 					}
@@ -530,17 +531,17 @@ namespace OpenZWave
 				ss << "#";
 				/* do R */
 				if ((f_capabilities) & (1 << (COLORIDX_RED)))
-					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) m_colorvalues[COLORIDX_RED];
+					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) valueArray[COLORIDX_RED];
 				else
 					ss << "00";
 				/* do G */
 				if ((f_capabilities) & (1 << (COLORIDX_GREEN)))
-					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) m_colorvalues[COLORIDX_GREEN];
+					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) valueArray[COLORIDX_GREEN];
 				else
 					ss << "00";
 				/* do B */
 				if ((f_capabilities) & (1 << (COLORIDX_BLUE)))
-					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) m_colorvalues[COLORIDX_BLUE];
+					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) valueArray[COLORIDX_BLUE];
 				else
 					ss << "00";
 
@@ -548,18 +549,18 @@ namespace OpenZWave
 				if (((f_capabilities) & (1 << (COLORIDX_WARMWHITE))) && ((f_capabilities) & (1 << (COLORIDX_COLDWHITE))))
 				{
 					/* append them both */
-					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) m_colorvalues[COLORIDX_WARMWHITE];
-					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) m_colorvalues[COLORIDX_COLDWHITE];
+					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) valueArray[COLORIDX_WARMWHITE];
+					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) valueArray[COLORIDX_COLDWHITE];
 				}
 				else if ((f_capabilities) & (1 << (COLORIDX_WARMWHITE)))
 				{
 					/* else, if the warm white is present, append that */
-					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) m_colorvalues[COLORIDX_WARMWHITE];
+					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) valueArray[COLORIDX_WARMWHITE];
 				}
 				else if ((f_capabilities) & (1 << (COLORIDX_COLDWHITE)))
 				{
 					/* else, if the cold white is present, append that */
-					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) m_colorvalues[COLORIDX_COLDWHITE];
+					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) valueArray[COLORIDX_COLDWHITE];
 				}
 				else
 				{
@@ -578,7 +579,7 @@ namespace OpenZWave
 						usingbuf = false;
 					}
 					/* and then our Color */
-					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) m_colorvalues[COLORIDX_AMBER];
+					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) valueArray[COLORIDX_AMBER];
 				}
 				else
 				{
@@ -597,7 +598,7 @@ namespace OpenZWave
 						usingbuf = false;
 					}
 					/* and then our Color */
-					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) m_colorvalues[COLORIDX_CYAN];
+					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) valueArray[COLORIDX_CYAN];
 				}
 				else
 				{
@@ -616,7 +617,7 @@ namespace OpenZWave
 						usingbuf = false;
 					}
 					/* and then our Color */
-					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) m_colorvalues[COLORIDX_PURPLE];
+					ss << std::setw(2) << std::uppercase << std::hex << std::setfill('0') << (int) valueArray[COLORIDX_PURPLE];
 				}
 				/* No need for a else case here as COLORIDX_PURPLE is the last color. If its not supported, we
 				* don't put anything in our Color String
@@ -753,6 +754,19 @@ namespace OpenZWave
 							duration = valduration->GetValue();
 						}
 						msg->Append(encodeDuration(duration));
+
+						// Track the fade, so a refresh that finds the bulb part way there waits
+						// for the end of it rather than reporting a stale color
+						if ((duration > 0) && (duration <= 7620))
+						{
+							if (Internal::VC::ValueString* color = static_cast<Internal::VC::ValueString*>(GetValue(_value.GetID().GetInstance(), ValueID_Index_Color::Color)))
+							{
+								string target = s;
+								std::transform(target.begin(), target.end(), target.begin(), ::toupper);
+								color->SetTargetValue(target, duration);
+								color->Release();
+							}
+						}
 					}
 					msg->Append(GetDriver()->GetTransmitOptions());
 					GetDriver()->SendMsg(msg, Driver::MsgQueue_Send);
@@ -69,6 +69,9 @@ namespace OpenZWave
 				m_com.EnableFlag(COMPAT_FLAG_REFRESHONWAKEUP, false);
 				m_com.EnableFlag(COMPAT_FLAG_VERIFYCHANGED, false);
 				m_com.EnableFlag(COMPAT_FLAG_NO_REFRESH_AFTER_SET, false);
+				m_com.EnableFlag(COMPAT_FLAG_NOTIFY_DEADBAND, 0);
+				m_com.EnableFlag(COMPAT_FLAG_NOTIFY_MININTERVAL, 0);
+				m_com.EnableFlag(COMPAT_FLAG_NOTIFY_TRAILINGEDGE, false);
 				m_dom.EnableFlag(STATE_FLAG_CCVERSION, 0);
 				m_dom.EnableFlag(STATE_FLAG_STATIC_REQUESTS, 0);
 				m_dom.EnableFlag(STATE_FLAG_AFTERMARK, false);
@@ -472,9 +475,25 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			std::string CommandClass::ExtractValue(uint8 const* _data, uint8* _scale, uint8* _precision, uint8 _valueOffset // = 1
 					) const
+			{
+				uint8 precision;
+				int32 value = ExtractNumericValue(_data, _scale, &precision, _valueOffset);
+				if (_precision)
+				{
+					*_precision = precision;
+				}
+				return FormatValue(value, precision);
+			}
+
+//-----------------------------------------------------------------------------
+// <CommandClass::ExtractNumericValue>
+// Read a value from a variable length sequence of bytes, without converting
+// it to a string.  The result is the value multiplied by 10^precision.
+//-----------------------------------------------------------------------------
+			int32 CommandClass::ExtractNumericValue(uint8 const* _data, uint8* _scale, uint8* _precision, uint8 _valueOffset // = 1
+					) const
 			{
 				uint8 const size = _data[0] & c_sizeMask;
-				uint8 const precision = (_data[0] & c_precisionMask) >> c_precisionShift;
 
 				if (_scale)
 				{
@@ -483,83 +502,49 @@ namespace OpenZWave
 
 				if (_precision)
 				{
-					*_precision = precision;
+					*_precision = (_data[0] & c_precisionMask) >> c_precisionShift;
 				}
 
 				uint32 value = 0;
-				uint8 i;
-				for (i = 0; i < size; ++i)
+				for (uint8 i = 0; i < size; ++i)
 				{
 					value <<= 8;
 					value |= (uint32) _data[i + (uint32) _valueOffset];
 				}
 
-				// Deal with sign extension.  All values are signed
-				std::string res;
-				if (_data[_valueOffset] & 0x80)
+				// All values are signed, so extend the sign of shorter values
+				if (size && (size < 4) && (_data[_valueOffset] & 0x80))
 				{
-					res = "-";
-
-					// MSB is signed
-					if (size == 1)
-					{
-						value |= 0xffffff00;
-					}
-					else if (size == 2)
-					{
-						value |= 0xffff0000;
-					}
+					value |= 0xffffffff << (8 * size);
 				}
+				return (int32) value;
+			}
 
-				// Convert the integer to a decimal string.  We avoid
-				// using floats to prevent accuracy issues.
-				char numBuf[12] =
-				{ 0 };
-
-				if (precision == 0)
+//-----------------------------------------------------------------------------
+// <CommandClass::FormatValue>
+// Convert a value read by ExtractNumericValue to a decimal string.  We avoid
+// using floats to prevent accuracy issues.
+//-----------------------------------------------------------------------------
+			std::string CommandClass::FormatValue(int32 const _value, uint8 const _precision)
+			{
+				char numBuf[32];
+				if (_precision == 0)
 				{
-					// The precision is zero, so we can just print the number directly into the string.
-					snprintf(numBuf, 12, "%d", (signed int) value);
-					res = numBuf;
+					snprintf(numBuf, sizeof(numBuf), "%d", _value);
+					return numBuf;
 				}
-				else
-				{
-					// We'll need to insert a decimal point and include any necessary leading zeros.
 
-					// Fill the buffer with the value padded with leading zeros.
-					snprintf(numBuf, 12, "%011d", (signed int) value);
-
-					// Calculate the position of the decimal point in the buffer
-					int32 decimal = 10 - precision;
-
-					// Shift the characters to make space for the decimal point.
-					// We don't worry about overwriting any minus sign since that is
-					// already written into the res string. While we're shifting, we
-					// also look for the real starting position of the number so we
-					// can copy it into the res string later.
-					int32 start = -1;
-					for (int32 i = 0; i < decimal; ++i)
-					{
-						numBuf[i] = numBuf[i + 1];
-						if ((start < 0) && (numBuf[i] != '0'))
-						{
-							start = i;
-						}
-					}
-					if (start < 0)
-					{
-						start = decimal - 1;
-					}
-
-					// Insert the decimal point
-					struct lconv const* locale = localeconv();
-					numBuf[decimal] = *(locale->decimal_point);
-
-					// Copy the buffer into res
-					res += &numBuf[start];
+				// Split the magnitude at the decimal point, keeping the leading zeros of the fraction
+				uint32 magnitude = (_value < 0) ? (uint32) (-(int64) _value) : (uint32) _value;
+				int precision = _precision & 0x07;			// The precision field is three bits
+				uint32 divisor = 1;
+				for (int i = 0; i < precision; ++i)
+				{
+					divisor *= 10;
 				}
-
-				return res;
+				struct lconv const* locale = localeconv();
+				snprintf(numBuf, sizeof(numBuf), "%s%u%c%0*u", (_value < 0) ? "-" : "", magnitude / divisor, *(locale->decimal_point), precision, magnitude % divisor);
+				return numBuf;
 			}
 
 //-----------------------------------------------------------------------------
@@ -740,6 +725,44 @@ namespace OpenZWave
 				m_dom.SetFlagByte(STATE_FLAG_STATIC_REQUESTS, f_staticRequests);
 			}
 
+//-----------------------------------------------------------------------------
+// <CommandClass::RecordProductReport>
+// Keep a capability report for the product cache
+//-----------------------------------------------------------------------------
+			void CommandClass::RecordProductReport(uint8 const* _data, uint32 const _length, uint32 const _instance)
+			{
+				if (Node* node = GetNodeUnsafe())
+				{
+					node->RecordProductReport(GetCommandClassId(), _data, _length, _instance);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <CommandClass::ReplayProductReports>
+// Handle the reports cached for this product instead of asking the device
+//-----------------------------------------------------------------------------
+			bool CommandClass::ReplayProductReports(uint8 const _instance)
+			{
+				if (Node* node = GetNodeUnsafe())
+				{
+					return node->ReplayProductReports(GetCommandClassId(), _instance);
+				}
+				return false;
+			}
+
+//-----------------------------------------------------------------------------
+// <CommandClass::IsReplayingProductReports>
+// Whether a cached report is being handled
+//-----------------------------------------------------------------------------
+			bool CommandClass::IsReplayingProductReports()
+			{
+				if (Node* node = GetNodeUnsafe())
+				{
+					return node->IsReplayingProductReports();
+				}
+				return false;
+			}
+
 //-----------------------------------------------------------------------------
 // <CommandClass::RequestStateForAllInstances>
 // Request current state from the device
@@ -32,6 +32,7 @@
 #include <vector>
 #include <map>
 #include "Defs.h"
+#include "MemoryAccounting.h"
 #include "Bitfield.h"
 #include "Driver.h"
 #include "CompatOptionManager.h"
@@ -70,6 +71,14 @@ namespace OpenZWave
 					};
 
 					CommandClass(uint32 const _homeId, uint8 const _nodeId);
+					static void* operator new(size_t _size)
+					{
+						return Internal::MemoryAccounting::Allocate(_size, Internal::MemoryAccounting::Category_CommandClass);
+					}
+					static void operator delete(void* _ptr)
+					{
+						Internal::MemoryAccounting::Free(_ptr);
+					}
 					virtual ~CommandClass();
 
 					virtual void ReadXML(TiXmlElement const* _ccElement);
@@ -90,6 +99,9 @@ namespace OpenZWave
 					void SetCommandClassLabel(string label);
 					virtual bool HandleMsg(uint8 const* _data, uint32 const _length, uint32 const _instance = 1) = 0;
 					virtual bool HandleIncomingMsg(uint8 const* _data, uint32 const _length, uint32 const _instance = 1);
+					virtual void RequestDropped(uint8 const* _data, uint32 const _length)
+					{
+					}		// A Get sent by this class got no reply and was dropped.  _data starts at the command, as in HandleMsg.
 					virtual bool SetValue(Internal::VC::Value const& _value)
 					{
 						return false;
@@ -203,6 +215,8 @@ namespace OpenZWave
 
 					// Helper methods
 					string ExtractValue(uint8 const* _data, uint8* _scale, uint8* _precision, uint8 _valueOffset = 1) const;
+					int32 ExtractNumericValue(uint8 const* _data, uint8* _scale, uint8* _precision, uint8 _valueOffset = 1) const;
+					static string FormatValue(int32 const _value, uint8 const _precision);
 					uint32 decodeDuration(uint8 data) const;
 					uint8 encodeDuration(uint32 seconds) const;
 					/**
@@ -261,6 +275,30 @@ namespace OpenZWave
 					void SetStaticRequest(uint8_t _request);
 					void ClearStaticRequest(uint8_t _request);
 
+					//-----------------------------------------------------------------------------
+					// Interview results shared between nodes of the same product
+					//-----------------------------------------------------------------------------
+				protected:
+					/**
+					 * Keep a report that describes the capabilities of the device, for the
+					 * product cache.  Called from HandleMsg with its own arguments.
+					 */
+					void RecordProductReport(uint8 const* _data, uint32 const _length, uint32 const _instance);
+
+					/**
+					 * Pass the reports cached for this product to HandleMsg instead of
+					 * asking the device.
+					 * \return true if any report was replayed.
+					 */
+					bool ReplayProductReports(uint8 const _instance);
+
+					/**
+					 * \return true while a cached report is being handled.  Gets that
+					 * follow from a report are not sent then, as their own reports are
+					 * replayed too.
+					 */
+					bool IsReplayingProductReports();
+
 					//-----------------------------------------------------------------------------
 					//	Statistics
 					//-----------------------------------------------------------------------------
@@ -25,13 +25,18 @@
 //
 //-----------------------------------------------------------------------------
 
+#include <algorithm>
 #include "command_classes/CommandClasses.h"
 #include "command_classes/Configuration.h"
+#include "command_classes/Version.h"
 #include "Defs.h"
 #include "Msg.h"
 #include "Driver.h"
 #include "Node.h"
+#include "ProductCache.h"
+#include "Utils.h"
 #include "platform/Log.h"
+#include "platform/Mutex.h"
 #include "value_classes/ValueBitSet.h"
 #include "value_classes/ValueBool.h"
 #include "value_classes/ValueButton.h"
@@ -39,6 +44,7 @@
 #include "value_classes/ValueInt.h"
 #include "value_classes/ValueList.h"
 #include "value_classes/ValueShort.h"
+#include "value_classes/ValueStore.h"
 
 namespace OpenZWave
 {
@@ -51,9 +57,126 @@ namespace OpenZWave
 			{
 				ConfigurationCmd_Set = 0x04,
 				ConfigurationCmd_Get = 0x05,
-				ConfigurationCmd_Report = 0x06
+				ConfigurationCmd_Report = 0x06,
+				ConfigurationCmd_BulkSet = 0x07,
+				ConfigurationCmd_BulkGet = 0x08,
+				ConfigurationCmd_BulkReport = 0x09,
+				ConfigurationCmd_NameGet = 0x0A,
+				ConfigurationCmd_NameReport = 0x0B,
+				ConfigurationCmd_InfoGet = 0x0C,
+				ConfigurationCmd_InfoReport = 0x0D,
+				ConfigurationCmd_PropertiesGet = 0x0E,
+				ConfigurationCmd_PropertiesReport = 0x0F
 			};
 
+			enum ConfigurationFormat
+			{
+				ConfigurationFormat_Signed = 0x00,
+				ConfigurationFormat_Unsigned = 0x01,
+				ConfigurationFormat_Enumerated = 0x02,
+				ConfigurationFormat_BitField = 0x03
+			};
+
+			enum
+			{
+				MaxBulkSetBytes = 24			// Parameter bytes in one Bulk Set, small enough to still fit once encrypted
+			};
+
+			std::map<string, vector<Configuration::ParameterInfo> > Configuration::s_products;
+			Internal::Platform::Mutex* Configuration::s_productsMutex = new Internal::Platform::Mutex();
+
+//-----------------------------------------------------------------------------
+// <ReadParameterValue>
+// Decode a big endian parameter value of 1, 2 or 4 bytes
+//-----------------------------------------------------------------------------
+			static int32 ReadParameterValue(uint8 const* _data, uint8 const _size, bool const _signed)
+			{
+				uint32 value = 0;
+				for (uint8 i = 0; i < _size; ++i)
+				{
+					value = (value << 8) | _data[i];
+				}
+				if (_signed && _size < 4 && (_data[0] & 0x80))
+				{
+					value |= ~((1u << (_size * 8)) - 1);
+				}
+				return (int32) value;
+			}
+
+//-----------------------------------------------------------------------------
+// <AppendParameterValue>
+// Encode a parameter value of 1, 2 or 4 bytes, big endian
+//-----------------------------------------------------------------------------
+			static void AppendParameterValue(Msg* _msg, int32 const _value, uint8 const _size)
+			{
+				if (_size > 2)
+				{
+					_msg->Append((uint8) ((_value >> 24) & 0xff));
+					_msg->Append((uint8) ((_value >> 16) & 0xff));
+				}
+				if (_size > 1)
+				{
+					_msg->Append((uint8) ((_value >> 8) & 0xff));
+				}
+				_msg->Append((uint8) (_value & 0xff));
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::Configuration>
+// Constructor
+//-----------------------------------------------------------------------------
+			Configuration::Configuration(uint32 const _homeId, uint8 const _nodeId) :
+					CommandClass(_homeId, _nodeId), m_textIndex(0)
+			{
+				m_dom.EnableFlag(STATE_FLAG_CONFIG_NOBULK, false);
+				SetStaticRequest(StaticRequest_Values);
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::RequestState>
+// Discover the parameters of devices that can describe them
+//-----------------------------------------------------------------------------
+			bool Configuration::RequestState(uint32 const _requestFlags, uint8 const _instance, Driver::MsgQueue const _queue)
+			{
+				if ((_requestFlags & RequestFlag_Static) && HasStaticRequest(StaticRequest_Values) && _instance == 1)
+				{
+					if (GetVersion() < 3 || HasParameters())
+					{
+						// The device XML or the cache already describes the parameters
+						ClearStaticRequest(StaticRequest_Values);
+						return false;
+					}
+
+					vector<ParameterInfo> known;
+					string const key = GetProductKey();
+					if (!key.empty())
+					{
+						LockGuard LG(s_productsMutex);
+						std::map<string, vector<ParameterInfo> >::const_iterator it = s_products.find(key);
+						if (it != s_products.end())
+						{
+							known = it->second;
+						}
+					}
+					if (!known.empty())
+					{
+						Log::Write(LogLevel_Info, GetNodeId(), "Using the %d configuration parameters discovered on another device of this product", (uint32) known.size());
+						for (size_t i = 0; i < known.size(); ++i)
+						{
+							CreateParameter(known[i]);
+						}
+						ClearStaticRequest(StaticRequest_Values);
+						return RequestAllParameters(_requestFlags, _queue);
+					}
+
+					// Properties Get for parameter 0 returns the number of the first parameter
+					m_discovered.clear();
+					m_textIndex = 0;
+					return RequestProperties(0);
+				}
+				return false;
+			}
+
 //-----------------------------------------------------------------------------
 // <Configuration::HandleMsg>
 // Handle a message from the Z-Wave network
@@ -66,98 +189,270 @@ namespace OpenZWave
 					// Extract the parameter index and value
 					uint8 parameter = _data[1];
 					uint8 size = _data[2] & 0x07;
-					int32 paramValue = 0;
-					for (uint8 i = 0; i < size; ++i)
+					UpdateParameter(_instance, parameter, size, ReadParameterValue(&_data[3], size, false));
+					return true;
+				}
+				else if (ConfigurationCmd_BulkReport == (ConfigurationCmd) _data[0])
+				{
+					// First parameter, number of parameters, reports to follow, size, then the values
+					uint16 const first = (((uint16) _data[1]) << 8) | _data[2];
+					uint8 const count = _data[3];
+					uint8 const size = _data[5] & 0x07;
+					uint32 pos = 6;
+					Log::Write(LogLevel_Info, GetNodeId(), "Received Configuration bulk report: Parameters %d to %d", first, first + count - 1);
+					for (uint8 i = 0; i < count && size && pos + size <= _length - 1; ++i)
+					{
+						UpdateParameter(_instance, first + i, size, ReadParameterValue(&_data[pos], size, false));
+						pos += size;
+					}
+					return true;
+				}
+				else if (ConfigurationCmd_PropertiesReport == (ConfigurationCmd) _data[0])
+				{
+					// Parameter, format and size, minimum, maximum and default values, then the next parameter
+					uint16 const parameter = (((uint16) _data[1]) << 8) | _data[2];
+					uint8 const size = _data[3] & 0x07;
+					uint8 const format = (_data[3] >> 3) & 0x07;
+					uint32 const pos = 4 + 3 * size;
+					uint16 next = 0;
+					if (pos + 2 <= _length - 1)
+					{
+						next = (((uint16) _data[pos]) << 8) | _data[pos + 1];
+						if (parameter != 0 && (size == 1 || size == 2 || size == 4))
+						{
+							bool const isSigned = (format == ConfigurationFormat_Signed);
+							ParameterInfo info;
+							info.m_parameter = parameter;
+							info.m_size = size;
+							info.m_format = format;
+							info.m_readOnly = GetVersion() >= 4 && (_data[3] & 0x40);
+							info.m_min = ReadParameterValue(&_data[4], size, isSigned);
+							info.m_max = ReadParameterValue(&_data[4 + size], size, isSigned);
+							info.m_default = ReadParameterValue(&_data[4 + 2 * size], size, isSigned);
+							Log::Write(LogLevel_Info, GetNodeId(), "Received Configuration properties report: Parameter=%d, Size=%d, Format=%d, Range=%d to %d, Default=%d", parameter, size, format, info.m_min, info.m_max, info.m_default);
+							m_discovered.push_back(info);
+							CreateParameter(info);
+						}
+						if (GetVersion() >= 4 && pos + 2 < _length - 1 && (_data[pos + 2] & 0x02))
+						{
+							Log::Write(LogLevel_Info, GetNodeId(), "Configuration parameter %d can not be read with the Bulk commands", parameter);
+							m_dom.SetFlagBool(STATE_FLAG_CONFIG_NOBULK, true);
+						}
+					}
+					else
+					{
+						Log::Write(LogLevel_Warning, GetNodeId(), "Configuration properties report for parameter %d is truncated", parameter);
+					}
+
+					if (next > parameter)
+					{
+						RequestProperties(next);
+					}
+					else
+					{
+						PropertiesDone();
+					}
+					return true;
+				}
+				else if ((ConfigurationCmd_NameReport == (ConfigurationCmd) _data[0]) || (ConfigurationCmd_InfoReport == (ConfigurationCmd) _data[0]))
+				{
+					// Parameter, reports to follow, then UTF-8 text that may continue in the following reports
+					uint16 const parameter = (((uint16) _data[1]) << 8) | _data[2];
+					uint8 const toFollow = _data[3];
+					bool const isName = (ConfigurationCmd_NameReport == (ConfigurationCmd) _data[0]);
+					if (m_textIndex >= m_discovered.size() || m_discovered[m_textIndex].m_parameter != parameter)
+					{
+						return true;
+					}
+
+					ParameterInfo& info = m_discovered[m_textIndex];
+					string& text = isName ? info.m_name : info.m_info;
+					if (_length > 5)
+					{
+						text.append((char const*) &_data[4], _length - 5);
+					}
+					if (toFollow)
 					{
-						paramValue <<= 8;
-						paramValue |= (int32) _data[i + 3];
+						return true;
 					}
 
+					Log::Write(LogLevel_Info, GetNodeId(), "Received Configuration %s report: Parameter=%d, %s", isName ? "name" : "info", parameter, text.c_str());
 					if (Internal::VC::Value* value = GetValue(1, parameter))
 					{
-						switch (value->GetID().GetType())
+						if (!text.empty())
 						{
-							case ValueID::ValueType_BitSet:
+							if (isName)
 							{
-								Internal::VC::ValueBitSet* vbs = static_cast<Internal::VC::ValueBitSet*>(value);
-								vbs->OnValueRefreshed(paramValue);
-								break;
-							}
-							case ValueID::ValueType_Bool:
-							{
-								Internal::VC::ValueBool* valueBool = static_cast<Internal::VC::ValueBool*>(value);
-								valueBool->OnValueRefreshed(paramValue != 0);
-								break;
+								value->SetLabel(text);
 							}
-							case ValueID::ValueType_Byte:
+							else
 							{
-								Internal::VC::ValueByte* valueByte = static_cast<Internal::VC::ValueByte*>(value);
-								valueByte->OnValueRefreshed((uint8) paramValue);
-								break;
+								value->SetHelp(text);
 							}
-							case ValueID::ValueType_Short:
+						}
+						value->Release();
+					}
+
+					TextDone(isName);
+					return true;
+				}
+
+				return false;
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::RequestDropped>
+// Carry on with the discovery if one of its Gets got no reply
+//-----------------------------------------------------------------------------
+			void Configuration::RequestDropped(uint8 const* _data, uint32 const _length)
+			{
+				if (!HasStaticRequest(StaticRequest_Values) || _length < 3)
+				{
+					return;
+				}
+
+				uint16 const parameter = (((uint16) _data[1]) << 8) | _data[2];
+				if (ConfigurationCmd_PropertiesGet == (ConfigurationCmd) _data[0])
+				{
+					// The next parameter is only known from the report, so stop with those found so far
+					Log::Write(LogLevel_Warning, GetNodeId(), "No Configuration properties report for parameter %d, ending the discovery", parameter);
+					PropertiesDone();
+				}
+				else if ((ConfigurationCmd_NameGet == (ConfigurationCmd) _data[0]) || (ConfigurationCmd_InfoGet == (ConfigurationCmd) _data[0]))
+				{
+					if (m_textIndex < m_discovered.size() && m_discovered[m_textIndex].m_parameter == parameter)
+					{
+						Log::Write(LogLevel_Warning, GetNodeId(), "No Configuration %s report for parameter %d", (ConfigurationCmd_NameGet == (ConfigurationCmd) _data[0]) ? "name" : "info", parameter);
+						TextDone(ConfigurationCmd_NameGet == (ConfigurationCmd) _data[0]);
+					}
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::PropertiesDone>
+// Every parameter is known, now ask for their names and help text
+//-----------------------------------------------------------------------------
+			void Configuration::PropertiesDone()
+			{
+				if (m_discovered.empty())
+				{
+					DiscoveryDone();
+					return;
+				}
+				m_textIndex = 0;
+				m_discovered[0].m_name.clear();
+				RequestText(ConfigurationCmd_NameGet, m_discovered[0].m_parameter);
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::TextDone>
+// The name or help text of the current parameter is complete, ask for the next
+//-----------------------------------------------------------------------------
+			void Configuration::TextDone(bool const _isName)
+			{
+				if (_isName)
+				{
+					m_discovered[m_textIndex].m_info.clear();
+					RequestText(ConfigurationCmd_InfoGet, m_discovered[m_textIndex].m_parameter);
+				}
+				else if (++m_textIndex < m_discovered.size())
+				{
+					m_discovered[m_textIndex].m_name.clear();
+					RequestText(ConfigurationCmd_NameGet, m_discovered[m_textIndex].m_parameter);
+				}
+				else
+				{
+					DiscoveryDone();
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::UpdateParameter>
+// Store a reported parameter value, creating its value if it is not known yet
+//-----------------------------------------------------------------------------
+			void Configuration::UpdateParameter(uint8 const _instance, uint16 const _parameter, uint8 const _size, int32 const _value)
+			{
+				if (Internal::VC::Value* value = GetValue(1, _parameter))
+				{
+					switch (value->GetID().GetType())
+					{
+						case ValueID::ValueType_BitSet:
+						{
+							Internal::VC::ValueBitSet* vbs = static_cast<Internal::VC::ValueBitSet*>(value);
+							vbs->OnValueRefreshed(_value);
+							break;
+						}
+						case ValueID::ValueType_Bool:
+						{
+							Internal::VC::ValueBool* valueBool = static_cast<Internal::VC::ValueBool*>(value);
+							valueBool->OnValueRefreshed(_value != 0);
+							break;
+						}
+						case ValueID::ValueType_Byte:
+						{
+							Internal::VC::ValueByte* valueByte = static_cast<Internal::VC::ValueByte*>(value);
+							valueByte->OnValueRefreshed((uint8) _value);
+							break;
+						}
+						case ValueID::ValueType_Short:
+						{
+							Internal::VC::ValueShort* valueShort = static_cast<Internal::VC::ValueShort*>(value);
+							valueShort->OnValueRefreshed((int16) _value);
+							break;
+						}
+						case ValueID::ValueType_Int:
+						{
+							Internal::VC::ValueInt* valueInt = static_cast<Internal::VC::ValueInt*>(value);
+							valueInt->OnValueRefreshed(_value);
+							break;
+						}
+						case ValueID::ValueType_List:
+						{
+							Internal::VC::ValueList* valueList = static_cast<Internal::VC::ValueList*>(value);
+							valueList->OnValueRefreshed(_value);
+							break;
+						}
+						default:
+						{
+							Log::Write(LogLevel_Info, GetNodeId(), "Invalid type (%d) for configuration parameter %d", value->GetID().GetType(), _parameter);
+						}
+					}
+					value->Release();
+				}
+				else
+				{
+					char label[24];
+					snprintf(label, sizeof(label), "Parameter #%d", _parameter);
+
+					// Create a new value
+					if (Node* node = GetNodeUnsafe())
+					{
+						switch (_size)
+						{
+							case 1:
 							{
-								Internal::VC::ValueShort* valueShort = static_cast<Internal::VC::ValueShort*>(value);
-								valueShort->OnValueRefreshed((int16) paramValue);
+								node->CreateValueByte(ValueID::ValueGenre_Config, GetCommandClassId(), _instance, _parameter, label, "", false, false, (uint8) _value, 0);
 								break;
 							}
-							case ValueID::ValueType_Int:
+							case 2:
 							{
-								Internal::VC::ValueInt* valueInt = static_cast<Internal::VC::ValueInt*>(value);
-								valueInt->OnValueRefreshed(paramValue);
+								node->CreateValueShort(ValueID::ValueGenre_Config, GetCommandClassId(), _instance, _parameter, label, "", false, false, (int16) _value, 0);
 								break;
 							}
-							case ValueID::ValueType_List:
+							case 4:
 							{
-								Internal::VC::ValueList* valueList = static_cast<Internal::VC::ValueList*>(value);
-								valueList->OnValueRefreshed(paramValue);
+								node->CreateValueInt(ValueID::ValueGenre_Config, GetCommandClassId(), _instance, _parameter, label, "", false, false, (int32) _value, 0);
 								break;
 							}
 							default:
 							{
-								Log::Write(LogLevel_Info, GetNodeId(), "Invalid type (%d) for configuration parameter %d", value->GetID().GetType(), parameter);
-							}
-						}
-						value->Release();
-					}
-					else
-					{
-						char label[16];
-						snprintf(label, 16, "Parameter #%hhu", parameter);
-
-						// Create a new value
-						if (Node* node = GetNodeUnsafe())
-						{
-							switch (size)
-							{
-								case 1:
-								{
-									node->CreateValueByte(ValueID::ValueGenre_Config, GetCommandClassId(), _instance, parameter, label, "", false, false, (uint8) paramValue, 0);
-									break;
-								}
-								case 2:
-								{
-									node->CreateValueShort(ValueID::ValueGenre_Config, GetCommandClassId(), _instance, parameter, label, "", false, false, (int16) paramValue, 0);
-									break;
-								}
-								case 4:
-								{
-									node->CreateValueInt(ValueID::ValueGenre_Config, GetCommandClassId(), _instance, parameter, label, "", false, false, (int32) paramValue, 0);
-									break;
-								}
-								default:
-								{
-									Log::Write(LogLevel_Info, GetNodeId(), "Invalid size of %d bytes for configuration parameter %d", size, parameter);
-								}
+								Log::Write(LogLevel_Info, GetNodeId(), "Invalid size of %d bytes for configuration parameter %d", _size, _parameter);
 							}
 						}
 					}
-
-					Log::Write(LogLevel_Info, GetNodeId(), "Received Configuration report: Parameter=%d, Value=%d", parameter, paramValue);
-					return true;
 				}
 
-				return false;
+				Log::Write(LogLevel_Info, GetNodeId(), "Received Configuration report: Parameter=%d, Value=%d", _parameter, _value);
 			}
 
 //-----------------------------------------------------------------------------
@@ -257,6 +552,19 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void Configuration::Set(uint16 const _parameter, int32 const _value, uint8 const _size)
 			{
+				if (_parameter > 0xff)
+				{
+					// Only the Bulk commands can address parameters above 255
+					if (GetVersion() >= 2 && !m_dom.GetFlagBool(STATE_FLAG_CONFIG_NOBULK))
+					{
+						SetBulk(_parameter, vector<int32>(1, _value), _size);
+					}
+					else
+					{
+						Log::Write(LogLevel_Warning, GetNodeId(), "Configuration::Set - Parameter=%d can not be set on this node", _parameter);
+					}
+					return;
+				}
 				Log::Write(LogLevel_Info, GetNodeId(), "Configuration::Set - Parameter=%d, Value=%d Size=%d", _parameter, _value, _size);
 
 				Msg* msg = new Msg("ConfigurationCmd_Set", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true);
@@ -266,18 +574,309 @@ namespace OpenZWave
 				msg->Append(ConfigurationCmd_Set);
 				msg->Append((_parameter & 0xFF));
 				msg->Append(_size);
-				if (_size > 2)
+				AppendParameterValue(msg, _value, _size);
+				msg->Append(GetDriver()->GetTransmitOptions());
+				GetDriver()->SendMsg(msg, Driver::MsgQueue_Send);
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::SetBulk>
+// Set consecutive parameters of the same size
+//-----------------------------------------------------------------------------
+			void Configuration::SetBulk(uint16 const _first, vector<int32> const& _values, uint8 const _size)
+			{
+				if (_size != 1 && _size != 2 && _size != 4)
 				{
-					msg->Append((uint8) ((_value >> 24) & 0xff));
-					msg->Append((uint8) ((_value >> 16) & 0xff));
+					Log::Write(LogLevel_Warning, GetNodeId(), "Configuration::SetBulk - Invalid Size=%d", _size);
+					return;
 				}
-				if (_size > 1)
+				if (GetVersion() < 2 || m_dom.GetFlagBool(STATE_FLAG_CONFIG_NOBULK))
+				{
+					for (size_t i = 0; i < _values.size(); ++i)
+					{
+						Set(_first + i, _values[i], _size);
+					}
+					return;
+				}
+
+				size_t const perFrame = MaxBulkSetBytes / _size;
+				for (size_t start = 0; start < _values.size(); start += perFrame)
 				{
-					msg->Append((uint8) ((_value >> 8) & 0xff));
+					uint8 const count = (uint8) std::min(perFrame, _values.size() - start);
+					uint16 const first = _first + start;
+					Log::Write(LogLevel_Info, GetNodeId(), "Configuration::SetBulk - Parameters=%d to %d Size=%d", first, first + count - 1, _size);
+
+					Msg* msg = new Msg("ConfigurationCmd_BulkSet", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true);
+					msg->Append(GetNodeId());
+					msg->Append(6 + count * _size);
+					msg->Append(GetCommandClassId());
+					msg->Append(ConfigurationCmd_BulkSet);
+					msg->Append((uint8) (first >> 8));
+					msg->Append((uint8) (first & 0xff));
+					msg->Append(count);
+					msg->Append(_size);
+					for (uint8 i = 0; i < count; ++i)
+					{
+						AppendParameterValue(msg, _values[start + i], _size);
+					}
+					msg->Append(GetDriver()->GetTransmitOptions());
+					GetDriver()->SendMsg(msg, Driver::MsgQueue_Send);
 				}
-				msg->Append((uint8) (_value & 0xff));
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::RequestAllParameters>
+// Request the values of every known parameter
+//-----------------------------------------------------------------------------
+			bool Configuration::RequestAllParameters(uint32 const _requestFlags, Driver::MsgQueue const _queue)
+			{
+				Node* node = GetNodeUnsafe();
+				if (!node)
+				{
+					return false;
+				}
+
+				// Sizes of the readable parameters, in parameter order.  0 if not known.
+				std::map<uint16, uint8> parameters;
+				Internal::VC::ValueStore* store = node->GetValueStore();
+				for (Internal::VC::ValueStore::Iterator it = store->Begin(); it != store->End(); ++it)
+				{
+					Internal::VC::Value* value = it->second;
+					if (value->GetID().GetCommandClassId() != GetCommandClassId() || value->IsWriteOnly())
+					{
+						continue;
+					}
+					uint8 size = 0;
+					switch (value->GetID().GetType())
+					{
+						case ValueID::ValueType_Bool:
+						case ValueID::ValueType_Byte:
+						{
+							size = 1;
+							break;
+						}
+						case ValueID::ValueType_Short:
+						{
+							size = 2;
+							break;
+						}
+						case ValueID::ValueType_Int:
+						{
+							size = 4;
+							break;
+						}
+						case ValueID::ValueType_List:
+						{
+							size = static_cast<Internal::VC::ValueList*>(value)->GetSize();
+							break;
+						}
+						case ValueID::ValueType_BitSet:
+						{
+							size = static_cast<Internal::VC::ValueBitSet*>(value)->GetSize();
+							break;
+						}
+						default:
+						{
+						}
+					}
+					parameters[value->GetID().GetIndex()] = size;
+				}
+
+				bool const bulk = GetVersion() >= 2 && !m_dom.GetFlagBool(STATE_FLAG_CONFIG_NOBULK) && m_com.GetFlagBool(COMPAT_FLAG_GETSUPPORTED);
+				bool res = false;
+				std::map<uint16, uint8>::const_iterator it = parameters.begin();
+				while (it != parameters.end())
+				{
+					// A Bulk Get covers a run of consecutive parameters of the same size
+					uint16 const first = it->first;
+					uint8 const size = it->second;
+					uint8 count = 1;
+					for (++it; bulk && size && it != parameters.end() && it->first == first + count && it->second == size && count < 0xff; ++it)
+					{
+						++count;
+					}
+					if (count > 1 || (bulk && first > 0xff))
+					{
+						res |= RequestBulk(first, count, _queue);
+					}
+					else
+					{
+						res |= RequestValue(_requestFlags, first, 1, _queue);
+					}
+				}
+				return res;
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::RequestBulk>
+// Request the values of consecutive parameters of the same size
+//-----------------------------------------------------------------------------
+			bool Configuration::RequestBulk(uint16 const _first, uint8 const _count, Driver::MsgQueue const _queue)
+			{
+				Msg* msg = new Msg("ConfigurationCmd_BulkGet", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true, true, FUNC_ID_APPLICATION_COMMAND_HANDLER, GetCommandClassId());
+				msg->Append(GetNodeId());
+				msg->Append(5);
+				msg->Append(GetCommandClassId());
+				msg->Append(ConfigurationCmd_BulkGet);
+				msg->Append((uint8) (_first >> 8));
+				msg->Append((uint8) (_first & 0xff));
+				msg->Append(_count);
 				msg->Append(GetDriver()->GetTransmitOptions());
-				GetDriver()->SendMsg(msg, Driver::MsgQueue_Send);
+				GetDriver()->SendMsg(msg, _queue);
+				return true;
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::RequestProperties>
+// Ask for the size, format and range of a parameter, and the number of the next one
+//-----------------------------------------------------------------------------
+			bool Configuration::RequestProperties(uint16 const _parameter)
+			{
+				Msg* msg = new Msg("ConfigurationCmd_PropertiesGet", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true, true, FUNC_ID_APPLICATION_COMMAND_HANDLER, GetCommandClassId());
+				msg->Append(GetNodeId());
+				msg->Append(4);
+				msg->Append(GetCommandClassId());
+				msg->Append(ConfigurationCmd_PropertiesGet);
+				msg->Append((uint8) (_parameter >> 8));
+				msg->Append((uint8) (_parameter & 0xff));
+				msg->Append(GetDriver()->GetTransmitOptions());
+				GetDriver()->SendMsg(msg, Driver::MsgQueue_Query);
+				return true;
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::RequestText>
+// Ask for the name (Name Get) or help text (Info Get) of a parameter
+//-----------------------------------------------------------------------------
+			bool Configuration::RequestText(uint8 const _command, uint16 const _parameter)
+			{
+				Msg* msg = new Msg(_command == ConfigurationCmd_NameGet ? "ConfigurationCmd_NameGet" : "ConfigurationCmd_InfoGet", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true, true, FUNC_ID_APPLICATION_COMMAND_HANDLER, GetCommandClassId());
+				msg->Append(GetNodeId());
+				msg->Append(4);
+				msg->Append(GetCommandClassId());
+				msg->Append(_command);
+				msg->Append((uint8) (_parameter >> 8));
+				msg->Append((uint8) (_parameter & 0xff));
+				msg->Append(GetDriver()->GetTransmitOptions());
+				GetDriver()->SendMsg(msg, Driver::MsgQueue_Query);
+				return true;
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::CreateParameter>
+// Create the value for a discovered parameter
+//-----------------------------------------------------------------------------
+			void Configuration::CreateParameter(ParameterInfo const& _info)
+			{
+				Node* node = GetNodeUnsafe();
+				if (!node)
+				{
+					return;
+				}
+
+				char label[24];
+				snprintf(label, sizeof(label), "Parameter #%d", _info.m_parameter);
+				string const name = _info.m_name.empty() ? string(label) : _info.m_name;
+				switch (_info.m_size)
+				{
+					case 1:
+					{
+						node->CreateValueByte(ValueID::ValueGenre_Config, GetCommandClassId(), 1, _info.m_parameter, name, "", _info.m_readOnly, false, (uint8) _info.m_default, 0);
+						break;
+					}
+					case 2:
+					{
+						node->CreateValueShort(ValueID::ValueGenre_Config, GetCommandClassId(), 1, _info.m_parameter, name, "", _info.m_readOnly, false, (int16) _info.m_default, 0);
+						break;
+					}
+					case 4:
+					{
+						node->CreateValueInt(ValueID::ValueGenre_Config, GetCommandClassId(), 1, _info.m_parameter, name, "", _info.m_readOnly, false, _info.m_default, 0);
+						break;
+					}
+					default:
+					{
+						return;
+					}
+				}
+				if (Internal::VC::Value* value = GetValue(1, _info.m_parameter))
+				{
+					value->SetRange(_info.m_min, _info.m_max);
+					if (!_info.m_info.empty())
+					{
+						value->SetHelp(_info.m_info);
+					}
+					value->Release();
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::DiscoveryDone>
+// Every parameter has been described.  Keep them for the other devices of this
+// product and read their values.
+//-----------------------------------------------------------------------------
+			void Configuration::DiscoveryDone()
+			{
+				Log::Write(LogLevel_Info, GetNodeId(), "Discovered %d configuration parameters", (uint32) m_discovered.size());
+				string const key = GetProductKey();
+				if (!key.empty())
+				{
+					if (!m_discovered.empty())
+					{
+						LockGuard LG(s_productsMutex);
+						s_products[key] = m_discovered;
+					}
+				}
+				m_discovered.clear();
+				m_textIndex = 0;
+				ClearStaticRequest(StaticRequest_Values);
+				RequestAllParameters(0, Driver::MsgQueue_Query);
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::HasParameters>
+// Whether the device XML or the cache created any parameter values
+//-----------------------------------------------------------------------------
+			bool Configuration::HasParameters() const
+			{
+				if (Node* node = GetNodeUnsafe())
+				{
+					Internal::VC::ValueStore* store = node->GetValueStore();
+					for (Internal::VC::ValueStore::Iterator it = store->Begin(); it != store->End(); ++it)
+					{
+						if (it->second->GetID().GetCommandClassId() == GetCommandClassId())
+						{
+							return true;
+						}
+					}
+				}
+				return false;
+			}
+
+//-----------------------------------------------------------------------------
+// <Configuration::GetProductKey>
+// Identify the product and firmware of the device, or empty if they are not
+// known yet.  Parameters can change between firmware versions.
+//-----------------------------------------------------------------------------
+			string Configuration::GetProductKey() const
+			{
+				if (Node* node = GetNodeUnsafe())
+				{
+					if (node->GetManufacturerId() || node->GetProductType() || node->GetProductId())
+					{
+						string firmware;
+						if (Version* vcc = static_cast<Version*>(node->GetCommandClass(Version::StaticGetCommandClassId())))
+						{
+							firmware = vcc->GetApplicationVersion();
+							if (firmware.empty())
+							{
+								return "";
+							}
+						}
+						return ProductCache::GetKey(node->GetManufacturerId(), node->GetProductType(), node->GetProductId(), firmware);
+					}
+				}
+				return "";
 			}
 		} // namespace CC
 	} // namespace Internal
@@ -29,16 +29,29 @@
 #define _Configuration_H
 
 #include <list>
+#include <map>
+#include <vector>
 #include "command_classes/CommandClass.h"
 
 namespace OpenZWave
 {
 	namespace Internal
 	{
+		namespace Platform
+		{
+			class Mutex;
+		}
+
 		namespace CC
 		{
 
 			/** \brief Implements COMMAND_CLASS_CONFIGURATION (0x70), a Z-Wave device command class.
+			 *
+			 * Version 2 devices are read and written several parameters per frame with the
+			 * Bulk commands.  Version 3 and later devices that have no parameters described
+			 * in their device XML are asked for their parameters, with their size, range,
+			 * name and help text.  What one device reports is kept for the other devices
+			 * of the same product and firmware.
 			 * \ingroup CommandClass
 			 */
 			class Configuration: public CommandClass
@@ -63,9 +76,23 @@ namespace OpenZWave
 						return "COMMAND_CLASS_CONFIGURATION";
 					}
 
+					virtual bool RequestState(uint32 const _requestFlags, uint8 const _instance, Driver::MsgQueue const _queue) override;
 					virtual bool RequestValue(uint32 const _requestFlags, uint16 const _parameter, uint8 const _index, Driver::MsgQueue const _queue) override;
 					void Set(uint16 const _parameter, int32 const _value, uint8 const _size);
 
+					/**
+					 * Set consecutive parameters of the same size, starting at _first.  Falls back
+					 * to one Set per parameter on devices without the Bulk commands.
+					 */
+					void SetBulk(uint16 const _first, vector<int32> const& _values, uint8 const _size);
+
+					/**
+					 * Request the values of every known parameter, several per frame where the
+					 * device supports it.
+					 * \return true if any request was sent.
+					 */
+					bool RequestAllParameters(uint32 const _requestFlags, Driver::MsgQueue const _queue);
+
 					// From CommandClass
 					virtual uint8 const GetCommandClassId() const override
 					{
@@ -76,13 +103,45 @@ namespace OpenZWave
 						return StaticGetCommandClassName();
 					}
 					virtual bool HandleMsg(uint8 const* _data, uint32 const _length, uint32 const _instance = 1) override;
+					virtual void RequestDropped(uint8 const* _data, uint32 const _length) override;
 					virtual bool SetValue(Internal::VC::Value const& _value) override;
+					virtual uint8 GetMaxVersion() override
+					{
+						return 4;
+					}
 
 				private:
-					Configuration(uint32 const _homeId, uint8 const _nodeId) :
-							CommandClass(_homeId, _nodeId)
+					Configuration(uint32 const _homeId, uint8 const _nodeId);
+
+					struct ParameterInfo
 					{
-					}
+							uint16 m_parameter;
+							uint8 m_size;
+							uint8 m_format;
+							bool m_readOnly;
+							int32 m_min;
+							int32 m_max;
+							int32 m_default;
+							string m_name;
+							string m_info;
+					};
+
+					bool RequestProperties(uint16 const _parameter);
+					bool RequestText(uint8 const _command, uint16 const _parameter);
+					bool RequestBulk(uint16 const _first, uint8 const _count, Driver::MsgQueue const _queue);
+					void UpdateParameter(uint8 const _instance, uint16 const _parameter, uint8 const _size, int32 const _value);
+					void CreateParameter(ParameterInfo const& _info);
+					void PropertiesDone();
+					void TextDone(bool const _isName);
+					void DiscoveryDone();
+					bool HasParameters() const;
+					string GetProductKey() const;
+
+					vector<ParameterInfo> m_discovered;		// Parameters reported so far by a running discovery
+					size_t m_textIndex;						// Entry of m_discovered whose name and help text are being requested
+
+					static std::map<string, vector<ParameterInfo> > s_products;	// Parameters discovered, by product and firmware
+					static Internal::Platform::Mutex* s_productsMutex;
 			};
 		} // namespace CC
 	} // namespace Internal
@@ -114,7 +114,7 @@ namespace OpenZWave
 				{
 					uint8 scale;
 					uint8 precision = 0;
-					string value = ExtractValue(&_data[2], &scale, &precision);
+					int32 value = ExtractNumericValue(&_data[2], &scale, &precision);
 					uint8 paramType = _data[1];
 					if (paramType > 4) /* size of  c_energyParameterNames minus Invalid Entry*/
 					{
@@ -122,14 +122,13 @@ namespace OpenZWave
 						return false;
 					}
 
-					Log::Write(LogLevel_Info, GetNodeId(), "Received an Energy production report: %s = %s", c_energyParameterNames[_data[1]], value.c_str());
+					if (Log::IsLevelEnabled(LogLevel_Info))
+					{
+						Log::Write(LogLevel_Info, GetNodeId(), "Received an Energy production report: %s = %s", c_energyParameterNames[_data[1]], FormatValue(value, precision).c_str());
+					}
 					if (Internal::VC::ValueDecimal* decimalValue = static_cast<Internal::VC::ValueDecimal*>(GetValue(_instance, _data[1])))
 					{
-						decimalValue->OnValueRefreshed(value);
-						if (decimalValue->GetPrecision() != precision)
-						{
-							decimalValue->SetPrecision(precision);
-						}
+						decimalValue->OnValueRefreshed(value, precision);
 						decimalValue->Release();
 					}
 					return true;
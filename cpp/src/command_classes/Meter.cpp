@@ -68,91 +68,94 @@ namespace OpenZWave
 			};
 
 			struct s_MeterTypes {
-				string Label;
-				string Unit;
+				char const* Label;
+				char const* Unit;
 			};
-			std::map<uint32_t, s_MeterTypes> MeterTypes = {
-					{ValueID_Index_Meter::Electric_kWh, {"Electric - kWh", "kWh"}},
-					{ValueID_Index_Meter::Electric_kVah, {"Electric - kVah", "kVah"}},
-					{ValueID_Index_Meter::Electric_W, {"Electric - W", "W"}},
-					{ValueID_Index_Meter::Electric_Pulse, {"Electric - Pulses", "Pulses"}},
-					{ValueID_Index_Meter::Electric_V, {"Electric - V", "V"}},
-					{ValueID_Index_Meter::Electric_A, {"Electric - A", "A"}},
-					{ValueID_Index_Meter::Electric_PowerFactor, {"Electric - PF", "PF"}},
-					{ValueID_Index_Meter::Electric_Unknown_1, {"Electric (Unknown)", ""}},
-					{ValueID_Index_Meter::Electric_kVar, {"Electric - kVar", "kVar"}},
-					{ValueID_Index_Meter::Electric_kVarh, {"Electric - kVarh", "kVarh"}},
-					{ValueID_Index_Meter::Electric_Unknown_2, {"Electric (Unknown)", ""}},
-					{ValueID_Index_Meter::Electric_Unknown_3, {"Electric (Unknown)", ""}},
-					{ValueID_Index_Meter::Electric_Unknown_4, {"Electric (Unknown)", ""}},
-					{ValueID_Index_Meter::Electric_Unknown_5, {"Electric (Unknown)", ""}},
-					{ValueID_Index_Meter::Electric_Unknown_6, {"Electric (Unknown)", ""}},
-					{ValueID_Index_Meter::Electric_Unknown_7, {"Electric (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Cubic_Meters, {"Gas - m3", "m3"}},
-					{ValueID_Index_Meter::Gas_Cubic_Feet, {"Gas - ft3", "ft3"}},
-					{ValueID_Index_Meter::Gas_Unknown_1, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Pulse, {"Gas - Pulses", "Pulses"}},
-					{ValueID_Index_Meter::Gas_Unknown_2, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Unknown_3, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Unknown_4, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Unknown_5, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Unknown_6, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Unknown_7, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Unknown_8, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Unknown_9, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Unknown_10, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Unknown_11, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Unknown_12, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Gas_Unknown_13, {"Gas (Unknown)", ""}},
-					{ValueID_Index_Meter::Water_Cubic_Meters, {"Water - m3", "m3"}},
-					{ValueID_Index_Meter::Water_Cubic_Feet, {"Water - ft3", "ft3"}},
-					{ValueID_Index_Meter::Water_Cubic_US_Gallons, {"Water - gal", "gal"}},
-					{ValueID_Index_Meter::Water_Cubic_Pulse, {"Water - Pulses", "Pulses"}},
-					{ValueID_Index_Meter::Water_Unknown_1, {"Water (Unknown)", ""}},
-					{ValueID_Index_Meter::Water_Unknown_2, {"Water (Unknown)", ""}},
-					{ValueID_Index_Meter::Water_Unknown_3, {"Water (Unknown)", ""}},
-					{ValueID_Index_Meter::Water_Unknown_4, {"Water (Unknown)", ""}},
-					{ValueID_Index_Meter::Water_Unknown_5, {"Water (Unknown)", ""}},
-					{ValueID_Index_Meter::Water_Unknown_6, {"Water (Unknown)", ""}},
-					{ValueID_Index_Meter::Water_Unknown_7, {"Water (Unknown)", ""}},
-					{ValueID_Index_Meter::Water_Unknown_8, {"Water (Unknown)", ""}},
-					{ValueID_Index_Meter::Water_Unknown_9, {"Water (Unknown)", ""}},
-					{ValueID_Index_Meter::Water_Unknown_10, {"Water (Unknown)", ""}},
-					{ValueID_Index_Meter::Water_Unknown_11, {"Water (Unknown)", ""}},
-					{ValueID_Index_Meter::Water_Unknown_12, {"Water (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_kWh, {"Heating - kWh", "kWh"}},
-					{ValueID_Index_Meter::Heating_Unknown_1, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_2, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_3, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_4, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_5, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_6, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_7, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_8, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_9, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_10, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_11, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_12, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_13, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_14, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Heating_Unknown_15, {"Heating (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_kWh, {"Cooling - kWh", "kWh"}},
-					{ValueID_Index_Meter::Cooling_Unknown_1, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_2, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_3, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_4, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_5, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_6, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_7, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_8, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_9, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_10, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_11, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_12, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_13, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_14, {"Cooling (Unknown)", ""}},
-					{ValueID_Index_Meter::Cooling_Unknown_15, {"Cooling (Unknown)", ""}}
+
+			// Indexed by ValueID_Index_Meter, which is ((meter type - 1) * 16) + scale
+			static s_MeterTypes const MeterTypes[] = {
+					{"Electric - kWh", "kWh"},		// Electric_kWh
+					{"Electric - kVah", "kVah"},		// Electric_kVah
+					{"Electric - W", "W"},		// Electric_W
+					{"Electric - Pulses", "Pulses"},		// Electric_Pulse
+					{"Electric - V", "V"},		// Electric_V
+					{"Electric - A", "A"},		// Electric_A
+					{"Electric - PF", "PF"},		// Electric_PowerFactor
+					{"Electric (Unknown)", ""},		// Electric_Unknown_1
+					{"Electric - kVar", "kVar"},		// Electric_kVar
+					{"Electric - kVarh", "kVarh"},		// Electric_kVarh
+					{"Electric (Unknown)", ""},		// Electric_Unknown_2
+					{"Electric (Unknown)", ""},		// Electric_Unknown_3
+					{"Electric (Unknown)", ""},		// Electric_Unknown_4
+					{"Electric (Unknown)", ""},		// Electric_Unknown_5
+					{"Electric (Unknown)", ""},		// Electric_Unknown_6
+					{"Electric (Unknown)", ""},		// Electric_Unknown_7
+					{"Gas - m3", "m3"},		// Gas_Cubic_Meters
+					{"Gas - ft3", "ft3"},		// Gas_Cubic_Feet
+					{"Gas (Unknown)", ""},		// Gas_Unknown_1
+					{"Gas - Pulses", "Pulses"},		// Gas_Pulse
+					{"Gas (Unknown)", ""},		// Gas_Unknown_2
+					{"Gas (Unknown)", ""},		// Gas_Unknown_3
+					{"Gas (Unknown)", ""},		// Gas_Unknown_4
+					{"Gas (Unknown)", ""},		// Gas_Unknown_5
+					{"Gas (Unknown)", ""},		// Gas_Unknown_6
+					{"Gas (Unknown)", ""},		// Gas_Unknown_7
+					{"Gas (Unknown)", ""},		// Gas_Unknown_8
+					{"Gas (Unknown)", ""},		// Gas_Unknown_9
+					{"Gas (Unknown)", ""},		// Gas_Unknown_10
+					{"Gas (Unknown)", ""},		// Gas_Unknown_11
+					{"Gas (Unknown)", ""},		// Gas_Unknown_12
+					{"Gas (Unknown)", ""},		// Gas_Unknown_13
+					{"Water - m3", "m3"},		// Water_Cubic_Meters
+					{"Water - ft3", "ft3"},		// Water_Cubic_Feet
+					{"Water - gal", "gal"},		// Water_Cubic_US_Gallons
+					{"Water - Pulses", "Pulses"},		// Water_Cubic_Pulse
+					{"Water (Unknown)", ""},		// Water_Unknown_1
+					{"Water (Unknown)", ""},		// Water_Unknown_2
+					{"Water (Unknown)", ""},		// Water_Unknown_3
+					{"Water (Unknown)", ""},		// Water_Unknown_4
+					{"Water (Unknown)", ""},		// Water_Unknown_5
+					{"Water (Unknown)", ""},		// Water_Unknown_6
+					{"Water (Unknown)", ""},		// Water_Unknown_7
+					{"Water (Unknown)", ""},		// Water_Unknown_8
+					{"Water (Unknown)", ""},		// Water_Unknown_9
+					{"Water (Unknown)", ""},		// Water_Unknown_10
+					{"Water (Unknown)", ""},		// Water_Unknown_11
+					{"Water (Unknown)", ""},		// Water_Unknown_12
+					{"Heating - kWh", "kWh"},		// Heating_kWh
+					{"Heating (Unknown)", ""},		// Heating_Unknown_1
+					{"Heating (Unknown)", ""},		// Heating_Unknown_2
+					{"Heating (Unknown)", ""},		// Heating_Unknown_3
+					{"Heating (Unknown)", ""},		// Heating_Unknown_4
+					{"Heating (Unknown)", ""},		// Heating_Unknown_5
+					{"Heating (Unknown)", ""},		// Heating_Unknown_6
+					{"Heating (Unknown)", ""},		// Heating_Unknown_7
+					{"Heating (Unknown)", ""},		// Heating_Unknown_8
+					{"Heating (Unknown)", ""},		// Heating_Unknown_9
+					{"Heating (Unknown)", ""},		// Heating_Unknown_10
+					{"Heating (Unknown)", ""},		// Heating_Unknown_11
+					{"Heating (Unknown)", ""},		// Heating_Unknown_12
+					{"Heating (Unknown)", ""},		// Heating_Unknown_13
+					{"Heating (Unknown)", ""},		// Heating_Unknown_14
+					{"Heating (Unknown)", ""},		// Heating_Unknown_15
+					{"Cooling - kWh", "kWh"},		// Cooling_kWh
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_1
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_2
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_3
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_4
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_5
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_6
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_7
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_8
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_9
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_10
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_11
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_12
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_13
+					{"Cooling (Unknown)", ""},		// Cooling_Unknown_14
+					{"Cooling (Unknown)", ""}		// Cooling_Unknown_15
 			};
+			static uint32 const MeterTypeCount = sizeof(MeterTypes) / sizeof(MeterTypes[0]);
 //-----------------------------------------------------------------------------
 // <Meter::Meter>
 // Constructor
@@ -160,14 +163,6 @@ namespace OpenZWave
 			Meter::Meter(uint32 const _homeId, uint8 const _nodeId) :
 					CommandClass(_homeId, _nodeId)
 			{
-#if 0
-				std::map<uint32_t, s_MeterTypes>::iterator it;
-				for (it = MeterTypes.begin(); it != MeterTypes.end(); it++) {
-					std::cout << "Type: " << it->first << std::endl;
-					std::cout << "\tLabel: " << it->second.Label << std::endl;
-					std::cout << "\tUnit: " << it->second.Unit << std::endl;
-				}
-#endif
 				SetStaticRequest(StaticRequest_Values);
 			}
 
@@ -180,7 +175,7 @@ namespace OpenZWave
 				bool res = false;
 				if (GetVersion() > 1)
 				{
-					if (_requestFlags & RequestFlag_Static)
+					if ((_requestFlags & RequestFlag_Static) && !ReplayProductReports(_instance))
 					{
 						Msg* msg = new Msg("MeterCmd_SupportedGet", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true, true, FUNC_ID_APPLICATION_COMMAND_HANDLER, GetCommandClassId());
 						msg->SetInstance(this, _instance);
@@ -215,7 +210,7 @@ namespace OpenZWave
 					Log::Write(LogLevel_Info, GetNodeId(), "MeterCmd_Get Not Supported on this node");
 					return false;
 				}
-				for (uint8 i = 0; i < MeterTypes.size(); ++i)
+				for (uint8 i = 0; i < MeterTypeCount; ++i)
 				{
 					Internal::VC::Value* value = GetValue(_instance, i);
 					if (value != NULL)
@@ -270,6 +265,7 @@ namespace OpenZWave
 				bool handled = false;
 				if (MeterCmd_SupportedReport == (MeterCmd) _data[0])
 				{
+					RecordProductReport(_data, _length, _instance);
 					handled = HandleSupportedReport(_data, _length, _instance);
 				}
 				else if (MeterCmd_Report == (MeterCmd) _data[0])
@@ -327,13 +323,13 @@ namespace OpenZWave
 						if (scale & (1 << i))
 						{
 							uint32 type = ((meterType-1) * 16) + i;
-							if (type > MeterTypes.size()) {
+							if (type >= MeterTypeCount) {
 								/* error */
 								Log::Write(LogLevel_Warning, GetNodeId(), "MeterType %d and Unit %d is unknown", meterType, i);
 								continue;
 							}
-							Log::Write(LogLevel_Info, GetNodeId(), "Creating MeterType %s (%d) with Unit %s (%d) at Index %d", MeterTypes.at(type).Label.c_str(), meterType, MeterTypes.at(type).Unit.c_str(), i, type);
-							node->CreateValueDecimal(ValueID::ValueGenre_User, GetCommandClassId(), _instance, type, MeterTypes.at(type).Label, MeterTypes.at(type).Unit, true, false, "0.0", 0);
+							Log::Write(LogLevel_Info, GetNodeId(), "Creating MeterType %s (%d) with Unit %s (%d) at Index %d", MeterTypes[type].Label, meterType, MeterTypes[type].Unit, i, type);
+							node->CreateValueDecimal(ValueID::ValueGenre_User, GetCommandClassId(), _instance, type, MeterTypes[type].Label, MeterTypes[type].Unit, true, false, "0.0", 0);
 						}
 					}
 					// Create the export flag
@@ -359,37 +355,37 @@ namespace OpenZWave
 				// Get the value and scale
 				uint8 scale;
 				uint8 precision = 0;
-				string valueStr = ExtractValue(&_data[2], &scale, &precision);
+				int32 numericValue = ExtractNumericValue(&_data[2], &scale, &precision);
 				scale = GetScale(_data, _length);
 				int8 meterType = (MeterType) (_data[1] & 0x1f);
 
 				uint16_t index = (((meterType -1) * 16) + scale);
 
-				if (MeterTypes.count(index) == 0) {
+				if (index >= MeterTypeCount) {
 					Log::Write(LogLevel_Warning, GetNodeId(), "MeterTypes Index is out of range/not valid - %d", index);
 					return false;
 				}
+				s_MeterTypes const& type = MeterTypes[index];
 
-				Log::Write(LogLevel_Info, GetNodeId(), "Received Meter Report for %s (%d) with Units %s (%d) on Index %d: %s",MeterTypes.at(index).Label.c_str(), meterType, MeterTypes.at(index).Unit.c_str(), scale, index, valueStr.c_str());
+				if (Log::IsLevelEnabled(LogLevel_Info))
+				{
+					Log::Write(LogLevel_Info, GetNodeId(), "Received Meter Report for %s (%d) with Units %s (%d) on Index %d: %s", type.Label, meterType, type.Unit, scale, index, FormatValue(numericValue, precision).c_str());
+				}
 
 				Internal::VC::ValueDecimal* value = static_cast<Internal::VC::ValueDecimal*>(GetValue(_instance, index));
 				if (!value && (GetVersion() == 1))
 				{
 					if (Node* node = GetNodeUnsafe())
 					{
-						Log::Write(LogLevel_Info, GetNodeId(), "Creating Version 1 MeterType %s (%d) with Unit %s (%d) at Index %d", MeterTypes.at(index).Label.c_str(), meterType, MeterTypes.at(index).Unit.c_str(), scale, index);
-						node->CreateValueDecimal(ValueID::ValueGenre_User, GetCommandClassId(), _instance, index, MeterTypes.at(index).Label, MeterTypes.at(index).Unit, true, false, "0.0", 0);
+						Log::Write(LogLevel_Info, GetNodeId(), "Creating Version 1 MeterType %s (%d) with Unit %s (%d) at Index %d", type.Label, meterType, type.Unit, scale, index);
+						node->CreateValueDecimal(ValueID::ValueGenre_User, GetCommandClassId(), _instance, index, type.Label, type.Unit, true, false, "0.0", 0);
 						value = static_cast<Internal::VC::ValueDecimal*>(GetValue(_instance, index));
 					}
 				} else if (!value) {
-					Log::Write(LogLevel_Warning, GetNodeId(), "Can't Find a ValueID Index for %s (%d) with Unit %s (%d) - Index %d", MeterTypes.at(index).Label.c_str(), meterType, MeterTypes.at(index).Unit.c_str(), scale, index);
+					Log::Write(LogLevel_Warning, GetNodeId(), "Can't Find a ValueID Index for %s (%d) with Unit %s (%d) - Index %d", type.Label, meterType, type.Unit, scale, index);
 					return false;
 				}
-				value->OnValueRefreshed(valueStr);
-				if (value->GetPrecision() != precision)
-				{
-					value->SetPrecision(precision);
-				}
+				value->OnValueRefreshed(numericValue, precision);
 				value->Release();
 				bool exporting = false;
 				if (GetVersion() > 1)
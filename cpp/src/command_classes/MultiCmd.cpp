@@ -27,6 +27,9 @@
 
 #include "command_classes/CommandClasses.h"
 #include "command_classes/MultiCmd.h"
+#include "command_classes/MultiInstance.h"
+#include "command_classes/Security.h"
+#include "command_classes/CRC16Encap.h"
 #include "Defs.h"
 #include "Msg.h"
 #include "Node.h"
@@ -40,6 +43,19 @@ namespace OpenZWave
 		namespace CC
 		{
 
+//-----------------------------------------------------------------------------
+// <MultiCmd::~MultiCmd>
+// Destructor
+//-----------------------------------------------------------------------------
+			MultiCmd::~MultiCmd()
+			{
+				while (!m_unanswered.empty())
+				{
+					delete m_unanswered.front();
+					m_unanswered.pop_front();
+				}
+			}
+
 //-----------------------------------------------------------------------------
 // <MultiCmd::HandleMsg>
 // Handle a message from the Z-Wave network
@@ -90,6 +106,7 @@ namespace OpenZWave
 							}
 
 							uint8 commandClassId = _data[base + 1];
+							ReplyReceived(commandClassId, (length > 1) ? _data[base + 2] : 0, 0);
 
 							if (CommandClass *pCommandClass = node->GetCommandClass(commandClassId))
 							{
@@ -108,6 +125,175 @@ namespace OpenZWave
 				}
 				return false;
 			}
+
+//-----------------------------------------------------------------------------
+// <MultiCmd::CanEncapsulate>
+// Check whether a queued message can be packed into a Multi Command frame
+//-----------------------------------------------------------------------------
+			bool MultiCmd::CanEncapsulate(Msg* _msg)
+			{
+				if (_msg->isEncrypted() || _msg->IsWakeUpNoMoreInformationCommand() || _msg->IsNoOperation())
+				{
+					return false;
+				}
+
+				uint8 const* buffer = _msg->GetBuffer();
+				if (buffer[3] != FUNC_ID_ZW_SEND_DATA)
+				{
+					return false;
+				}
+
+				// Other encapsulations must stay on the outside of the frame.  Multi Channel
+				// encapsulation is the exception, as it goes inside Multi Command.
+				uint8 const commandClassId = buffer[6];
+				if (commandClassId == MultiInstance::StaticGetCommandClassId())
+				{
+					if (buffer[7] != MultiInstance::MultiChannelCmd_Encap && buffer[7] != MultiInstance::MultiInstanceCmd_Encap)
+					{
+						return false;
+					}
+				}
+				else if (commandClassId == StaticGetCommandClassId() || commandClassId == Security::StaticGetCommandClassId() || commandClassId == CRC16Encap::StaticGetCommandClassId())
+				{
+					return false;
+				}
+
+				// Command Class, command, and room for the encapsulation header
+				return (buffer[5] >= 2 && buffer[5] + 4 <= MaxPayload);
+			}
+
+//-----------------------------------------------------------------------------
+// <MultiCmd::SendEncapsulated>
+// Pack the messages into as few Multi Command frames as possible and send them
+//-----------------------------------------------------------------------------
+			void MultiCmd::SendEncapsulated(list<Msg*>* _msgs)
+			{
+				while (!_msgs->empty())
+				{
+					vector<Msg*> packed;
+					uint32 payload = 3;	// Command Class, command and number of commands
+					while (!_msgs->empty())
+					{
+						uint8 const length = _msgs->front()->GetBuffer()[5];
+						if (!packed.empty() && (payload + 1 + length > MaxPayload))
+						{
+							break;
+						}
+						packed.push_back(_msgs->front());
+						payload += 1 + length;
+						_msgs->pop_front();
+					}
+
+					if (packed.size() == 1)
+					{
+						// Nothing to gain from encapsulating a single command
+						GetDriver()->SendMsg(packed.front(), Driver::MsgQueue_WakeUp);
+						continue;
+					}
+
+					Log::Write(LogLevel_Info, GetNodeId(), "Encapsulating %d queued commands in a Multi-command frame", (int) packed.size());
+					Msg* msg = new Msg("MultiCmdCmd_Encap", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true);
+					msg->Append(GetNodeId());
+					msg->Append((uint8) payload);
+					msg->Append(GetCommandClassId());
+					msg->Append(MultiCmdCmd_Encap);
+					msg->Append((uint8) packed.size());
+					for (vector<Msg*>::iterator it = packed.begin(); it != packed.end(); ++it)
+					{
+						uint8 const* buffer = (*it)->GetBuffer();
+						Log::Write(LogLevel_Detail, GetNodeId(), "  %s", (*it)->GetLogText().c_str());
+						msg->Append(buffer[5]);
+						msg->AppendArray(&buffer[6], buffer[5]);
+
+						// Keep the Gets around until their report arrives, so they can be
+						// resent on their own if the device drops part of the frame
+						if ((*it)->GetExpectedReply() == FUNC_ID_APPLICATION_COMMAND_HANDLER)
+						{
+							m_unanswered.push_back(*it);
+						}
+						else
+						{
+							delete *it;
+						}
+					}
+					msg->Append(GetDriver()->GetTransmitOptions());
+					GetDriver()->SendMsg(msg, Driver::MsgQueue_WakeUp);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <MultiCmd::ReplyReceived>
+// A report has arrived, match it up with an encapsulated Get
+//-----------------------------------------------------------------------------
+			void MultiCmd::ReplyReceived(uint8 const _commandClassId, uint8 const _command, uint8 const _endPoint)
+			{
+				// Encapsulated reports are matched once they have been unwrapped
+				if (_commandClassId == MultiInstance::StaticGetCommandClassId())
+				{
+					return;
+				}
+
+				for (list<Msg*>::iterator it = m_unanswered.begin(); it != m_unanswered.end(); ++it)
+				{
+					uint8 commandClassId;
+					uint8 command;
+					uint8 endPoint;
+					GetRequest(*it, &commandClassId, &command, &endPoint);
+					// The report command is the Get command plus one in nearly every command
+					// class.  A report that is not matched only means the Get is sent again.
+					if (commandClassId == _commandClassId && (uint8) (command + 1) == _command && endPoint == _endPoint)
+					{
+						Log::Write(LogLevel_Detail, GetNodeId(), "Received reply to encapsulated %s", (*it)->GetLogText().c_str());
+						delete *it;
+						m_unanswered.erase(it);
+						return;
+					}
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <MultiCmd::GetRequest>
+// The command class, command and endpoint (or instance) of a Get, inside any
+// Multi Channel encapsulation
+//-----------------------------------------------------------------------------
+			void MultiCmd::GetRequest(Msg* _msg, uint8* o_commandClassId, uint8* o_command, uint8* o_endPoint)
+			{
+				uint8 const* buffer = _msg->GetBuffer();
+				uint32 offset = 6;
+				*o_endPoint = 0;
+				if (buffer[6] == MultiInstance::StaticGetCommandClassId())
+				{
+					if (buffer[7] == MultiInstance::MultiChannelCmd_Encap)
+					{
+						*o_endPoint = buffer[9] & 0x7f;
+						offset = 10;
+					}
+					else
+					{
+						*o_endPoint = buffer[8];
+						offset = 9;
+					}
+				}
+				*o_commandClassId = buffer[offset];
+				*o_command = buffer[offset + 1];
+			}
+
+//-----------------------------------------------------------------------------
+// <MultiCmd::RequeueUnanswered>
+// Resend, unencapsulated, any Gets that went unanswered during the last wake up
+//-----------------------------------------------------------------------------
+			void MultiCmd::RequeueUnanswered()
+			{
+				while (!m_unanswered.empty())
+				{
+					Msg* msg = m_unanswered.front();
+					m_unanswered.pop_front();
+					Log::Write(LogLevel_Info, GetNodeId(), "No reply to encapsulated %s - resending on its own", msg->GetLogText().c_str());
+					msg->SetSendAttempts(0);
+					msg->UpdateCallbackId();
+					GetDriver()->SendMsg(msg, Driver::MsgQueue_WakeUp);
+				}
+			}
 		} // namespace CC
 	} // namespace Internal
 } // namespace OpenZWave
@@ -28,6 +28,7 @@
 #ifndef _MultiCmd_H
 #define _MultiCmd_H
 
+#include <list>
 #include "command_classes/CommandClass.h"
 
 namespace OpenZWave
@@ -52,9 +53,7 @@ namespace OpenZWave
 					{
 						return new MultiCmd(_homeId, _nodeId);
 					}
-					virtual ~MultiCmd()
-					{
-					}
+					virtual ~MultiCmd();
 
 					static uint8 const StaticGetCommandClassId()
 					{
@@ -76,11 +75,31 @@ namespace OpenZWave
 					}
 					virtual bool HandleMsg(uint8 const* _data, uint32 const _length, uint32 const _instance = 1) override;
 
+					// Outbound batching of messages queued for a sleeping node
+					bool CanEncapsulate(Msg* _msg);
+					void SendEncapsulated(list<Msg*>* _msgs);
+					/**
+					 * Match a report with a Get sent inside a Multi Command frame.  Called
+					 * once any Multi Channel encapsulation has been removed.
+					 * \param _endPoint the endpoint, or instance, the report came from, or 0.
+					 */
+					void ReplyReceived(uint8 const _commandClassId, uint8 const _command, uint8 const _endPoint);
+					void RequeueUnanswered();
+
 				private:
 					MultiCmd(uint32 const _homeId, uint8 const _nodeId) :
 							CommandClass(_homeId, _nodeId)
 					{
 					}
+
+					enum
+					{
+						MaxPayload = 40		// Stay within the smallest SendData payload (explore frames included)
+					};
+
+					static void GetRequest(Msg* _msg, uint8* o_commandClassId, uint8* o_command, uint8* o_endPoint);
+
+					list<Msg*> m_unanswered;	// Encapsulated Get requests still waiting for their report
 			};
 		} // namespace CC
 	} // namespace Internal
@@ -28,6 +28,7 @@
 #include "tinyxml.h"
 #include "command_classes/CommandClasses.h"
 #include "command_classes/Basic.h"
+#include "command_classes/MultiCmd.h"
 #include "command_classes/MultiInstance.h"
 #include "command_classes/NoOperation.h"
 #include "command_classes/Security.h"
@@ -158,6 +159,7 @@ namespace OpenZWave
 					{
 						case MultiInstanceCmd_Report:
 						{
+							RecordProductReport(_data, _length, _instance);
 							HandleMultiInstanceReport(_data, _length);
 							break;
 						}
@@ -168,11 +170,13 @@ namespace OpenZWave
 						}
 						case MultiChannelCmd_EndPointReport:
 						{
+							RecordProductReport(_data, _length, _instance);
 							HandleMultiChannelEndPointReport(_data, _length);
 							break;
 						}
 						case MultiChannelCmd_CapabilityReport:
 						{
+							RecordProductReport(_data, _length, _instance);
 							HandleMultiChannelCapabilityReport(_data, _length);
 							break;
 						}
@@ -232,9 +236,18 @@ namespace OpenZWave
 					}
 					uint8 commandClassId = _data[2];
 
+					if (MultiCmd* multiCmd = static_cast<MultiCmd*>(node->GetCommandClass(MultiCmd::StaticGetCommandClassId())))
+					{
+						// Match the report up with a Get sent inside a Multi Command frame
+						multiCmd->ReplyReceived(commandClassId, (_length > 3) ? _data[3] : 0, instance);
+					}
+
 					if (CommandClass* pCommandClass = node->GetCommandClass(commandClassId))
 					{
-						Log::Write(LogLevel_Info, GetNodeId(), "Received a MultiInstanceEncap from node %d, instance %d, for Command Class %s", GetNodeId(), instance, pCommandClass->GetCommandClassName().c_str());
+						if (Log::IsLevelEnabled(LogLevel_Info))
+						{
+							Log::Write(LogLevel_Info, GetNodeId(), "Received a MultiInstanceEncap from node %d, instance %d, for Command Class %s", GetNodeId(), instance, pCommandClass->GetCommandClassName().c_str());
+						}
 						pCommandClass->ReceivedCntIncr();
 						pCommandClass->HandleMsg(&_data[3], _length - 3, instance);
 					}
@@ -285,6 +298,12 @@ namespace OpenZWave
 
 				// This code assumes the endpoints are all in numeric sequential order.
 				// Since the end point finds do not appear to work this is the best estimate.
+				// The capability reports of a cached product are replayed after this one
+				if (IsReplayingProductReports())
+				{
+					return;
+				}
+
 				for (uint8 i = 1; i <= len; i++)
 				{
 
@@ -602,6 +621,11 @@ namespace OpenZWave
 				{
 					uint8 endPoint = _data[1] & 0x7f;
 					uint8 commandClassId = _data[3];
+					if (MultiCmd* multiCmd = static_cast<MultiCmd*>(node->GetCommandClass(MultiCmd::StaticGetCommandClassId())))
+					{
+						// Match the report up with a Get sent inside a Multi Command frame
+						multiCmd->ReplyReceived(commandClassId, (_length > 4) ? _data[4] : 0, endPoint);
+					}
 					if (CommandClass* pCommandClass = node->GetCommandClass(commandClassId))
 					{
 						/* 4.85.13 - If the Root Device is originating a command to an End Point in another node, the Source End Point MUST be set to 0.
@@ -618,7 +642,10 @@ namespace OpenZWave
 						/* we can never have a 0 Instance */
 						if (instance == 0)
 							instance = 1;
-						Log::Write(LogLevel_Info, GetNodeId(), "Received a MultiChannelEncap from node %d, endpoint %d for Command Class %s", GetNodeId(), endPoint, pCommandClass->GetCommandClassName().c_str());
+						if (Log::IsLevelEnabled(LogLevel_Info))
+						{
+							Log::Write(LogLevel_Info, GetNodeId(), "Received a MultiChannelEncap from node %d, endpoint %d for Command Class %s", GetNodeId(), endPoint, pCommandClass->GetCommandClassName().c_str());
+						}
 						if (!pCommandClass->IsAfterMark()) 
 						{
 							if (!pCommandClass->HandleMsg(&_data[4], _length - 4, instance)) 
@@ -65,7 +65,7 @@ namespace OpenZWave
 				bool res = false;
 				if (GetVersion() > 4)
 				{
-					if (_requestFlags & RequestFlag_Static)
+					if ((_requestFlags & RequestFlag_Static) && !ReplayProductReports(_instance))
 					{
 						/* for Versions 5 and Above
 						 * Send a Supported Get. When we get the Reply
@@ -208,7 +208,9 @@ namespace OpenZWave
 				{
 					string msg = "";
 
-					if (GetNodeUnsafe())
+					// The scale reports of a cached product are replayed after this one
+					RecordProductReport(_data, _length, _instance);
+					if (GetNodeUnsafe() && !IsReplayingProductReports())
 					{
 						for (uint8 i = 1; i <= (_length - 2); i++)
 						{
@@ -235,6 +237,7 @@ namespace OpenZWave
 				}
 				else if (SensorMultiLevelCmd_SupportedReportScale == (SensorMultilevelCmd) _data[0])
 				{
+					RecordProductReport(_data, _length, _instance);
 					uint32_t sensorType = _data[1];
 					int8_t defaultScale = -1;
 					vector<Internal::VC::ValueList::Item> items;
@@ -269,25 +272,39 @@ namespace OpenZWave
 					uint8 scale;
 					uint8 precision = 0;
 					uint8 sensorType = _data[1];
-					string valueStr = ExtractValue(&_data[2], &scale, &precision);
+					int32 numericValue = ExtractNumericValue(&_data[2], &scale, &precision);
 
 					Node* node = GetNodeUnsafe();
 					if (node != NULL)
 					{
+						SensorMultiLevelCCTypes* types = SensorMultiLevelCCTypes::Get();
 						Internal::VC::ValueDecimal* value = static_cast<Internal::VC::ValueDecimal*>(GetValue(_instance, sensorType));
 						if (value == NULL)
 						{
-							node->CreateValueDecimal(ValueID::ValueGenre_User, GetCommandClassId(), _instance, sensorType, SensorMultiLevelCCTypes::Get()->GetSensorName(sensorType), "", true, false, "0.0", 0);
+							node->CreateValueDecimal(ValueID::ValueGenre_User, GetCommandClassId(), _instance, sensorType, types->GetSensorName(sensorType), "", true, false, "0.0", 0);
 							value = static_cast<Internal::VC::ValueDecimal*>(GetValue(_instance, sensorType));
 						}
-						value->SetUnits(SensorMultiLevelCCTypes::Get()->GetSensorUnit(sensorType, scale));
 
-						Log::Write(LogLevel_Info, GetNodeId(), "Received SensorMultiLevel report from node %d, instance %d, %s: value=%s%s", GetNodeId(), _instance, SensorMultiLevelCCTypes::Get()->GetSensorName(sensorType).c_str(), valueStr.c_str(), value->GetUnits().c_str());
-						if (value->GetPrecision() != precision)
+						// The known types and scales are looked up without copying their strings.  The
+						// slow lookup is kept for unknown ones as it logs a warning.
+						if (SensorMultiLevelCCTypes::SensorMultiLevelScales const* sensorScale = types->FindSensorScale(sensorType, scale))
+						{
+							if (value->GetUnits() != sensorScale->unit)
+							{
+								value->SetUnits(sensorScale->unit);
+							}
+						}
+						else
+						{
+							value->SetUnits(types->GetSensorUnit(sensorType, scale));
+						}
+
+						if (Log::IsLevelEnabled(LogLevel_Info))
 						{
-							value->SetPrecision(precision);
+							SensorMultiLevelCCTypes::SensorMultiLevelTypes const* type = types->FindSensorType(sensorType);
+							Log::Write(LogLevel_Info, GetNodeId(), "Received SensorMultiLevel report from node %d, instance %d, %s: value=%s%s", GetNodeId(), _instance, type ? type->name.c_str() : "Unknown", FormatValue(numericValue, precision).c_str(), value->GetUnits().c_str());
 						}
-						value->OnValueRefreshed(valueStr);
+						value->OnValueRefreshed(numericValue, precision);
 						value->Release();
 						return true;
 					}
@@ -0,0 +1,447 @@
+//-----------------------------------------------------------------------------
+//
+//	Supervision.cpp
+//
+//	Implementation of the Z-Wave COMMAND_CLASS_SUPERVISION
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+
+#include "command_classes/CommandClasses.h"
+#include "command_classes/Supervision.h"
+#include "Defs.h"
+#include "Msg.h"
+#include "Node.h"
+#include "Driver.h"
+#include "Utils.h"
+#include "platform/Log.h"
+#include "platform/Mutex.h"
+
+#include "value_classes/ValueBitSet.h"
+#include "value_classes/ValueBool.h"
+#include "value_classes/ValueByte.h"
+#include "value_classes/ValueDecimal.h"
+#include "value_classes/ValueInt.h"
+#include "value_classes/ValueList.h"
+#include "value_classes/ValueShort.h"
+#include "value_classes/ValueString.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace CC
+		{
+
+//-----------------------------------------------------------------------------
+// <Supervision::Supervision>
+// Constructor
+//-----------------------------------------------------------------------------
+			Supervision::Supervision(uint32 const _homeId, uint8 const _nodeId) :
+					CommandClass(_homeId, _nodeId), m_mutex(new Internal::Platform::Mutex()), m_nextSessionId(0)
+			{
+				for (uint32 i = 0; i < MaxSessions; ++i)
+				{
+					m_sessions[i].m_active = false;
+					m_sessions[i].m_intValue = 0;
+					m_sessions[i].m_literal = false;
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <Supervision::~Supervision>
+// Destructor
+//-----------------------------------------------------------------------------
+			Supervision::~Supervision()
+			{
+				m_mutex->Release();
+			}
+
+//-----------------------------------------------------------------------------
+// <Supervision::Supervise>
+// Wrap a Set of a value in a Supervision Get
+//-----------------------------------------------------------------------------
+			bool Supervision::Supervise(Msg* _msg, Internal::VC::Value const& _target)
+			{
+				LockGuard LG(m_mutex);
+				uint8 commandClassId = _msg->GetSendingCommandClass();
+				if (commandClassId == 0 || commandClassId == StaticGetCommandClassId() || m_unsupported.find(commandClassId) != m_unsupported.end())
+				{
+					return false;
+				}
+
+				Node* node = GetNodeUnsafe();
+				if (!node)
+				{
+					return false;
+				}
+
+				// The Set is encrypted or not according to the command class inside it, so
+				// the node would drop it if Supervision were only supported the other way
+				CommandClass* cc = node->GetCommandClass(commandClassId);
+				if (!cc || cc->IsSecured() != IsSecured())
+				{
+					return false;
+				}
+
+				Session session;
+				session.m_active = true;
+				session.m_id = _target.GetID();
+				session.m_intValue = 0;
+				session.m_literal = false;
+				switch (_target.GetID().GetType())
+				{
+					case ValueID::ValueType_Bool:
+					{
+						session.m_intValue = static_cast<Internal::VC::ValueBool const*>(&_target)->GetValue() ? 1 : 0;
+						session.m_literal = true;
+						break;
+					}
+					case ValueID::ValueType_Byte:
+					{
+						session.m_intValue = static_cast<Internal::VC::ValueByte const*>(&_target)->GetValue();
+						session.m_literal = IsLiteral(_target, session.m_intValue);
+						break;
+					}
+					case ValueID::ValueType_Short:
+					{
+						session.m_intValue = static_cast<Internal::VC::ValueShort const*>(&_target)->GetValue();
+						session.m_literal = IsLiteral(_target, session.m_intValue);
+						break;
+					}
+					case ValueID::ValueType_Int:
+					{
+						session.m_intValue = static_cast<Internal::VC::ValueInt const*>(&_target)->GetValue();
+						session.m_literal = IsLiteral(_target, session.m_intValue);
+						break;
+					}
+					case ValueID::ValueType_BitSet:
+					{
+						session.m_intValue = (int32) static_cast<Internal::VC::ValueBitSet const*>(&_target)->GetValue();
+						break;
+					}
+					case ValueID::ValueType_List:
+					{
+						Internal::VC::ValueList::Item const* item = static_cast<Internal::VC::ValueList const*>(&_target)->GetItem();
+						if (!item)
+						{
+							return false;
+						}
+						session.m_intValue = item->m_value;
+						session.m_literal = true;
+						break;
+					}
+					case ValueID::ValueType_Decimal:
+					{
+						session.m_stringValue = static_cast<Internal::VC::ValueDecimal const*>(&_target)->GetValue();
+						break;
+					}
+					case ValueID::ValueType_String:
+					{
+						session.m_stringValue = static_cast<Internal::VC::ValueString const*>(&_target)->GetValue();
+						break;
+					}
+					case ValueID::ValueType_Button:
+					{
+						// Write only, so there is nothing to confirm
+						break;
+					}
+					default:
+					{
+						// Raw and Schedule values are refreshed with a Get
+						return false;
+					}
+				}
+
+				uint8 sessionId = m_nextSessionId;
+				m_nextSessionId = (m_nextSessionId + 1) % MaxSessions;
+				if (m_sessions[sessionId].m_active)
+				{
+					Log::Write(LogLevel_Warning, GetNodeId(), "Supervision session %d was never completed, reusing it", sessionId);
+				}
+				m_sessions[sessionId] = session;
+				_msg->SetSupervision(sessionId);
+				return true;
+			}
+
+//-----------------------------------------------------------------------------
+// <Supervision::HandleMsg>
+// Handle a message from the Z-Wave network
+//-----------------------------------------------------------------------------
+			bool Supervision::HandleMsg(uint8 const* _data, uint32 const _length, uint32 const _instance	// = 1
+					)
+			{
+				if (SupervisionCmd_Report == _data[0] && _length >= 4)
+				{
+					HandleReport(_data, _length);
+					return true;
+				}
+				if (SupervisionCmd_Get == _data[0] && _length >= 5)
+				{
+					HandleGet(_data, _length, _instance);
+					return true;
+				}
+				return false;
+			}
+
+//-----------------------------------------------------------------------------
+// <Supervision::HandleReport>
+// The node reports how far it got with a supervised Set
+//-----------------------------------------------------------------------------
+			void Supervision::HandleReport(uint8 const* _data, uint32 const _length)
+			{
+				uint8 sessionId = _data[1] & 0x3f;
+				uint8 status = _data[2];
+				uint32 duration = (_length > 4) ? decodeDuration(_data[3]) : 0;
+
+				Session session;
+				{
+					LockGuard LG(m_mutex);
+					if (!m_sessions[sessionId].m_active)
+					{
+						Log::Write(LogLevel_Info, GetNodeId(), "Received Supervision Report for unknown session %d, status 0x%.2x", sessionId, status);
+						return;
+					}
+					session = m_sessions[sessionId];
+
+					// The session stays open while more reports are due
+					if (!(_data[1] & 0x80) && status != SupervisionStatus_Working)
+					{
+						m_sessions[sessionId].m_active = false;
+					}
+					if (status == SupervisionStatus_NoSupport)
+					{
+						// Don't supervise this command class again
+						m_unsupported.insert(session.m_id.GetCommandClassId());
+					}
+				}
+
+				switch (status)
+				{
+					case SupervisionStatus_Working:
+					{
+						// A final report follows once the node has finished, since we asked for status updates
+						Log::Write(LogLevel_Info, GetNodeId(), "Received Supervision Report: session %d working, %d seconds remaining", sessionId, duration);
+						ApplyTarget(session, true, duration);
+						break;
+					}
+					case SupervisionStatus_Success:
+					{
+						Log::Write(LogLevel_Info, GetNodeId(), "Received Supervision Report: session %d succeeded", sessionId);
+						ApplyTarget(session, false, 0);
+						break;
+					}
+					case SupervisionStatus_Fail:
+					{
+						Log::Write(LogLevel_Warning, GetNodeId(), "Received Supervision Report: session %d failed", sessionId);
+						RefreshValue(session.m_id);
+						break;
+					}
+					case SupervisionStatus_NoSupport:
+					{
+						// Fetch the value the Get was skipped for
+						Log::Write(LogLevel_Info, GetNodeId(), "Received Supervision Report: session %d not supported for %s", sessionId, CommandClasses::GetName(session.m_id.GetCommandClassId()).c_str());
+						RefreshValue(session.m_id);
+						break;
+					}
+					default:
+					{
+						Log::Write(LogLevel_Warning, GetNodeId(), "Received Supervision Report: session %d with unknown status 0x%.2x", sessionId, status);
+						RefreshValue(session.m_id);
+						break;
+					}
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <Supervision::HandleGet>
+// The node sent us a supervised command.  Handle it and confirm it.
+//-----------------------------------------------------------------------------
+			void Supervision::HandleGet(uint8 const* _data, uint32 const _length, uint32 const _instance)
+			{
+				uint8 sessionId = _data[1] & 0x3f;
+				uint8 commandClassId = _data[3];
+				uint32 length = _data[2];
+				if (length > _length - 4)
+				{
+					length = _length - 4;
+				}
+
+				uint8 status = SupervisionStatus_NoSupport;
+				Node* node = GetNodeUnsafe();
+				if (node)
+				{
+					if (CommandClass* pCommandClass = node->GetCommandClass(commandClassId))
+					{
+						Log::Write(LogLevel_Info, GetNodeId(), "Received Supervision Get for %s, session %d", pCommandClass->GetCommandClassName().c_str(), sessionId);
+						bool handled = pCommandClass->IsAfterMark() ? pCommandClass->HandleIncomingMsg(&_data[4], length, _instance) : pCommandClass->HandleMsg(&_data[4], length, _instance);
+						status = handled ? SupervisionStatus_Success : SupervisionStatus_Fail;
+					}
+					else
+					{
+						Log::Write(LogLevel_Warning, GetNodeId(), "Received Supervision Get for Command Class 0x%.2x, which we can't find", commandClassId);
+					}
+				}
+
+				Msg* msg = new Msg("SupervisionCmd_Report", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true, false);
+				msg->SetInstance(this, _instance);
+				msg->Append(GetNodeId());
+				msg->Append(5);
+				msg->Append(GetCommandClassId());
+				msg->Append(SupervisionCmd_Report);
+				msg->Append(sessionId);
+				msg->Append(status);
+				msg->Append(0);
+				msg->Append(GetDriver()->GetTransmitOptions());
+				GetDriver()->SendMsg(msg, Driver::MsgQueue_Send);
+			}
+
+//-----------------------------------------------------------------------------
+// <Supervision::ApplyTarget>
+// Store the value a supervised Set was confirmed as, or the value it is moving to
+//-----------------------------------------------------------------------------
+			void Supervision::ApplyTarget(Session const& _session, bool const _working, uint32 const _duration)
+			{
+				Node* node = GetNodeUnsafe();
+				if (!node)
+				{
+					return;
+				}
+				Internal::VC::Value* value = node->GetValue(_session.m_id);
+				if (!value)
+				{
+					return;
+				}
+
+				// A Set of anything but a literal state, such as a level of 0xff for "on at
+				// the last level", does not tell us the value the node has ended up with
+				if (!_session.m_literal)
+				{
+					value->Release();
+					if (!_working)
+					{
+						RefreshValue(_session.m_id);
+					}
+					return;
+				}
+
+				if (_working)
+				{
+					switch (_session.m_id.GetType())
+					{
+						case ValueID::ValueType_Bool:
+							static_cast<Internal::VC::ValueBool*>(value)->SetTargetValue(_session.m_intValue != 0, _duration);
+							break;
+						case ValueID::ValueType_Byte:
+							static_cast<Internal::VC::ValueByte*>(value)->SetTargetValue((uint8) _session.m_intValue, _duration);
+							break;
+						case ValueID::ValueType_Short:
+							static_cast<Internal::VC::ValueShort*>(value)->SetTargetValue((int16) _session.m_intValue, _duration);
+							break;
+						case ValueID::ValueType_Int:
+							static_cast<Internal::VC::ValueInt*>(value)->SetTargetValue(_session.m_intValue, _duration);
+							break;
+						case ValueID::ValueType_BitSet:
+							static_cast<Internal::VC::ValueBitSet*>(value)->SetTargetValue((uint32) _session.m_intValue, _duration);
+							break;
+						case ValueID::ValueType_List:
+							static_cast<Internal::VC::ValueList*>(value)->SetTargetValue(_session.m_intValue, _duration);
+							break;
+						case ValueID::ValueType_Decimal:
+							static_cast<Internal::VC::ValueDecimal*>(value)->SetTargetValue(_session.m_stringValue, _duration);
+							break;
+						case ValueID::ValueType_String:
+							static_cast<Internal::VC::ValueString*>(value)->SetTargetValue(_session.m_stringValue, _duration);
+							break;
+						default:
+							break;
+					}
+					value->Release();
+					return;
+				}
+
+				// The node has confirmed the value, so there is nothing to verify
+				bool verify = value->GetChangeVerified();
+				value->SetChangeVerified(false);
+				switch (_session.m_id.GetType())
+				{
+					case ValueID::ValueType_Bool:
+						static_cast<Internal::VC::ValueBool*>(value)->OnValueRefreshed(_session.m_intValue != 0);
+						break;
+					case ValueID::ValueType_Byte:
+						static_cast<Internal::VC::ValueByte*>(value)->OnValueRefreshed((uint8) _session.m_intValue);
+						break;
+					case ValueID::ValueType_Short:
+						static_cast<Internal::VC::ValueShort*>(value)->OnValueRefreshed((int16) _session.m_intValue);
+						break;
+					case ValueID::ValueType_Int:
+						static_cast<Internal::VC::ValueInt*>(value)->OnValueRefreshed(_session.m_intValue);
+						break;
+					case ValueID::ValueType_BitSet:
+						static_cast<Internal::VC::ValueBitSet*>(value)->OnValueRefreshed((uint32) _session.m_intValue);
+						break;
+					case ValueID::ValueType_List:
+						static_cast<Internal::VC::ValueList*>(value)->OnValueRefreshed(_session.m_intValue);
+						break;
+					case ValueID::ValueType_Decimal:
+						static_cast<Internal::VC::ValueDecimal*>(value)->OnValueRefreshed(_session.m_stringValue);
+						break;
+					case ValueID::ValueType_String:
+						static_cast<Internal::VC::ValueString*>(value)->OnValueRefreshed(_session.m_stringValue);
+						break;
+					default:
+						break;
+				}
+				value->SetChangeVerified(verify);
+				value->Release();
+			}
+
+//-----------------------------------------------------------------------------
+// <Supervision::IsLiteral>
+// Whether a numeric value being Set is the state the node will report
+//-----------------------------------------------------------------------------
+			bool Supervision::IsLiteral(Internal::VC::Value const& _target, int32 const _value)
+			{
+				return _value != 0xff && _value >= _target.GetMin() && _value <= _target.GetMax();
+			}
+
+//-----------------------------------------------------------------------------
+// <Supervision::RefreshValue>
+// Fall back to a Get when a supervised Set could not be confirmed
+//-----------------------------------------------------------------------------
+			void Supervision::RefreshValue(ValueID const& _id)
+			{
+				if (_id.GetType() == ValueID::ValueType_Button)
+				{
+					return;
+				}
+				if (Node* node = GetNodeUnsafe())
+				{
+					if (CommandClass* cc = node->GetCommandClass(_id.GetCommandClassId()))
+					{
+						cc->RequestValue(0, _id.GetIndex(), _id.GetInstance(), Driver::MsgQueue_Send);
+					}
+				}
+			}
+		} // namespace CC
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,155 @@
+//-----------------------------------------------------------------------------
+//
+//	Supervision.h
+//
+//	Implementation of the Z-Wave COMMAND_CLASS_SUPERVISION
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+
+#ifndef _Supervision_H
+#define _Supervision_H
+
+#include <set>
+#include "command_classes/CommandClass.h"
+#include "value_classes/ValueID.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		class Msg;
+
+		namespace VC
+		{
+			class Value;
+		}
+		namespace Platform
+		{
+			class Mutex;
+		}
+
+		namespace CC
+		{
+
+			/** \brief Implements COMMAND_CLASS_SUPERVISION (0x6c), a Z-Wave device command class.
+			 *
+			 * Sets issued by Value::Set are wrapped in a Supervision Get, and the node
+			 * confirms them with a Supervision Report.  A successful report stores the
+			 * value that was Set, so no Get is needed to refresh it.  This is only done for
+			 * Bool and List values, and numeric values within their range other than 0xff.
+			 * Other values are still refreshed with a Get once the report arrives.
+			 * \ingroup CommandClass
+			 */
+			class Supervision: public CommandClass
+			{
+				public:
+					enum SupervisionCmd
+					{
+						SupervisionCmd_Get = 0x01,
+						SupervisionCmd_Report = 0x02
+					};
+
+					enum SupervisionStatus
+					{
+						SupervisionStatus_NoSupport = 0x00,
+						SupervisionStatus_Working = 0x01,
+						SupervisionStatus_Fail = 0x02,
+						SupervisionStatus_Success = 0xff
+					};
+
+					static CommandClass* Create(uint32 const _homeId, uint8 const _nodeId)
+					{
+						return new Supervision(_homeId, _nodeId);
+					}
+					virtual ~Supervision();
+
+					static uint8 const StaticGetCommandClassId()
+					{
+						return 0x6c;
+					}
+					static string const StaticGetCommandClassName()
+					{
+						return "COMMAND_CLASS_SUPERVISION";
+					}
+
+					/**
+					 * Wrap a Set of a value in a Supervision Get, and remember the value it
+					 * will be confirmed as.  Must be called before the message is finalized.
+					 * \param _msg the Set message.
+					 * \param _target a copy of the value holding the value being Set.
+					 * \return false if the Set cannot be supervised and must be refreshed with a Get.
+					 */
+					bool Supervise(Msg* _msg, Internal::VC::Value const& _target);
+
+					// From CommandClass
+					virtual uint8 const GetCommandClassId() const override
+					{
+						return StaticGetCommandClassId();
+					}
+					virtual string const GetCommandClassName() const override
+					{
+						return StaticGetCommandClassName();
+					}
+					virtual bool HandleMsg(uint8 const* _data, uint32 const _length, uint32 const _instance = 1) override;
+					virtual bool HandleIncomingMsg(uint8 const* _data, uint32 const _length, uint32 const _instance = 1) override
+					{
+						return HandleMsg(_data, _length, _instance);
+					}
+					bool supportsMultiInstance() override
+					{
+						return false;
+					}
+
+				private:
+					Supervision(uint32 const _homeId, uint8 const _nodeId);
+
+					enum
+					{
+						MaxSessions = 64		// Session IDs are six bits
+					};
+
+					struct Session
+					{
+							bool m_active;
+							ValueID m_id;
+							int32 m_intValue;		// Target of Bool, Byte, Short, Int, List and BitSet values
+							string m_stringValue;	// Target of Decimal and String values
+							bool m_literal;			// The target is the state the node will report, so it can be stored on Success
+					};
+
+					void HandleReport(uint8 const* _data, uint32 const _length);
+					void HandleGet(uint8 const* _data, uint32 const _length, uint32 const _instance);
+					void ApplyTarget(Session const& _session, bool const _working, uint32 const _duration);
+					static bool IsLiteral(Internal::VC::Value const& _target, int32 const _value);
+					void RefreshValue(ValueID const& _id);
+
+					Internal::Platform::Mutex* m_mutex;	// Sets are supervised by the caller's thread, reports arrive on the driver thread
+					Session m_sessions[MaxSessions];
+					uint8 m_nextSessionId;
+					std::set<uint8> m_unsupported;	// Command classes the node has reported it cannot supervise
+			};
+		} // namespace CC
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif
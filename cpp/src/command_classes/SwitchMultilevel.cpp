@@ -141,7 +141,7 @@ namespace OpenZWave
 					{
 						/* Target Value - 0 to 100 is valid values, 0xFF is also valid */
 						if ((GetVersion() >= 4) && ((_data[2] <= 100) || (_data[2] == 0xFF)))
-							value->SetTargetValue(_data[2], _data[3]);
+							value->SetTargetValue(_data[2], decodeDuration(_data[3]));
 						value->OnValueRefreshed(_data[1]);
 						value->Release();
 					}
@@ -416,6 +416,17 @@ namespace OpenZWave
 					msg->Append(SwitchMultilevelCmd_Set);
 					msg->Append(_level);
 					msg->Append(encodeDuration(duration));
+
+					// Track the ramp, so a refresh that finds the switch part way there waits
+					// for the end of it rather than reporting a stale level
+					if ((duration > 0) && (duration <= 7620) && (_level <= 99))
+					{
+						if (Internal::VC::ValueByte* value = static_cast<Internal::VC::ValueByte*>(GetValue(_instance, ValueID_Index_SwitchMultiLevel::Level)))
+						{
+							value->SetTargetValue(_level, duration);
+							value->Release();
+						}
+					}
 				}
 				else
 				{
@@ -152,17 +152,15 @@ namespace OpenZWave
 					{
 						uint8 scale;
 						uint8 precision = 0;
-						string temperature = ExtractValue(&_data[2], &scale, &precision);
+						int32 temperature = ExtractNumericValue(&_data[2], &scale, &precision);
 
 						value->SetUnits(scale ? "F" : "C");
-						value->OnValueRefreshed(temperature);
-						if (value->GetPrecision() != precision)
+						value->OnValueRefreshed(temperature, precision);
+						if (Log::IsLevelEnabled(LogLevel_Info))
 						{
-							value->SetPrecision(precision);
+							Log::Write(LogLevel_Info, GetNodeId(), "Received thermostat setpoint report: Setpoint %s = %s%s", value->GetLabel().c_str(), value->GetValue().c_str(), value->GetUnits().c_str());
 						}
 						value->Release();
-
-						Log::Write(LogLevel_Info, GetNodeId(), "Received thermostat setpoint report: Setpoint %s = %s%s", value->GetLabel().c_str(), value->GetValue().c_str(), value->GetUnits().c_str());
 					}
 					return true;
 				}
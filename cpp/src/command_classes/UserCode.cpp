@@ -50,7 +50,18 @@ namespace OpenZWave
 				UserCodeCmd_Get = 0x02,
 				UserCodeCmd_Report = 0x03,
 				UserNumberCmd_Get = 0x04,
-				UserNumberCmd_Report = 0x05
+				UserNumberCmd_Report = 0x05,
+				UserCodeCmd_CapabilitiesGet = 0x06,
+				UserCodeCmd_CapabilitiesReport = 0x07,
+				UserCodeCmd_ExtendedGet = 0x0C,
+				UserCodeCmd_ExtendedReport = 0x0D,
+				UserCodeCmd_ChecksumGet = 0x11,
+				UserCodeCmd_ChecksumReport = 0x12
+			};
+
+			enum
+			{
+				UserCodeChecksumValid = 0x10000	// Set in STATE_FLAG_USERCODE_CHECKSUM alongside the 16 bit checksum once it is known
 			};
 
 //-----------------------------------------------------------------------------
@@ -58,10 +69,13 @@ namespace OpenZWave
 // Constructor
 //-----------------------------------------------------------------------------
 			UserCode::UserCode(uint32 const _homeId, uint8 const _nodeId) :
-					CommandClass(_homeId, _nodeId), m_queryAll(false), m_currentCode(0), m_refreshUserCodes(false)
+					CommandClass(_homeId, _nodeId), m_queryAll(false), m_currentCode(0), m_pendingChecksum(0), m_refreshUserCodes(false)
 			{
 				m_com.EnableFlag(COMPAT_FLAG_UC_EXPOSERAWVALUE, false);
 				m_dom.EnableFlag(STATE_FLAG_USERCODE_COUNT, 0);
+				m_dom.EnableFlag(STATE_FLAG_USERCODE_CHECKSUMSUPPORTED, false);
+				m_dom.EnableFlag(STATE_FLAG_USERCODE_MULTIPLEREPORTS, false);
+				m_dom.EnableFlag(STATE_FLAG_USERCODE_CHECKSUM, 0);
 				SetStaticRequest(StaticRequest_Values);
 				Options::Get()->GetOptionAsBool("RefreshAllUserCodes", &m_refreshUserCodes);
 
@@ -69,13 +83,17 @@ namespace OpenZWave
 
 //-----------------------------------------------------------------------------
 // <UserCode::RequestState>
-// Nothing to do for UserCode
+// Request the number of codes, then the codes themselves
 //-----------------------------------------------------------------------------
 			bool UserCode::RequestState(uint32 const _requestFlags, uint8 const _instance, Driver::MsgQueue const _queue)
 			{
 				bool requests = false;
 				if ((_requestFlags & RequestFlag_Static) && HasStaticRequest(StaticRequest_Values))
 				{
+					if (GetVersion() >= 2 && _instance == 1)
+					{
+						requests |= RequestCapabilities(_queue);
+					}
 					requests |= RequestValue(_requestFlags, ValueID_Index_UserCode::Count, _instance, _queue);
 				}
 
@@ -83,9 +101,15 @@ namespace OpenZWave
 				{
 					if (m_dom.GetFlagByte(STATE_FLAG_USERCODE_COUNT) > 0)
 					{
-						m_queryAll = true;
-						m_currentCode = 1;
-						requests |= RequestValue(_requestFlags, m_currentCode, _instance, _queue);
+						if (m_dom.GetFlagBool(STATE_FLAG_USERCODE_CHECKSUMSUPPORTED) && _instance == 1)
+						{
+							// Only read the codes if the lock reports they changed since we last did
+							requests |= RequestChecksum(_queue);
+						}
+						else
+						{
+							requests |= QueryAll(_instance, _queue);
+						}
 					}
 				}
 
@@ -202,36 +226,7 @@ namespace OpenZWave
 					int i = _data[1];
 					Log::Write(LogLevel_Info, GetNodeId(), "Received User Code Report from node %d for User Code %d (%s)", GetNodeId(), i, CodeStatus(_data[2]).c_str());
 
-					int8 size = _length - 4;
-					if (size > 10)
-					{
-						Log::Write(LogLevel_Warning, GetNodeId(), "User Code length %d is larger then maximum 10", size);
-						size = 10;
-					}
-					m_userCode[i].status = (UserCodeStatus) _data[2];
-					memcpy(&m_userCode[i].usercode, &_data[3], size);
-					if (Internal::VC::ValueString* value = static_cast<Internal::VC::ValueString*>(GetValue(_instance, i)))
-					{
-						string data;
-						/* Max UserCode Length is 10 */
-						Log::Write(LogLevel_Info, GetNodeId(), "User Code Packet is %d", size);
-						data.assign((const char*) &_data[3], size);
-						value->OnValueRefreshed(data);
-						value->Release();
-					}
-					if (m_com.GetFlagBool(COMPAT_FLAG_UC_EXPOSERAWVALUE))
-					{
-						if (Internal::VC::ValueShort* value = static_cast<Internal::VC::ValueShort*>(GetValue(_instance, ValueID_Index_UserCode::RawValueIndex)))
-						{
-							value->OnValueRefreshed(i);
-							value->Release();
-						}
-						if (Internal::VC::ValueRaw* value = static_cast<Internal::VC::ValueRaw*>(GetValue(_instance, ValueID_Index_UserCode::RawValue)))
-						{
-							value->OnValueRefreshed(&_data[3], (_length - 4));
-							value->Release();
-						}
-					}
+					UpdateCode(_instance, i, _data[2], &_data[3], _length > 4 ? _length - 4 : 0);
 
 					if (m_queryAll && i == m_currentCode)
 					{
@@ -245,16 +240,105 @@ namespace OpenZWave
 							}
 							else
 							{
-								m_queryAll = false;
-								/* we might have reset this as part of the RefreshValues Button Value */
-								Options::Get()->GetOptionAsBool("RefreshAllUserCodes", &m_refreshUserCodes);
+								QueryAllDone();
 							}
 						}
 						else
 						{
 							Log::Write(LogLevel_Info, GetNodeId(), "Not Requesting additional UserCode Slots as RefreshAllUserCodes is false, and slot %d is available", i);
-							m_queryAll = false;
+							QueryAllDone();
+						}
+					}
+					return true;
+				}
+				else if (UserCodeCmd_ExtendedReport == (UserCodeCmd) _data[0])
+				{
+					// Number of codes, then for each: id (2 bytes), status, length and the code.  The last
+					// two bytes are the next occupied slot, or 0 if there are no more.
+					uint8 const count = _data[1];
+					uint32 const end = _length - 1;
+					uint32 pos = 2;
+					Log::Write(LogLevel_Info, GetNodeId(), "Received Extended User Code Report from node %d with %d User Codes", GetNodeId(), count);
+					for (uint8 n = 0; n < count; ++n)
+					{
+						if (pos + 4 > end)
+						{
+							Log::Write(LogLevel_Warning, GetNodeId(), "Extended User Code Report is truncated");
+							break;
+						}
+						uint16 const id = (((uint16) _data[pos]) << 8) | _data[pos + 1];
+						uint8 const status = _data[pos + 2];
+						uint8 const length = _data[pos + 3] & 0x0F;
+						if (pos + 4 + length > end)
+						{
+							Log::Write(LogLevel_Warning, GetNodeId(), "Extended User Code Report is truncated");
+							break;
+						}
+						Log::Write(LogLevel_Info, GetNodeId(), "  User Code %d (%s)", id, CodeStatus(status).c_str());
+
+						if (m_queryAll && id > m_currentCode)
+						{
+							// The lock skips the slots that are not in use
+							for (uint16 slot = m_currentCode; slot < id; ++slot)
+							{
+								UpdateCode(_instance, slot, UserCode_Available, NULL, 0);
+							}
 						}
+						UpdateCode(_instance, id, status, &_data[pos + 4], length);
+						if (m_queryAll && id >= m_currentCode)
+						{
+							m_currentCode = id + 1;
+						}
+						pos += 4 + length;
+					}
+
+					if (m_queryAll)
+					{
+						uint16 next = 0;
+						if (pos + 2 <= end)
+						{
+							next = (((uint16) _data[pos]) << 8) | _data[pos + 1];
+						}
+						uint16 const codes = m_dom.GetFlagByte(STATE_FLAG_USERCODE_COUNT);
+						if (next >= m_currentCode && next <= codes)
+						{
+							RequestCodes(next, Driver::MsgQueue_Query);
+						}
+						else
+						{
+							for (uint16 slot = m_currentCode; slot <= codes; ++slot)
+							{
+								UpdateCode(_instance, slot, UserCode_Available, NULL, 0);
+							}
+							QueryAllDone();
+						}
+					}
+					return true;
+				}
+				else if (UserCodeCmd_CapabilitiesReport == (UserCodeCmd) _data[0])
+				{
+					// The checksum and multiple report flags follow the supported status bitmask
+					uint32 const pos = 2 + (_data[1] & 0x1F);
+					if (pos < _length - 1)
+					{
+						m_dom.SetFlagBool(STATE_FLAG_USERCODE_CHECKSUMSUPPORTED, (_data[pos] & 0x80) != 0);
+						m_dom.SetFlagBool(STATE_FLAG_USERCODE_MULTIPLEREPORTS, (_data[pos] & 0x40) != 0);
+					}
+					Log::Write(LogLevel_Info, GetNodeId(), "Received User Code Capabilities Report from node %d: Checksum %s, Multiple Reports %s", GetNodeId(), m_dom.GetFlagBool(STATE_FLAG_USERCODE_CHECKSUMSUPPORTED) ? "supported" : "not supported", m_dom.GetFlagBool(STATE_FLAG_USERCODE_MULTIPLEREPORTS) ? "supported" : "not supported");
+					return true;
+				}
+				else if (UserCodeCmd_ChecksumReport == (UserCodeCmd) _data[0])
+				{
+					uint32 const checksum = UserCodeChecksumValid | (((uint32) _data[1]) << 8) | _data[2];
+					if (checksum == m_dom.GetFlagInt(STATE_FLAG_USERCODE_CHECKSUM))
+					{
+						Log::Write(LogLevel_Info, GetNodeId(), "Received User Code Checksum Report from node %d: 0x%.4x, unchanged, not requesting the User Codes", GetNodeId(), checksum & 0xFFFF);
+					}
+					else
+					{
+						Log::Write(LogLevel_Info, GetNodeId(), "Received User Code Checksum Report from node %d: 0x%.4x, requesting the User Codes", GetNodeId(), checksum & 0xFFFF);
+						QueryAll(_instance, Driver::MsgQueue_Query);
+						m_pendingChecksum = checksum;
 					}
 					return true;
 				}
@@ -309,9 +393,7 @@ namespace OpenZWave
 				if ((ValueID::ValueType_Button == _value.GetID().GetType()) && (_value.GetID().GetIndex() == ValueID_Index_UserCode::Refresh))
 				{
 					m_refreshUserCodes = true;
-					m_currentCode = 1;
-					m_queryAll = true;
-					RequestValue(0, m_currentCode, _value.GetID().GetInstance(), Driver::MsgQueue_Query);
+					QueryAll(_value.GetID().GetInstance(), Driver::MsgQueue_Query);
 					return true;
 				}
 				if ((ValueID::ValueType_Short == _value.GetID().GetType()) && (_value.GetID().GetIndex() == ValueID_Index_UserCode::RemoveCode))
@@ -406,6 +488,139 @@ namespace OpenZWave
 				return false;
 			}
 
+//-----------------------------------------------------------------------------
+// <UserCode::RequestCapabilities>
+// Ask a version 2 lock whether it supports the checksum and multiple reports
+//-----------------------------------------------------------------------------
+			bool UserCode::RequestCapabilities(Driver::MsgQueue const _queue)
+			{
+				Msg* msg = new Msg("UserCodeCmd_CapabilitiesGet", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true, true, FUNC_ID_APPLICATION_COMMAND_HANDLER, GetCommandClassId());
+				msg->Append(GetNodeId());
+				msg->Append(2);
+				msg->Append(GetCommandClassId());
+				msg->Append(UserCodeCmd_CapabilitiesGet);
+				msg->Append(GetDriver()->GetTransmitOptions());
+				GetDriver()->SendMsg(msg, _queue);
+				return true;
+			}
+
+//-----------------------------------------------------------------------------
+// <UserCode::RequestChecksum>
+// Ask the lock for the checksum of all its codes
+//-----------------------------------------------------------------------------
+			bool UserCode::RequestChecksum(Driver::MsgQueue const _queue)
+			{
+				Msg* msg = new Msg("UserCodeCmd_ChecksumGet", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true, true, FUNC_ID_APPLICATION_COMMAND_HANDLER, GetCommandClassId());
+				msg->Append(GetNodeId());
+				msg->Append(2);
+				msg->Append(GetCommandClassId());
+				msg->Append(UserCodeCmd_ChecksumGet);
+				msg->Append(GetDriver()->GetTransmitOptions());
+				GetDriver()->SendMsg(msg, _queue);
+				return true;
+			}
+
+//-----------------------------------------------------------------------------
+// <UserCode::RequestCodes>
+// Ask for as many codes as fit in one report, starting at a slot
+//-----------------------------------------------------------------------------
+			bool UserCode::RequestCodes(uint16 const _first, Driver::MsgQueue const _queue)
+			{
+				Msg* msg = new Msg("UserCodeCmd_ExtendedGet", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true, true, FUNC_ID_APPLICATION_COMMAND_HANDLER, GetCommandClassId());
+				msg->Append(GetNodeId());
+				msg->Append(5);
+				msg->Append(GetCommandClassId());
+				msg->Append(UserCodeCmd_ExtendedGet);
+				msg->Append((uint8) (_first >> 8));
+				msg->Append((uint8) (_first & 0xFF));
+				msg->Append(0x01);		// Report More
+				msg->Append(GetDriver()->GetTransmitOptions());
+				GetDriver()->SendMsg(msg, _queue);
+				return true;
+			}
+
+//-----------------------------------------------------------------------------
+// <UserCode::QueryAll>
+// Start reading every code, several per report if the lock supports it
+//-----------------------------------------------------------------------------
+			bool UserCode::QueryAll(uint8 const _instance, Driver::MsgQueue const _queue)
+			{
+				m_queryAll = true;
+				m_currentCode = 1;
+				m_pendingChecksum = 0;
+				if (m_dom.GetFlagBool(STATE_FLAG_USERCODE_MULTIPLEREPORTS) && _instance == 1 && m_com.GetFlagBool(COMPAT_FLAG_GETSUPPORTED))
+				{
+					return RequestCodes(m_currentCode, _queue);
+				}
+				return RequestValue(0, m_currentCode, _instance, _queue);
+			}
+
+//-----------------------------------------------------------------------------
+// <UserCode::QueryAllDone>
+// All the codes have been read
+//-----------------------------------------------------------------------------
+			void UserCode::QueryAllDone()
+			{
+				m_queryAll = false;
+				if (m_pendingChecksum)
+				{
+					// The codes we hold now match this checksum, so the next session can skip them
+					m_dom.SetFlagInt(STATE_FLAG_USERCODE_CHECKSUM, m_pendingChecksum);
+					m_pendingChecksum = 0;
+				}
+				/* we might have reset this as part of the RefreshValues Button Value */
+				Options::Get()->GetOptionAsBool("RefreshAllUserCodes", &m_refreshUserCodes);
+			}
+
+//-----------------------------------------------------------------------------
+// <UserCode::UpdateCode>
+// Store a code received in a report
+//-----------------------------------------------------------------------------
+			void UserCode::UpdateCode(uint8 const _instance, uint16 const _index, uint8 const _status, uint8 const* _code, uint8 const _length)
+			{
+				if (_index >= ValueID_Index_UserCode::Refresh)
+				{
+					Log::Write(LogLevel_Warning, GetNodeId(), "User Code %d is out of range", _index);
+					return;
+				}
+
+				uint8 size = _length;
+				if (size > 10)
+				{
+					Log::Write(LogLevel_Warning, GetNodeId(), "User Code length %d is larger then maximum 10", size);
+					size = 10;
+				}
+				UserCodeEntry& entry = m_userCode[_index];
+				entry.status = (UserCodeStatus) _status;
+				memset(entry.usercode, 0, sizeof(entry.usercode));
+				if (size)
+				{
+					memcpy(entry.usercode, _code, size);
+				}
+				if (Internal::VC::ValueString* value = static_cast<Internal::VC::ValueString*>(GetValue(_instance, _index)))
+				{
+					string data;
+					/* Max UserCode Length is 10 */
+					Log::Write(LogLevel_Info, GetNodeId(), "User Code Packet is %d", size);
+					data.assign((const char*) entry.usercode, size);
+					value->OnValueRefreshed(data);
+					value->Release();
+				}
+				if (m_com.GetFlagBool(COMPAT_FLAG_UC_EXPOSERAWVALUE))
+				{
+					if (Internal::VC::ValueShort* value = static_cast<Internal::VC::ValueShort*>(GetValue(_instance, ValueID_Index_UserCode::RawValueIndex)))
+					{
+						value->OnValueRefreshed(_index);
+						value->Release();
+					}
+					if (Internal::VC::ValueRaw* value = static_cast<Internal::VC::ValueRaw*>(GetValue(_instance, ValueID_Index_UserCode::RawValue)))
+					{
+						value->OnValueRefreshed(entry.usercode, size);
+						value->Release();
+					}
+				}
+			}
+
 //-----------------------------------------------------------------------------
 // <UserCode::CreateVars>
 // Create the values managed by this command class
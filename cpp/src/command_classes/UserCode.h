@@ -86,6 +86,10 @@ namespace OpenZWave
 					}
 					virtual bool HandleMsg(uint8 const* _data, uint32 const _length, uint32 const _instance = 1) override;
 					virtual bool SetValue(Internal::VC::Value const& _value) override;
+					virtual uint8 GetMaxVersion() override
+					{
+						return 2;
+					}
 
 				protected:
 					virtual void CreateVars(uint8 const _instance) override;
@@ -93,6 +97,13 @@ namespace OpenZWave
 				private:
 					UserCode(uint32 const _homeId, uint8 const _nodeId);
 
+					bool RequestCapabilities(Driver::MsgQueue const _queue);
+					bool RequestChecksum(Driver::MsgQueue const _queue);
+					bool RequestCodes(uint16 const _first, Driver::MsgQueue const _queue);
+					bool QueryAll(uint8 const _instance, Driver::MsgQueue const _queue);
+					void QueryAllDone();
+					void UpdateCode(uint8 const _instance, uint16 const _index, uint8 const _status, uint8 const* _code, uint8 const _length);
+
 					string CodeStatus(uint8 const _byte)
 					{
 						switch (_byte)
@@ -125,7 +136,8 @@ namespace OpenZWave
 					}
 
 					bool m_queryAll;				// True while we are requesting all the user codes.
-					uint16 m_currentCode;
+					uint16 m_currentCode;			// During a v2 query, the first slot not yet reported
+					uint32 m_pendingChecksum;		// Checksum to store in STATE_FLAG_USERCODE_CHECKSUM once the query completes, or 0
 					std::map<uint16, UserCodeEntry> m_userCode;
 					bool m_refreshUserCodes;
 			};
@@ -128,7 +128,7 @@ namespace OpenZWave
 						snprintf(application, sizeof(application), "%d.%.2d", _data[4], _data[5]);
 
 						Log::Write(LogLevel_Info, GetNodeId(), "Received Version report from node %d: Library=%s, Protocol=%s, Application=%s", GetNodeId(), library, protocol, application);
-						ClearStaticRequest(StaticRequest_Values);
+						m_applicationVersion = application;
 
 						if (Internal::VC::ValueString* libraryValue = static_cast<Internal::VC::ValueString*>(GetValue(_instance, ValueID_Index_Version::Library)))
 						{
@@ -144,6 +144,10 @@ namespace OpenZWave
 						{
 							applicationValue->OnValueRefreshed(application);
 							applicationValue->Release();
+
+							// A report asked for by the product cache can arrive before the
+							// values are created.  The static request then fills them in.
+							ClearStaticRequest(StaticRequest_Values);
 						}
 
 						return true;
@@ -151,6 +155,7 @@ namespace OpenZWave
 
 					if (VersionCmd_CommandClassReport == (VersionCmd) _data[0])
 					{
+						RecordProductReport(_data, _length, _instance);
 						if (CommandClass* pCommandClass = node->GetCommandClass(_data[1]))
 						{
 							Log::Write(LogLevel_Info, GetNodeId(), "Received CommandClass Version report from node %d: CommandClass=%s, Version=%d", GetNodeId(), pCommandClass->GetCommandClassName().c_str(), _data[2]);
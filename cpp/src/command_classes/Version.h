@@ -62,6 +62,15 @@ namespace OpenZWave
 
 					bool RequestCommandClassVersion(CommandClass const* _commandClass);
 
+					/**
+					 * The application (firmware) version reported by the device since the
+					 * library started, or an empty string if no report has been received.
+					 */
+					string const& GetApplicationVersion() const
+					{
+						return m_applicationVersion;
+					}
+
 					// From CommandClass
 					virtual bool RequestState(uint32 const _requestFlags, uint8 const _instance, Driver::MsgQueue const _queue) override;
 					virtual bool RequestValue(uint32 const _requestFlags, uint16 const _index, uint8 const _instance, Driver::MsgQueue const _queue) override;
@@ -83,6 +92,8 @@ namespace OpenZWave
 
 				private:
 					Version(uint32 const _homeId, uint8 const _nodeId);
+
+					string m_applicationVersion;
 			};
 		} // namespace CC
 	} // namespace Internal
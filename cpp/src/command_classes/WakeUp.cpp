@@ -405,11 +405,41 @@ namespace OpenZWave
 			{
 				m_awake = true;
 				bool reloading = false;
+				Node* node = GetNodeUnsafe();
+
+				// If the device supports it, pack consecutive commands into Multi Command
+				// frames so the device can go back to sleep sooner
+				MultiCmd* multiCmd = NULL;
+				bool batching = false;
+				Options::Get()->GetOptionAsBool("MultiCmdBatching", &batching);
+				if (batching && node != NULL)
+				{
+					multiCmd = static_cast<MultiCmd*>(node->GetCommandClass(MultiCmd::StaticGetCommandClassId()));
+				}
+				list<Msg*> batch;
+
 				m_mutex->Lock();
+				if (multiCmd != NULL)
+				{
+					multiCmd->RequeueUnanswered();
+				}
 				list<Driver::MsgQueueItem>::iterator it = m_pendingQueue.begin();
 				while (it != m_pendingQueue.end())
 				{
 					Driver::MsgQueueItem const& item = *it;
+					if (Driver::MsgQueueCmd_SendMsg == item.m_command && multiCmd != NULL && multiCmd->CanEncapsulate(item.m_msg))
+					{
+						batch.push_back(item.m_msg);
+						it = m_pendingQueue.erase(it);
+						continue;
+					}
+
+					// Anything that cannot be batched must keep its place in the queue
+					if (!batch.empty())
+					{
+						multiCmd->SendEncapsulated(&batch);
+					}
+
 					if (Driver::MsgQueueCmd_SendMsg == item.m_command)
 					{
 						GetDriver()->SendMsg(item.m_msg, Driver::MsgQueue_WakeUp);
@@ -430,11 +460,14 @@ namespace OpenZWave
 					}
 					it = m_pendingQueue.erase(it);
 				}
+				if (!batch.empty())
+				{
+					multiCmd->SendEncapsulated(&batch);
+				}
 				m_mutex->Unlock();
 
 				// Send the device back to sleep, unless we have outstanding queries.
 				bool sendToSleep = m_awake;
-				Node* node = GetNodeUnsafe();
 				if (node != NULL)
 				{
 					if (!node->AllQueriesCompleted())
@@ -59,12 +59,17 @@ namespace OpenZWave
 			{
 
 				public:
+					enum
+					{
+						InputBufferSize = 2048		/**< Size of the input stream */
+					};
+
 					/**
 					 * Consructor.
 					 * Creates the controller object.
 					 */
 					Controller() :
-							Stream(2048)
+							Stream(InputBufferSize)
 					{
 					}
 
@@ -45,6 +45,7 @@ namespace OpenZWave
 			{
 					friend class SerialControllerImpl;
 					friend class Wait;
+					friend class WaitSet;
 
 				public:
 					/**
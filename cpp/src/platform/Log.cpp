@@ -60,6 +60,8 @@ char const *OpenZWave::LogLevelString[] =
 Log* Log::s_instance = NULL;
 std::vector<i_LogImpl*> Log::m_pImpls;
 static bool s_dologging;
+static LogLevel s_logLevel = LogLevel_StreamDetail;	// Least severe level that is saved or queued
+std::atomic<int> Log::s_enabledLevel(LogLevel_Invalid);
 
 //-----------------------------------------------------------------------------
 //	<Log::Create>
@@ -71,13 +73,16 @@ Log* Log::Create(string const& _filename, bool const _bAppend, bool const _bCons
 	{
 		s_instance = new Log(_filename, _bAppend, _bConsoleOutput, _saveLevel, _queueLevel, _dumpTrigger);
 		s_dologging = true; // default logging to true so no change to what people experience now
+		s_logLevel = (_saveLevel > _queueLevel) ? _saveLevel : _queueLevel;
 	}
 	else
 	{
 		Log::Destroy();
 		s_instance = new Log(_filename, _bAppend, _bConsoleOutput, _saveLevel, _queueLevel, _dumpTrigger);
 		s_dologging = true; // default logging to true so no change to what people experience now
+		s_logLevel = (_saveLevel > _queueLevel) ? _saveLevel : _queueLevel;
 	}
+	UpdateEnabledLevel();
 
 	return s_instance;
 }
@@ -111,6 +116,7 @@ void Log::Destroy()
 {
 	delete s_instance;
 	s_instance = NULL;
+	UpdateEnabledLevel();
 }
 
 //-----------------------------------------------------------------------------
@@ -127,6 +133,7 @@ bool Log::SetLoggingClass(i_LogImpl *LogClass, bool Append)
 		}
 	}
 	s_instance->m_pImpls.push_back(LogClass);
+	UpdateEnabledLevel();
 	return true;
 }
 
@@ -144,6 +151,7 @@ void Log::SetLoggingState(bool _dologging)
 {
 	bool prevLogging = s_dologging;
 	s_dologging = _dologging;
+	UpdateEnabledLevel();
 
 	if (!prevLogging && s_dologging)
 		Log::Write(LogLevel_Always, "Logging started\n\n");
@@ -164,6 +172,7 @@ void Log::SetLoggingState(LogLevel _saveLevel, LogLevel _queueLevel, LogLevel _d
 		Log::Write(LogLevel_Warning, "The trigger for dumping queued messages must be a higher-priority message than the level that is queued.");
 
 	bool prevLogging = s_dologging;
+	s_logLevel = (_saveLevel > _queueLevel) ? _saveLevel : _queueLevel;
 	// s_dologging is true if any messages are to be saved in file or queue
 	if ((_saveLevel > LogLevel_Always) || (_queueLevel > LogLevel_Always))
 	{
@@ -173,6 +182,7 @@ void Log::SetLoggingState(LogLevel _saveLevel, LogLevel _queueLevel, LogLevel _d
 	{
 		s_dologging = false;
 	}
+	UpdateEnabledLevel();
 
 	if (s_instance && s_dologging && (s_instance->m_pImpls.size() > 0))
 	{
@@ -195,13 +205,24 @@ bool Log::GetLoggingState()
 	return s_dologging;
 }
 
+//-----------------------------------------------------------------------------
+//	<Log::UpdateEnabledLevel>
+//	Recompute the level checked by IsLevelEnabled after the logging state changes
+//-----------------------------------------------------------------------------
+void Log::UpdateEnabledLevel()
+{
+	bool enabled = (s_instance && s_dologging && (m_pImpls.size() > 0));
+	s_enabledLevel.store(enabled ? (int) s_logLevel : (int) LogLevel_Invalid, std::memory_order_relaxed);
+}
+
 //-----------------------------------------------------------------------------
 //	<Log::Write>
 //	Write to the log
 //-----------------------------------------------------------------------------
 void Log::Write(LogLevel _level, char const* _format, ...)
 {
-	if (s_instance && s_dologging && (s_instance->m_pImpls.size() > 0))
+	// Discard messages nobody will see before taking the lock or formatting anything
+	if (IsLevelEnabled(_level) && s_instance)
 	{
 		s_instance->m_logMutex->Lock(); // double locks if recursive
 		va_list args;
@@ -219,7 +240,8 @@ void Log::Write(LogLevel _level, char const* _format, ...)
 //-----------------------------------------------------------------------------
 void Log::Write(LogLevel _level, uint8 const _nodeId, char const* _format, ...)
 {
-	if (s_instance && s_dologging && (s_instance->m_pImpls.size() > 0))
+	// Discard messages nobody will see before taking the lock or formatting anything
+	if (IsLevelEnabled(_level) && s_instance)
 	{
 		if (_level != LogLevel_Internal)
 			s_instance->m_logMutex->Lock();
@@ -31,8 +31,18 @@
 #include <stdarg.h>
 #include <string>
 #include <vector>
+#include <atomic>
 #include "Defs.h"
 
+/** Least severe LogLevel that is compiled in.  Messages below it are removed by the
+ *  compiler wherever Log::IsLevelEnabled guards them, and are discarded on entry to
+ *  Log::Write.  Define it as, for example, LogLevel_Info to strip Detail, Debug and
+ *  StreamDetail logging from a production build.
+ */
+#ifndef OPENZWAVE_LOG_LEVEL
+#define OPENZWAVE_LOG_LEVEL LogLevel_StreamDetail
+#endif
+
 namespace OpenZWave
 {
 	namespace Internal
@@ -164,6 +174,24 @@ namespace OpenZWave
 			 */
 			static void GetLoggingState(LogLevel* _saveLevel, LogLevel* _queueLevel, LogLevel* _dumpTrigger);
 
+			/**\brief Determine whether messages of a given level will be written or queued.
+			 *
+			 * Use this to skip formatting work for messages that would be discarded.
+			 * The check is a single relaxed atomic load and takes no locks, and it is
+			 * constant false for levels excluded by OPENZWAVE_LOG_LEVEL.
+			 * \param _level	LogLevel of the message
+			 * \return true if a message of this level would be kept
+			 */
+			static bool IsLevelEnabled(LogLevel _level)
+			{
+				if ((_level > OPENZWAVE_LOG_LEVEL) && (_level != LogLevel_Internal))
+				{
+					return false;
+				}
+				int enabled = s_enabledLevel.load(std::memory_order_relaxed);
+				return (enabled != LogLevel_Invalid) && ((_level <= enabled) || (_level == LogLevel_Internal));
+			}
+
 			/** \brief Change the log file name.
 			 *
 			 * This will start a new log file (or potentially start appending
@@ -207,8 +235,11 @@ namespace OpenZWave
 			Log(string const& _filename, bool const _bAppend, bool const _bConsoleOutput, LogLevel _saveLevel, LogLevel _queueLevel, LogLevel _dumpTrigger);
 			~Log();
 
+			static void UpdateEnabledLevel();
+
 			static std::vector<i_LogImpl*> m_pImpls; /**< Pointer to an object that encapsulates the platform-specific logging implementation. */
 			static Log* s_instance;
+			static std::atomic<int> s_enabledLevel; /**< Least severe level that is written or queued, or LogLevel_Invalid while nothing is logged */
 			Internal::Platform::Mutex* m_logMutex;
 	};
 } // namespace OpenZWave
@@ -0,0 +1,224 @@
+//-----------------------------------------------------------------------------
+//
+//	ReplayController.cpp
+//
+//	Controller that plays back a capture file instead of talking to hardware
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include "Options.h"
+#include "Utils.h"
+#include "platform/ReplayController.h"
+#include "platform/Event.h"
+#include "platform/Log.h"
+#include "platform/Mutex.h"
+#include "platform/Thread.h"
+#include "platform/TimeStamp.h"
+#include "platform/Wait.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+
+//-----------------------------------------------------------------------------
+//	<ReplayController::ReplayController>
+//	Constructor
+//-----------------------------------------------------------------------------
+			ReplayController::ReplayController() :
+					m_speed(1), m_bOpen(false), m_writtenMutex(new Mutex()), m_writtenEvent(new Event()), m_thread(new Thread("replay"))
+			{
+			}
+
+//-----------------------------------------------------------------------------
+//	<ReplayController::~ReplayController>
+//	Destructor
+//-----------------------------------------------------------------------------
+			ReplayController::~ReplayController()
+			{
+				Close();
+				m_thread->Release();
+				m_writtenEvent->Release();
+				m_writtenMutex->Release();
+			}
+
+//-----------------------------------------------------------------------------
+//	<ReplayController::Open>
+//	Load a capture file and start playing it back
+//-----------------------------------------------------------------------------
+			bool ReplayController::Open(string const& _controllerName)
+			{
+				if (m_bOpen)
+				{
+					return false;
+				}
+
+				m_path = _controllerName;
+				m_records.clear();
+				if (!FrameCapture::Load(m_path, m_records))
+				{
+					return false;
+				}
+
+				int32 speed = 1;
+				Options::Get()->GetOptionAsInt("ReplaySpeed", &speed);
+				m_speed = (speed > 0) ? (uint32) speed : 0;
+
+				Log::Write(LogLevel_Info, "Replaying %d frames from %s at %s", (int) m_records.size(), m_path.c_str(), m_speed ? (m_speed == 1 ? "original speed" : "accelerated speed") : "full speed");
+				m_bOpen = true;
+				m_thread->Start(ReplayController::ReplayThreadEntryPoint, this);
+				return true;
+			}
+
+//-----------------------------------------------------------------------------
+//	<ReplayController::Close>
+//	Stop playback
+//-----------------------------------------------------------------------------
+			bool ReplayController::Close()
+			{
+				if (!m_bOpen)
+				{
+					return false;
+				}
+
+				m_thread->Stop();
+				m_bOpen = false;
+				return true;
+			}
+
+//-----------------------------------------------------------------------------
+//	<ReplayController::Write>
+//	Hand a frame written by the driver to the playback thread
+//-----------------------------------------------------------------------------
+			uint32 ReplayController::Write(uint8* _buffer, uint32 _length)
+			{
+				if (!m_bOpen)
+				{
+					return 0;
+				}
+
+				LockGuard LG(m_writtenMutex);
+				m_written.push_back(std::vector<uint8>(_buffer, _buffer + _length));
+				m_writtenEvent->Set();
+				return _length;
+			}
+
+//-----------------------------------------------------------------------------
+//	<ReplayController::ReplayThreadEntryPoint>
+//	Entry point of the playback thread
+//-----------------------------------------------------------------------------
+			void ReplayController::ReplayThreadEntryPoint(Event* _exitEvent, void* _context)
+			{
+				ReplayController* controller = (ReplayController*) _context;
+				if (controller)
+				{
+					controller->ReplayThreadProc(_exitEvent);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<ReplayController::ReplayThreadProc>
+//	Feed inbound records to the driver and match outbound ones to its writes
+//-----------------------------------------------------------------------------
+			void ReplayController::ReplayThreadProc(Event* _exitEvent)
+			{
+				uint64 start = TimeStamp::Now();
+				uint64 anchor = start;			// TimeStamp::Now() at the last synchronisation point
+				uint64 anchorTime = 0;			// Capture time of the last synchronisation point, in microseconds
+				uint32 matched = 0;
+				uint32 differed = 0;
+
+				for (size_t i = 0; i < m_records.size(); ++i)
+				{
+					FrameCapture::Record const& record = m_records[i];
+					if (record.m_direction == FrameCapture::Direction_Outbound)
+					{
+						// Wait for the driver to write its next frame
+						Wait* objects[2] =
+						{ _exitEvent, m_writtenEvent };
+						if (Wait::Multiple(objects, 2) == 0)
+						{
+							return;
+						}
+
+						std::vector<uint8> frame;
+						{
+							LockGuard LG(m_writtenMutex);
+							frame = m_written.front();
+							m_written.pop_front();
+							if (m_written.empty())
+							{
+								m_writtenEvent->Reset();
+							}
+						}
+
+						if (frame == record.m_data)
+						{
+							matched++;
+						}
+						else
+						{
+							differed++;
+							Log::Write(LogLevel_Warning, "Replay: write %d differs from the capture (%d bytes written, %d recorded)", matched + differed, (int) frame.size(), (int) record.m_data.size());
+						}
+
+						// Replies are timed from when the driver actually wrote
+						anchor = TimeStamp::Now();
+						anchorTime = record.m_time;
+						continue;
+					}
+
+					if (m_speed)
+					{
+						uint64 due = anchor + ((record.m_time - anchorTime) * 1000) / m_speed;
+						uint64 now = TimeStamp::Now();
+						if (due > now && Wait::Single(_exitEvent, (int32) ((due - now) / 1000000)) == 0)
+						{
+							return;
+						}
+					}
+
+					// Let the driver catch up rather than overflow the input stream
+					uint32 size = (uint32) record.m_data.size();
+					while (size && (InputBufferSize - GetDataSize()) < size)
+					{
+						if (Wait::Single(_exitEvent, 1) == 0)
+						{
+							return;
+						}
+					}
+					if (size)
+					{
+						Put(const_cast<uint8*>(&record.m_data[0]), size);
+					}
+				}
+
+				Log::Write(LogLevel_Info, "Replay of %s finished in %d ms: %d frames, %d writes matched, %d differed", m_path.c_str(), (int32) ((TimeStamp::Now() - start) / 1000000), (int) m_records.size(), matched, differed);
+
+				// Keep accepting writes until the driver closes us
+				Wait::Single(_exitEvent);
+			}
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,87 @@
+//-----------------------------------------------------------------------------
+//
+//	ReplayController.h
+//
+//	Controller that plays back a capture file instead of talking to hardware
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _ReplayController_H
+#define _ReplayController_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include "Defs.h"
+#include "FrameCapture.h"
+#include "platform/Controller.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class Event;
+			class Mutex;
+			class Thread;
+
+			/** \brief Interface that replays a capture file recorded with the CaptureFile option.
+			 * \ingroup Platform
+			 *
+			 * The controller path passed to Manager::AddDriver is the capture file.  Inbound
+			 * records are fed to the driver with their recorded spacing, divided by the
+			 * ReplaySpeed option (0 feeds them as fast as possible).  When the next record
+			 * is outbound, playback waits until the driver writes a frame, compares the two
+			 * and then carries on timing from the moment of the write.  The driver therefore
+			 * sees the same conversation it had with the real controller, and the time it
+			 * takes to get through a capture measures the library rather than the radio.
+			 */
+			class ReplayController: public Controller
+			{
+				public:
+					ReplayController();
+					virtual ~ReplayController();
+
+					bool Open(string const& _controllerName);
+					bool Close();
+					uint32 Write(uint8* _buffer, uint32 _length);
+
+				private:
+					static void ReplayThreadEntryPoint(Event* _exitEvent, void* _context);
+					void ReplayThreadProc(Event* _exitEvent);
+
+					string m_path;
+					std::vector<FrameCapture::Record> m_records;
+					uint32 m_speed;
+					bool m_bOpen;
+
+					std::deque<std::vector<uint8> > m_written;		// Frames written by the driver that playback has not matched yet
+					Mutex* m_writtenMutex;
+					Event* m_writtenEvent;							// Set while m_written is not empty
+					Thread* m_thread;
+			};
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_ReplayController_H
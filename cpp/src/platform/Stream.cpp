@@ -26,7 +26,6 @@
 //
 //-----------------------------------------------------------------------------
 #include "platform/Stream.h"
-#include "platform/Mutex.h"
 #include "platform/Log.h"
 
 #include <string.h>
@@ -45,10 +44,10 @@ namespace OpenZWave
 //	Constructor
 //-----------------------------------------------------------------------------
 			Stream::Stream(uint32 _bufferSize) :
-					m_bufferSize(_bufferSize), m_signalSize(1), m_dataSize(0), m_head(0), m_tail(0), m_mutex(new Mutex())
+					m_bufferSize(_bufferSize), m_ringSize(_bufferSize + 1), m_signalSize(1), m_head(0), m_tail(0)
 			{
-				m_buffer = new uint8[m_bufferSize];
-				memset(m_buffer, 0x00, m_bufferSize);
+				m_buffer = new uint8[m_ringSize];
+				memset(m_buffer, 0x00, m_ringSize);
 			}
 
 //-----------------------------------------------------------------------------
@@ -57,7 +56,6 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			Stream::~Stream()
 			{
-				m_mutex->Release();
 				delete[] m_buffer;
 			}
 
@@ -67,7 +65,7 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void Stream::SetSignalThreshold(uint32 _size)
 			{
-				m_signalSize = _size;
+				m_signalSize.store(_size, std::memory_order_relaxed);
 				if (IsSignalled())
 				{
 					// We have more data than we are waiting for, so notify the watchers
@@ -81,35 +79,70 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			bool Stream::Get(uint8* _buffer, uint32 _size)
 			{
-				if (m_dataSize < _size)
+				if (GetDataSize() < _size)
 				{
 					// There is not enough data in the buffer to fulfill the request
 					Log::Write(LogLevel_Error, "ERROR: Not enough data in stream buffer");
 					return false;
 				}
 
-				m_mutex->Lock();
-				if ((m_tail + _size) > m_bufferSize)
+				Peek(_buffer, _size);
+				if (Log::IsLevelEnabled(LogLevel_StreamDetail))
+				{
+					LogData(_buffer, _size, "      Read (buffer->application): ");
+				}
+				return Consume(_size);
+			}
+
+//-----------------------------------------------------------------------------
+//	<Stream::Peek>
+//	Copy data from the buffer without removing it
+//-----------------------------------------------------------------------------
+			uint32 Stream::Peek(uint8* _buffer, uint32 _size)
+			{
+				uint32 tail = m_tail.load(std::memory_order_relaxed);
+				uint32 available = GetDataSize();
+				if (_size > available)
+				{
+					_size = available;
+				}
+
+				if ((tail + _size) > m_ringSize)
 				{
 					// We will have to wrap around
-					uint32 block1 = m_bufferSize - m_tail;
+					uint32 block1 = m_ringSize - tail;
 					uint32 block2 = _size - block1;
 
-					memcpy(_buffer, &m_buffer[m_tail], block1);
+					memcpy(_buffer, &m_buffer[tail], block1);
 					memcpy(&_buffer[block1], m_buffer, block2);
-					m_tail = block2;
 				}
 				else
 				{
 					// Requested data is in a contiguous block
-					memcpy(_buffer, &m_buffer[m_tail], _size);
-					m_tail += _size;
+					memcpy(_buffer, &m_buffer[tail], _size);
+				}
+				return _size;
+			}
+
+//-----------------------------------------------------------------------------
+//	<Stream::Consume>
+//	Remove data from the buffer without copying it
+//-----------------------------------------------------------------------------
+			bool Stream::Consume(uint32 _size)
+			{
+				if (GetDataSize() < _size)
+				{
+					return false;
 				}
 
-				LogData(_buffer, _size, "      Read (buffer->application): ");
+				uint32 tail = m_tail.load(std::memory_order_relaxed) + _size;
+				if (tail >= m_ringSize)
+				{
+					tail -= m_ringSize;
+				}
 
-				m_dataSize -= _size;
-				m_mutex->Unlock();
+				// Release so the producer does not reuse the space before we have read it
+				m_tail.store(tail, std::memory_order_release);
 				return true;
 			}
 
@@ -119,44 +152,48 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			bool Stream::Put(uint8* _buffer, uint32 _size)
 			{
-				if ((m_bufferSize - m_dataSize) < _size)
+				if ((m_bufferSize - GetDataSize()) < _size)
 				{
 					// There is not enough space left in the buffer for the data
 					Log::Write(LogLevel_Error, "ERROR: Not enough space in stream buffer");
 					return false;
 				}
 
-				m_mutex->Lock();
-				if ((m_head + _size) > m_bufferSize)
+				uint32 head = m_head.load(std::memory_order_relaxed);
+				if ((head + _size) > m_ringSize)
 				{
 					// We will have to wrap around
-					uint32 block1 = m_bufferSize - m_head;
+					uint32 block1 = m_ringSize - head;
 					uint32 block2 = _size - block1;
 
-					memcpy(&m_buffer[m_head], _buffer, block1);
+					memcpy(&m_buffer[head], _buffer, block1);
 					memcpy(m_buffer, &_buffer[block1], block2);
-					uint8 * logpos = m_buffer + m_head;
-					m_head = block2;
-					LogData(logpos, block1, "      Read (controller->buffer):  ");
-					LogData(m_buffer, block2, "      Read (controller->buffer):  ");
+					head = block2;
 				}
 				else
 				{
 					// There is enough space before we reach the end of the buffer
-					memcpy(&m_buffer[m_head], _buffer, _size);
-					m_head += _size;
-					LogData(m_buffer + m_head - _size, _size, "      Read (controller->buffer):  ");
+					memcpy(&m_buffer[head], _buffer, _size);
+					head += _size;
+					if (head == m_ringSize)
+					{
+						head = 0;
+					}
 				}
 
-				m_dataSize += _size;
+				// Release so the consumer sees the data before it sees the new head
+				m_head.store(head, std::memory_order_release);
+
+				if (Log::IsLevelEnabled(LogLevel_StreamDetail))
+				{
+					LogData(_buffer, _size, "      Read (controller->buffer):  ");
+				}
 
 				if (IsSignalled())
 				{
 					// We now have more data than we are waiting for, so notify the watchers
 					Notify();
 				}
-
-				m_mutex->Unlock();
 				return true;
 			}
 
@@ -166,9 +203,8 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void Stream::Purge()
 			{
-				m_tail = 0;
-				m_head = 0;
-				m_dataSize = 0;
+				// Only the consumer calls this, so discard everything the producer has written so far
+				m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
 			}
 
 //-----------------------------------------------------------------------------
@@ -177,7 +213,7 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			bool Stream::IsSignalled()
 			{
-				return (m_dataSize >= m_signalSize);
+				return (GetDataSize() >= m_signalSize.load(std::memory_order_relaxed));
 			}
 
 //-----------------------------------------------------------------------------
@@ -32,6 +32,7 @@
 #include "platform/Wait.h"
 
 #include <string>
+#include <atomic>
 
 namespace OpenZWave
 {
@@ -39,9 +40,12 @@ namespace OpenZWave
 	{
 		namespace Platform
 		{
-			class Mutex;
-
 			/** \brief Platform-independent definition of a circular buffer.
+			 *
+			 * The buffer has exactly one producer (the controller's read thread calling Put) and one
+			 * consumer (the driver thread calling Get, Peek, Consume, Purge and SetSignalThreshold).
+			 * The head index is only written by the producer and the tail index only by the consumer,
+			 * so neither side takes a lock.
 			 * \ingroup Platform
 			 */
 			class Stream: public Wait
@@ -75,6 +79,23 @@ namespace OpenZWave
 					 */
 					bool Get(uint8* _buffer, uint32 _size);
 
+					/**
+					 * Copies up to the requested amount of data from the stream without removing it.
+					 * \param _buffer pointer to a block of memory that will be filled with the stream data.
+					 * \param _size the maximum amount of data in bytes to copy from the stream.
+					 * \return the number of bytes copied.
+					 * \see Consume, Get
+					 */
+					uint32 Peek(uint8* _buffer, uint32 _size);
+
+					/**
+					 * Removes data from the stream without copying it, typically after a Peek.
+					 * \param _size the amount of data in bytes to remove.
+					 * \return true if the data was removed.  False if there was not enough data in the stream.
+					 * \see Peek, Get
+					 */
+					bool Consume(uint32 _size);
+
 					/**
 					 * Copies the requested amount of data from the buffer into the stream.
 					 * If there is insufficient room available in the stream's circular buffer, and no data is transferred.
@@ -93,7 +114,9 @@ namespace OpenZWave
 					 */
 					uint32 GetDataSize() const
 					{
-						return m_dataSize;
+						uint32 head = m_head.load(std::memory_order_acquire);
+						uint32 tail = m_tail.load(std::memory_order_acquire);
+						return (head >= tail) ? (head - tail) : (head + m_ringSize - tail);
 					}
 
 					/**
@@ -129,11 +152,10 @@ namespace OpenZWave
 
 					uint8* m_buffer;
 					uint32 m_bufferSize;
-					uint32 m_signalSize;
-					uint32 m_dataSize;
-					uint32 m_head;
-					uint32 m_tail;
-					Mutex* m_mutex;
+					uint32 m_ringSize;						// One more than m_bufferSize, so a full buffer can be told from an empty one
+					std::atomic<uint32> m_signalSize;
+					std::atomic<uint32> m_head;				// Next byte to write.  Only written by the producer.
+					std::atomic<uint32> m_tail;				// Next byte to read.  Only written by the consumer.
 			};
 		} // namespace Platform
 	} // namespace Internal
@@ -96,7 +96,16 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			int32 TimeStamp::operator-(TimeStamp const& _other)
 			{
-				return (int32) (m_pImpl - _other.m_pImpl);
+				return (int32) (*m_pImpl - *_other.m_pImpl);
+			}
+
+//-----------------------------------------------------------------------------
+//	<TimeStamp::Now>
+//	Get the current time of the monotonic clock in nanoseconds
+//-----------------------------------------------------------------------------
+			uint64 TimeStamp::Now()
+			{
+				return TimeStampImpl::Now();
 			}
 		} // namespace Platform
 	} // namespace Internal
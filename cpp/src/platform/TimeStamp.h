@@ -83,6 +83,14 @@ namespace OpenZWave
 					 */
 					int32 operator-(TimeStamp const& _other);
 
+					/**
+					 * Get the current time of a monotonic, high resolution clock.  This is
+					 * cheap to call and does not allocate, so it is suitable for tracing and
+					 * latency measurement.  Only differences between two values are meaningful.
+					 * \return time in nanoseconds.
+					 */
+					static uint64 Now();
+
 				private:
 					TimeStamp(TimeStamp const&);				// prevent copy
 					TimeStamp& operator =(TimeStamp const&);	// prevent assignment
@@ -29,6 +29,8 @@
 #include "Defs.h"
 #include "platform/Wait.h"
 #include "platform/Event.h"
+#include "platform/Mutex.h"
+#include "platform/TimeStamp.h"
 #include "platform/Log.h"
 
 #ifdef WIN32
@@ -126,7 +128,6 @@ namespace OpenZWave
 				}
 
 				int32 res = -1;	// Default to timeout result
-				string str = "";
 				if (waitEvent->Wait(_timeout))
 				{
 					// An object was signalled.  Run through the list
@@ -135,15 +136,11 @@ namespace OpenZWave
 					{
 						if (_objects[i]->IsSignalled())
 						{
-							if (res == -1)
-								res = (int32) i;
-							char buf[15];
-							snprintf(buf, sizeof(buf), "%d, ", i);
-							str += buf;
+							res = (int32) i;
+							break;
 						}
 					}
 				}
-//	Log::Write( LogLevel_Debug, "Wait::Multiple res=%d num=%d >%s", res, _numObjects, str.c_str() );
 
 				// Remove the watchers
 				for (i = 0; i < _numObjects; ++i)
@@ -165,6 +162,129 @@ namespace OpenZWave
 				Event* waitEvent = (Event*) _context;
 				waitEvent->Set();
 			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSet::WaitSet>
+//	Constructor
+//-----------------------------------------------------------------------------
+			WaitSet::WaitSet() :
+					m_numObjects(0), m_pending(0), m_candidates(0), m_pendingMutex(new Mutex()), m_wakeEvent(new Event()), m_deadline(new TimeStamp())
+			{
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSet::~WaitSet>
+//	Destructor
+//-----------------------------------------------------------------------------
+			WaitSet::~WaitSet()
+			{
+				for (uint32 i = 0; i < m_numObjects; ++i)
+				{
+					m_entries[i].m_object->RemoveWatcher(WaitSetCallback, &m_entries[i]);
+				}
+				delete m_deadline;
+				m_wakeEvent->Release();
+				m_pendingMutex->Release();
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSet::Add>
+//	Add an object to the set and start watching it
+//-----------------------------------------------------------------------------
+			int32 WaitSet::Add(Wait* _object)
+			{
+				if (m_numObjects >= MaxObjects)
+				{
+					assert(0);
+					return -1;
+				}
+
+				Entry& entry = m_entries[m_numObjects];
+				entry.m_owner = this;
+				entry.m_object = _object;
+				entry.m_bit = 1u << m_numObjects;
+
+				// The object has not been tested yet, so it is a candidate for the next wait
+				m_candidates |= entry.m_bit;
+				_object->AddWatcher(WaitSetCallback, &entry);
+				return (int32) m_numObjects++;
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSet::Multiple>
+//	Wait for one of the first _numObjects objects to become signalled.
+//-----------------------------------------------------------------------------
+			int32 WaitSet::Multiple(uint32 _numObjects, int32 _timeout // = -1
+					)
+			{
+				if (_numObjects > m_numObjects)
+				{
+					_numObjects = m_numObjects;
+				}
+				uint32 const mask = (_numObjects >= MaxObjects) ? 0xffffffff : ((1u << _numObjects) - 1);
+				bool deadlineSet = false;
+
+				while (true)
+				{
+					// Reset the wake event before collecting the pending bits.  A notification that
+					// arrives after this point either lands in this scan or sets the event again.
+					m_wakeEvent->Reset();
+					m_pendingMutex->Lock();
+					m_candidates |= m_pending;
+					m_pending = 0;
+					m_pendingMutex->Unlock();
+
+					// Only objects notified since they were last found to be unsignalled need testing.
+					// An object that is still signalled keeps its candidate bit for the next wait.
+					uint32 candidates = m_candidates & mask;
+					for (uint32 i = 0; candidates != 0; ++i)
+					{
+						uint32 const bit = 1u << i;
+						if (candidates & bit)
+						{
+							if (m_entries[i].m_object->IsSignalled())
+							{
+								return (int32) i;
+							}
+							m_candidates &= ~bit;
+							candidates &= ~bit;
+						}
+					}
+
+					int32 timeout = _timeout;
+					if (_timeout > 0)
+					{
+						if (!deadlineSet)
+						{
+							m_deadline->SetTime(_timeout);
+							deadlineSet = true;
+						}
+						timeout = m_deadline->TimeRemaining();
+						if (timeout < 0)
+						{
+							timeout = 0;
+						}
+					}
+					if ((_timeout == 0) || !m_wakeEvent->Wait(timeout))
+					{
+						return -1;
+					}
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSet::WaitSetCallback>
+//	Callback handler for the watchers added by WaitSet::Add
+//-----------------------------------------------------------------------------
+			void WaitSet::WaitSetCallback(void* _context)
+			{
+				Entry* entry = (Entry*) _context;
+				WaitSet* owner = entry->m_owner;
+				owner->m_pendingMutex->Lock();
+				owner->m_pending |= entry->m_bit;
+				owner->m_pendingMutex->Unlock();
+				owner->m_wakeEvent->Set();
+			}
 		} // namespace Platform
 	} // namespace Internal
 } // namespace OpenZWave
@@ -39,6 +39,9 @@ namespace OpenZWave
 		namespace Platform
 		{
 			class WaitImpl;
+			class Event;
+			class Mutex;
+			class TimeStamp;
 
 			/** \brief Platform-independent definition of Wait objects.
 			 * \ingroup Platform
@@ -47,6 +50,7 @@ namespace OpenZWave
 			{
 					friend class WaitImpl;
 					friend class ThreadImpl;
+					friend class WaitSet;
 
 				public:
 					enum
@@ -114,6 +118,73 @@ namespace OpenZWave
 
 					WaitImpl* m_pImpl;					// Pointer to an object that encapsulates the platform-specific implementation of a Wait object.
 			};
+
+			/** \brief A persistent set of Wait objects for threads that wait on the same objects in a loop.
+			 *
+			 * Wait::Multiple allocates an Event and adds and removes a watcher on every object each time
+			 * it is called, then polls every object to find the signalled one.  A WaitSet registers its
+			 * watchers once.  Each watcher records which object notified it, so a wait only has to test
+			 * the objects that have been signalled since the previous wait.
+			 * \ingroup Platform
+			 */
+			class WaitSet
+			{
+				public:
+					enum
+					{
+						MaxObjects = 32
+					};
+
+					WaitSet();
+					~WaitSet();
+
+					/**
+					 * Add an object to the set.  Objects are numbered in the order they are added, and
+					 * remain in the set (and referenced) until the WaitSet is destroyed.
+					 * \param _object pointer to the object to wait on.
+					 * \return index of the object in the set, or -1 if the set is full.
+					 */
+					int32 Add(Wait* _object);
+
+					/**
+					 * Get the number of objects in the set.
+					 */
+					uint32 GetCount() const
+					{
+						return m_numObjects;
+					}
+
+					/**
+					 * Wait for one of the first _numObjects objects in the set to become signalled.  If more than
+					 * one object is in a signalled state, the lowest index will be returned.
+					 * \param _numObjects number of objects (counting from index zero) to wait on.
+					 * \param _timeout optional maximum time to wait.  Defaults to -1, which means wait forever.
+					 * \return index of the object that was signalled, -1 if the wait timed out.
+					 * \see Wait::Multiple
+					 */
+					int32 Multiple(uint32 _numObjects, int32 _timeout = -1);
+
+				private:
+					WaitSet(WaitSet const&);					// prevent copy
+					WaitSet& operator =(WaitSet const&);		// prevent assignment
+
+					static void WaitSetCallback(void* _context);
+
+					struct Entry
+					{
+							WaitSet* m_owner;
+							Wait* m_object;
+							uint32 m_bit;
+					};
+
+					Entry m_entries[MaxObjects];
+					uint32 m_numObjects;
+					uint32 m_pending;					// Objects notified since the last wait.  Protected by m_pendingMutex.
+					uint32 m_candidates;				// Objects that may be signalled.  Only used by the waiting thread.
+					Mutex* m_pendingMutex;
+					Event* m_wakeEvent;					// Set whenever any object in the set is notified
+					TimeStamp* m_deadline;
+			};
 		} // namespace Platform
 	} // namespace Internal
 } // namespace OpenZWave
@@ -29,10 +29,20 @@
 #include "EventImpl.h"
 
 #include <stdio.h>
-#include <sys/time.h>
+#include <time.h>
 #ifdef __ANDROID__
 #include "android.h"
 #endif
+
+// Timed waits are measured against the monotonic clock so they are not
+// stretched or cut short by changes to the wall clock.  macOS has no
+// pthread_condattr_setclock, so it stays on the realtime clock.
+#if defined(CLOCK_MONOTONIC) && !defined(__APPLE__)
+#define OZW_EVENT_CLOCK CLOCK_MONOTONIC
+#else
+#define OZW_EVENT_CLOCK CLOCK_REALTIME
+#endif
+
 namespace OpenZWave
 {
 	namespace Internal
@@ -57,6 +67,9 @@ namespace OpenZWave
 				pthread_condattr_init(&ca);
 #ifndef __NetBSD__
 				pthread_condattr_setpshared(&ca, PTHREAD_PROCESS_PRIVATE);
+#endif
+#if !defined(__APPLE__)
+				pthread_condattr_setclock(&ca, OZW_EVENT_CLOCK);
 #endif
 				pthread_cond_init(&m_condition, &ca);
 				pthread_condattr_destroy(&ca);
@@ -179,26 +192,23 @@ namespace OpenZWave
 					}
 					else if (_timeout > 0)
 					{
-						struct timeval now;
 						struct timespec abstime;
 
-						gettimeofday(&now, NULL);
+						clock_gettime(OZW_EVENT_CLOCK, &abstime);
 
-						abstime.tv_sec = now.tv_sec + (_timeout / 1000);
+						abstime.tv_sec += (_timeout / 1000);
 
-						// Now add the remainder of our timeout to the microseconds part of 'now'
-						now.tv_usec += (_timeout % 1000) * 1000;
+						// Now add the remainder of our timeout to the nanoseconds part
+						abstime.tv_nsec += (_timeout % 1000) * 1000000L;
 
 						// Careful now! Did it wrap?
-						while (now.tv_usec >= (1000 * 1000))
+						while (abstime.tv_nsec >= 1000000000L)
 						{
 							// Yes it did so bump our seconds and subtract
-							now.tv_usec -= (1000 * 1000);
+							abstime.tv_nsec -= 1000000000L;
 							abstime.tv_sec++;
 						}
 
-						abstime.tv_nsec = now.tv_usec * 1000;
-
 						while (!m_isSignaled)
 						{
 							int oldstate;
@@ -61,23 +61,24 @@ namespace OpenZWave
 			void TimeStampImpl::SetTime(int32 _milliseconds	// = 0
 					)
 			{
-				struct timeval now;
-				gettimeofday(&now, NULL);
+				clock_gettime(OZW_TIMESTAMP_CLOCK, &m_stamp);
 
-				m_stamp.tv_sec = now.tv_sec + (_milliseconds / 1000);
+				m_stamp.tv_sec += (_milliseconds / 1000);
 
-				// Now add the remainder of our timeout to the microseconds part of 'now'
-				now.tv_usec += ((_milliseconds % 1000) * 1000);
+				// Now add the remainder of our timeout to the nanoseconds part
+				m_stamp.tv_nsec += ((_milliseconds % 1000) * 1000000L);
 
-				// Careful now! Did it wrap?
-				if (now.tv_usec >= 1000000)
+				// Careful now! Did it wrap?  (The remainder is negative for negative offsets)
+				if (m_stamp.tv_nsec >= 1000000000L)
 				{
-					// Yes it did so bump our seconds and modulo
-					now.tv_usec %= 1000000;
+					m_stamp.tv_nsec -= 1000000000L;
 					m_stamp.tv_sec++;
 				}
-
-				m_stamp.tv_nsec = now.tv_usec * 1000;
+				else if (m_stamp.tv_nsec < 0)
+				{
+					m_stamp.tv_nsec += 1000000000L;
+					m_stamp.tv_sec--;
+				}
 			}
 
 //-----------------------------------------------------------------------------
@@ -86,18 +87,11 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			int32 TimeStampImpl::TimeRemaining()
 			{
-				int32 diff;
-
-				struct timeval now;
-				gettimeofday(&now, NULL);
-
-				// Seconds
-				diff = (int32) ((m_stamp.tv_sec - now.tv_sec) * 1000);
-
-				// Milliseconds
-				diff += (((m_stamp.tv_nsec / 1000) - now.tv_usec) / 1000);
+				struct timespec now;
+				clock_gettime(OZW_TIMESTAMP_CLOCK, &now);
 
-				return diff;
+				int64 diff = ((int64) (m_stamp.tv_sec - now.tv_sec)) * 1000000000LL + (m_stamp.tv_nsec - now.tv_nsec);
+				return (int32) (diff / 1000000LL);
 			}
 
 //-----------------------------------------------------------------------------
@@ -106,14 +100,24 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			std::string TimeStampImpl::GetAsString()
 			{
+				// The stamp is on the monotonic clock, so translate it to wall clock
+				// time by applying its distance from now.
+				struct timespec now, wall;
+				clock_gettime(OZW_TIMESTAMP_CLOCK, &now);
+				clock_gettime(CLOCK_REALTIME, &wall);
+				int64 offset = ((int64) (now.tv_sec - m_stamp.tv_sec)) * 1000000000LL + (now.tv_nsec - m_stamp.tv_nsec);
+				int64 stamp = ((int64) wall.tv_sec) * 1000000000LL + wall.tv_nsec - offset;
+				time_t secs = (time_t) (stamp / 1000000000LL);
+				int msecs = (int) ((stamp % 1000000000LL) / 1000000LL);
+
 				char str[100];
 				// use threadsafe verion of localtime. Reported by nihilus, 2019-04
 				// https://www.gnu.org/software/libc/manual/html_node/Broken_002ddown-Time.html#Broken_002ddown-Time
 				struct tm *tm, xtm;
 				memset(&xtm, 0, sizeof(xtm));
-				tm = localtime_r(&m_stamp.tv_sec, &xtm);
+				tm = localtime_r(&secs, &xtm);
 
-				snprintf(str, sizeof(str), "%04d-%02d-%02d %02d:%02d:%02d:%03d ", tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, (int) (m_stamp.tv_nsec / (1000 * 1000)));
+				snprintf(str, sizeof(str), "%04d-%02d-%02d %02d:%02d:%02d:%03d ", tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, msecs);
 				return str;
 			}
 
@@ -132,6 +136,17 @@ namespace OpenZWave
 
 				return diff;
 			}
+
+//-----------------------------------------------------------------------------
+//	<TimeStampImpl::Now>
+//	Get the current time of the monotonic clock in nanoseconds
+//-----------------------------------------------------------------------------
+			uint64 TimeStampImpl::Now()
+			{
+				struct timespec now;
+				clock_gettime(OZW_TIMESTAMP_CLOCK, &now);
+				return ((uint64) now.tv_sec) * 1000000000ULL + (uint64) now.tv_nsec;
+			}
 		} // namespace Platform
 	} // namespace Internal
 } // namespace OpenZWave
@@ -33,6 +33,14 @@
 #include <sys/time.h>
 #include "Defs.h"
 
+// Timestamps are taken from a clock that is not affected by changes to the
+// wall clock (NTP steps, manual changes), so timeouts and intervals stay correct.
+#ifdef CLOCK_MONOTONIC
+#define OZW_TIMESTAMP_CLOCK CLOCK_MONOTONIC
+#else
+#define OZW_TIMESTAMP_CLOCK CLOCK_REALTIME
+#endif
+
 namespace OpenZWave
 {
 	namespace Internal
@@ -82,6 +90,11 @@ namespace OpenZWave
 					 */
 					int32 operator-(TimeStampImpl const& _other);
 
+					/**
+					 * Get the current time of the monotonic clock in nanoseconds.
+					 */
+					static uint64 Now();
+
 				private:
 					TimeStampImpl(TimeStampImpl const&);					// prevent copy
 					TimeStampImpl& operator =(TimeStampImpl const&);			// prevent assignment
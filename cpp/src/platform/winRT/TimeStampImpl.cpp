@@ -104,6 +104,18 @@ namespace OpenZWave
 			{
 				return (int32) ((m_stamp - _other.m_stamp) / 10000LL);
 			}
+
+//-----------------------------------------------------------------------------
+//	<TimeStampImpl::Now>
+//	Get the current time of the monotonic clock in nanoseconds
+//-----------------------------------------------------------------------------
+			uint64 TimeStampImpl::Now()
+			{
+				LARGE_INTEGER frequency, counter;
+				QueryPerformanceFrequency(&frequency);
+				QueryPerformanceCounter(&counter);
+				return (uint64) ((counter.QuadPart / frequency.QuadPart) * 1000000000ULL + ((counter.QuadPart % frequency.QuadPart) * 1000000000ULL) / frequency.QuadPart);
+			}
 		} // namespace Platform
 	} // namespace Internal
 } // namespace OpenZWave
@@ -156,14 +156,14 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void LogImpl::Write(LogLevel _logLevel, uint8 const _nodeId, char const* _format, va_list _args)
 			{
-				// create a timestamp string
-				string timeStr = GetTimeStampString();
-				string nodeStr = GetNodeString(_nodeId);
-				string logLevelStr = GetLogLevelString(_logLevel);
-
 				// handle this message
 				if ((_logLevel <= m_queueLevel) || (_logLevel == LogLevel_Internal))	// we're going to do something with this message...
 				{
+					// create a timestamp string
+					string timeStr = GetTimeStampString();
+					string nodeStr = GetNodeString(_nodeId);
+					string logLevelStr = GetLogLevelString(_logLevel);
+
 					char lineBuf[1024];
 					if (!_format || (_format[0] == 0))
 					{
@@ -80,6 +80,11 @@ namespace OpenZWave
 					 */
 					int32 operator-(TimeStampImpl const& _other);
 
+					/**
+					 * Get the current time of the monotonic clock in nanoseconds.
+					 */
+					static uint64 Now();
+
 				private:
 					TimeStampImpl(TimeStampImpl const&);			// prevent copy
 					TimeStampImpl& operator =(TimeStampImpl const&);	// prevent assignment
@@ -37,7 +37,11 @@
 #include "platform/Log.h"
 #include "command_classes/CommandClass.h"
 #include <ctime>
+#include <math.h>
 #include "Options.h"
+#include "Utils.h"
+#include "ValueTable.h"
+#include "ValueHistory.h"
 
 namespace OpenZWave
 {
@@ -57,7 +61,7 @@ namespace OpenZWave
 // Constructor
 //-----------------------------------------------------------------------------
 			Value::Value(uint32 const _homeId, uint8 const _nodeId, ValueID::ValueGenre const _genre, uint8 const _commandClassId, uint8 const _instance, uint16 const _index, ValueID::ValueType const _type, string const& _label, string const& _units, bool const _readOnly, bool const _writeOnly, bool const _isSet, uint8 const _pollIntensity) :
-					m_min(0), m_max(0), m_refreshTime(0), m_verifyChanges(false), m_refreshAfterSet(true), m_id(_homeId, _nodeId, _genre, _commandClassId, _instance, _index, _type), m_targetValueSet(false), m_duration(0), m_units(_units), m_readOnly(_readOnly), m_writeOnly(_writeOnly), m_isSet(_isSet), m_affectsLength(0), m_affects(), m_affectsAll(false), m_checkChange(false), m_pollIntensity(_pollIntensity)
+					m_min(0), m_max(0), m_refreshTime(0), m_verifyChanges(false), m_refreshAfterSet(true), m_id(_homeId, _nodeId, _genre, _commandClassId, _instance, _index, _type), m_targetValueSet(false), m_duration(0), m_transitionStart(0), m_transitionEnd(0), m_units(_units), m_readOnly(_readOnly), m_writeOnly(_writeOnly), m_isSet(_isSet), m_affectsLength(0), m_affects(), m_affectsAll(false), m_checkChange(false), m_pollIntensity(_pollIntensity), m_notifyDeadband(0), m_notifyMinInterval(0), m_notifyTrailingEdge(false)
 			{
 				SetLabel(_label);
 				if (Driver* driver = Manager::Get()->GetDriver(m_id.GetHomeId()))
@@ -71,7 +75,7 @@ namespace OpenZWave
 // Constructor (from XML)
 //-----------------------------------------------------------------------------
 			Value::Value() :
-					m_min(0), m_max(0), m_refreshTime(0), m_verifyChanges(false), m_refreshAfterSet(true), m_targetValueSet(false), m_duration(0), m_readOnly(false), m_writeOnly(false), m_isSet(false), m_affectsLength(0), m_affects(), m_affectsAll(false), m_checkChange(false), m_pollIntensity(0)
+					m_min(0), m_max(0), m_refreshTime(0), m_verifyChanges(false), m_refreshAfterSet(true), m_targetValueSet(false), m_duration(0), m_transitionStart(0), m_transitionEnd(0), m_readOnly(false), m_writeOnly(false), m_isSet(false), m_affectsLength(0), m_affects(), m_affectsAll(false), m_checkChange(false), m_pollIntensity(0), m_notifyDeadband(0), m_notifyMinInterval(0), m_notifyTrailingEdge(false)
 			{
 			}
 
@@ -85,6 +89,7 @@ namespace OpenZWave
 				{
 					delete[] m_affects;
 				}
+				delete m_history.m_history.load();
 			}
 
 //-----------------------------------------------------------------------------
@@ -202,6 +207,23 @@ namespace OpenZWave
 					m_verifyChanges = !strcmp(verifyChanges, "true");
 				}
 
+				double dblVal;
+				if (TIXML_SUCCESS == _valueElement->QueryDoubleAttribute("notify_deadband", &dblVal))
+				{
+					m_notifyDeadband = dblVal;
+				}
+
+				if (TIXML_SUCCESS == _valueElement->QueryIntAttribute("notify_interval", &intVal))
+				{
+					m_notifyMinInterval = intVal;
+				}
+
+				char const* notifyTrailing = _valueElement->Attribute("notify_trailing");
+				if (notifyTrailing)
+				{
+					m_notifyTrailingEdge = !strcmp(notifyTrailing, "true");
+				}
+
 				if (TIXML_SUCCESS == _valueElement->QueryIntAttribute("min", &intVal))
 				{
 					m_min = intVal;
@@ -251,6 +273,17 @@ namespace OpenZWave
 				_valueElement->SetAttribute("write_only", m_writeOnly ? "true" : "false");
 				_valueElement->SetAttribute("verify_changes", m_verifyChanges ? "true" : "false");
 
+				if (m_notifyDeadband > 0)
+				{
+					_valueElement->SetDoubleAttribute("notify_deadband", m_notifyDeadband);
+				}
+				if (m_notifyMinInterval > 0)
+				{
+					snprintf(str, sizeof(str), "%d", m_notifyMinInterval);
+					_valueElement->SetAttribute("notify_interval", str);
+					_valueElement->SetAttribute("notify_trailing", m_notifyTrailingEdge ? "true" : "false");
+				}
+
 				snprintf(str, sizeof(str), "%d", m_pollIntensity);
 				_valueElement->SetAttribute("poll_intensity", str);
 
@@ -304,16 +337,23 @@ namespace OpenZWave
 					{
 						if (Internal::CC::CommandClass* cc = node->GetCommandClass(m_id.GetCommandClassId()))
 						{
-							Log::Write(LogLevel_Info, m_id.GetNodeId(), "Value::Set - %s - %s - %d - %d - %s", cc->GetCommandClassName().c_str(), this->GetLabel().c_str(), m_id.GetIndex(), m_id.GetInstance(), this->GetAsString().c_str());
+							if (Log::IsLevelEnabled(LogLevel_Info))
+							{
+								Log::Write(LogLevel_Info, m_id.GetNodeId(), "Value::Set - %s - %s - %d - %d - %s", cc->GetCommandClassName().c_str(), this->GetLabel().c_str(), m_id.GetIndex(), m_id.GetInstance(), this->GetAsString().c_str());
+							}
 							// flag value as set and queue a "Set Value" message for transmission to the device
+							driver->BeginValueSet(m_id, this);
 							res = cc->SetValue(*this);
+							bool const supervised = driver->EndValueSet();
 
 							if (res)
 							{
 								if (!IsWriteOnly())
 								{
-									// queue a "RequestValue" message to update the value
-									if (m_refreshAfterSet) {
+									// queue a "RequestValue" message to update the value, unless the
+									// node will confirm the Set with a Supervision Report instead.  The
+									// report is followed by the Get if the Set was not of a literal state.
+									if (m_refreshAfterSet && !supervised) {
 										cc->RequestValue( 0, m_id.GetIndex(), m_id.GetInstance(), Driver::MsgQueue_Send );
 									}
 								}
@@ -355,13 +395,12 @@ namespace OpenZWave
 					return;
 				}
 
-				if (Driver* driver = Manager::Get()->GetDriver(m_id.GetHomeId()))
+				Driver* driver = m_owner.m_driver ? m_owner.m_driver : Manager::Get()->GetDriver(m_id.GetHomeId());
+				if (driver)
 				{
 					m_isSet = true;
 
-					bool bSuppress;
-					Options::Get()->GetOptionAsBool("SuppressValueRefresh", &bSuppress);
-					if (!bSuppress)
+					if (!driver->m_suppressValueRefresh && !IsNotificationFiltered(NotifyFilter_Refreshed))
 					{
 						// Notify the watchers
 						Notification* notification = new Notification(Notification::Type_ValueRefreshed);
@@ -382,21 +421,30 @@ namespace OpenZWave
 					return;
 				}
 
-				if (Driver* driver = Manager::Get()->GetDriver(m_id.GetHomeId()))
+				Driver* driver = m_owner.m_driver ? m_owner.m_driver : Manager::Get()->GetDriver(m_id.GetHomeId());
+				if (driver)
 				{
 					m_isSet = true;
 
 					// Notify the watchers
-					Notification* notification = new Notification(Notification::Type_ValueChanged);
-					notification->SetValueId(m_id);
-					driver->QueueNotification(notification);
+					if (!IsNotificationFiltered(NotifyFilter_Changed))
+					{
+						Notification* notification = new Notification(Notification::Type_ValueChanged);
+						notification->SetValueId(m_id);
+						driver->QueueNotification(notification);
+					}
 				}
 				/* Call Back to the Command Class that this Value has changed, so we can search the
 				 * TriggerRefreshValue vector to see if we should request any other values to be
 				 * refreshed.
 				 */
+				if (m_owner.m_commandClass)
+				{
+					m_owner.m_commandClass->CheckForRefreshValues(this);
+					return;
+				}
 				Node* node = NULL;
-				if (Driver* driver = Manager::Get()->GetDriver(m_id.GetHomeId()))
+				if (driver)
 				{
 					node = driver->GetNodeUnsafe(m_id.GetNodeId());
 					if (node != NULL)
@@ -410,6 +458,127 @@ namespace OpenZWave
 
 			}
 
+//-----------------------------------------------------------------------------
+// <Value::OnValueUpdated>
+// Called by the typed values once a report has been stored
+//-----------------------------------------------------------------------------
+			void Value::OnValueUpdated()
+			{
+				Internal::ValueTable::Publish(this);
+
+				Driver* driver = m_owner.m_driver;
+				double value;
+				if (driver && driver->m_valueHistorySize && GetNumericValue(&value))
+				{
+					Internal::ValueHistory* history = m_history.m_history.load(std::memory_order_relaxed);
+					if (!history)
+					{
+						history = new Internal::ValueHistory(driver->m_valueHistorySize, driver->m_valueHistoryResolution);
+						m_history.m_history.store(history, std::memory_order_release);
+					}
+					history->Add(Internal::ValueHistory::Now(), value);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <Value::SetNotificationFilter>
+// Configure the deadband and rate limit applied to notifications for this value
+//-----------------------------------------------------------------------------
+			void Value::SetNotificationFilter(double const _deadband, int32 const _minInterval, bool const _trailingEdge)
+			{
+				m_notifyDeadband = _deadband > 0 ? _deadband : 0;
+				m_notifyMinInterval = _minInterval > 0 ? _minInterval : 0;
+				m_notifyTrailingEdge = _trailingEdge;
+				Log::Write(LogLevel_Info, m_id.GetNodeId(), "Notification filter for %s: deadband %.3f, minimum interval %dms%s", GetLabel().c_str(), m_notifyDeadband, m_notifyMinInterval, m_notifyTrailingEdge ? ", trailing edge" : "");
+			}
+
+//-----------------------------------------------------------------------------
+// <Value::IsNotificationFiltered>
+// Check whether a notification should be held back by the deadband or rate
+// limit.  Returns false (and records the notification) if it should be sent.
+//-----------------------------------------------------------------------------
+			bool Value::IsNotificationFiltered(uint32 const _filter)
+			{
+				if (m_notifyDeadband <= 0 && m_notifyMinInterval <= 0)
+				{
+					return false;
+				}
+
+				NotifyFilterState& state = m_notifyState[_filter];
+				double value = 0;
+				bool numeric = GetNumericValue(&value);
+				if (state.m_sent)
+				{
+					if (m_notifyDeadband > 0 && numeric && fabs(value - state.m_sentValue) < m_notifyDeadband)
+					{
+						return true;
+					}
+					if (m_notifyMinInterval > 0)
+					{
+						int32 elapsed = -state.m_sentTS.TimeRemaining();
+						if (elapsed < m_notifyMinInterval)
+						{
+							if (m_notifyTrailingEdge && !state.m_trailingPending)
+							{
+								state.m_trailingPending = true;
+								TimerThread::TimerCallback callback = bind(&Value::sendTrailingNotification, this, _filter);
+								TimerSetEvent(m_notifyMinInterval - elapsed, callback, 2 + _filter);
+							}
+							return true;
+						}
+					}
+				}
+
+				state.m_sent = true;
+				state.m_sentValue = value;
+				state.m_sentTS.SetTime();
+				return false;
+			}
+
+//-----------------------------------------------------------------------------
+// <Value::GetNumericValue>
+// Get the value as a number.  Only the numeric types have one.
+//-----------------------------------------------------------------------------
+			bool Value::GetNumericValue(double* o_value) const
+			{
+				return false;
+			}
+
+//-----------------------------------------------------------------------------
+// <Value::sendTrailingNotification>
+// Callback from the Timer to deliver the last value held back by the rate limit
+//-----------------------------------------------------------------------------
+			void Value::sendTrailingNotification(uint32 _filter)
+			{
+				// Like the other timer callbacks, this runs without the node mutex, as
+				// threads holding it set timer events
+				if (Driver* driver = Manager::Get()->GetDriver(m_id.GetHomeId()))
+				{
+					NotifyFilterState& state = m_notifyState[_filter];
+					state.m_trailingPending = false;
+
+					double value = 0;
+					bool numeric = GetNumericValue(&value);
+					if (_filter == NotifyFilter_Changed && numeric && value == state.m_sentValue)
+					{
+						// Nothing has changed since the last notification
+						return;
+					}
+					if (m_notifyDeadband > 0 && numeric && fabs(value - state.m_sentValue) < m_notifyDeadband)
+					{
+						return;
+					}
+
+					state.m_sent = true;
+					state.m_sentValue = value;
+					state.m_sentTS.SetTime();
+
+					Notification* notification = new Notification(_filter == NotifyFilter_Changed ? Notification::Type_ValueChanged : Notification::Type_ValueRefreshed);
+					notification->SetValueId(m_id);
+					driver->QueueNotification(notification);
+				}
+			}
+
 //-----------------------------------------------------------------------------
 // <Value::GetGenreEnumFromName>
 // Static helper to get a genre enum from a string
@@ -576,7 +745,12 @@ namespace OpenZWave
 				 */
 				if (m_targetValueSet)
 				{
-					return CheckTargetValue(_newValue, _targetValue, _type, _newValueLength, _targetValueLength);
+					int result = CheckTargetValue(_newValue, _targetValue, _type, _newValueLength, _targetValueLength);
+					if (result >= 0)
+					{
+						return result;
+					}
+					// The transition is over, so treat the report as an ordinary one
 				}
 
 
@@ -780,37 +954,162 @@ namespace OpenZWave
 					 * can handle situations where Target Value is not supplied in the future
 					 */
 					m_targetValueSet = false;
+					m_transitionEnd = 0;
 
 					Value::OnValueChanged();
 					return 2;				// confirmed change of value
 				}
-				/* They are not equal - So we need to issue a Get, But lets pace the timing of the Get based on Duration
-				 * - Caveat here is that if the outgoing queue is large, then this will be additionally delayed
-				 */
-				int32 timeout;
-				if (m_duration <= 2) 
-				{
-					timeout = 250;
-				}
-				else if (m_duration <= 5) 
+
+				uint64 now = Internal::Platform::TimeStamp::Now() / 1000000;
+				if (m_transitionEnd != 0 && now >= m_transitionEnd)
 				{
-					/* for Durations less than 5 seconds, lets refresh every 1/2 seconds
+					/* The node should have reached the Target Value by now, so this is where it settled
+					 * (or the Target is one it never reports, such as 0xFF for "last level")
 					 */
-					timeout = 500;
-				} 
-				else 
+					Log::Write(LogLevel_Info, m_id.GetNodeId(), "Transition is over but the Target Value was not reached");
+					m_targetValueSet = false;
+					m_transitionEnd = 0;
+					return -1;
+				}
+
+				/* Interpolate from the level just reported */
+				if (!m_transitionTo.empty())
 				{
-					/* Everything else is 1 second 
-					 */
-					timeout = 1000;
+					char str[16];
+					switch (_type)
+					{
+						case ValueID::ValueType_Byte:
+							snprintf(str, sizeof(str), "%d", *((uint8*) _newValue));
+							m_transitionFrom = str;
+							break;
+						case ValueID::ValueType_Short:
+							snprintf(str, sizeof(str), "%d", *((short*) _newValue));
+							m_transitionFrom = str;
+							break;
+						case ValueID::ValueType_Int:
+							snprintf(str, sizeof(str), "%d", *((int32*) _newValue));
+							m_transitionFrom = str;
+							break;
+						case ValueID::ValueType_Decimal:
+						case ValueID::ValueType_String:
+							m_transitionFrom = *((string*) _newValue);
+							break;
+						default:
+							break;
+					}
+					m_transitionStart = now;
 				}
 
+				/* Refresh the value once, when the node should be done.  This replaces any refresh
+				 * scheduled by an earlier report, so the node is not polled while it is ramping.
+				 * If the node did not say how long it will take, check back every second.
+				 */
+				int32 timeout = 1000;
+				if (m_transitionEnd != 0)
+				{
+					timeout = (int32) (m_transitionEnd - now) + TransitionRefreshMargin;
+				}
+				TimerDelEvent(1);
 				TimerThread::TimerCallback callback = bind(&Value::sendValueRefresh, this, 1);
 				TimerSetEvent(timeout, callback, 1);
 				/* signal that the value hasn't changed */
 				return 0;
 			}
 
+//-----------------------------------------------------------------------------
+// <Value::StartTransition>
+// The node is moving towards a Target Value, and will take _duration seconds
+//-----------------------------------------------------------------------------
+			void Value::StartTransition(uint32 const _duration, string const& _target)
+			{
+				uint64 now = Internal::Platform::TimeStamp::Now() / 1000000;
+				m_targetValueSet = true;
+				m_duration = _duration;
+				m_transitionStart = now;
+				/* a duration of -1 is unknown */
+				m_transitionEnd = (_duration == (uint32) -1) ? 0 : now + (uint64) _duration * 1000;
+				m_transitionFrom = _target.empty() ? "" : GetAsString();
+				m_transitionTo = _target;
+			}
+
+//-----------------------------------------------------------------------------
+// <Value::IsInTransition>
+// Whether the node should still be moving towards the Target Value
+//-----------------------------------------------------------------------------
+			bool Value::IsInTransition() const
+			{
+				if (!m_targetValueSet || m_transitionEnd == 0)
+				{
+					return false;
+				}
+				uint64 now = Internal::Platform::TimeStamp::Now() / 1000000;
+				return now < m_transitionEnd + TransitionRefreshMargin;
+			}
+
+//-----------------------------------------------------------------------------
+// <Value::GetTransition>
+// Estimate the level a value in a transition has reached
+//-----------------------------------------------------------------------------
+			bool Value::GetTransition(string* o_estimate, uint32* o_remaining) const
+			{
+				if (!IsInTransition())
+				{
+					return false;
+				}
+
+				uint64 now = Internal::Platform::TimeStamp::Now() / 1000000;
+				uint64 end = m_transitionEnd;
+				uint64 start = m_transitionStart;
+				if (o_remaining)
+				{
+					*o_remaining = (now < end) ? (uint32) (end - now) : 0;
+				}
+				if (!o_estimate)
+				{
+					return true;
+				}
+
+				*o_estimate = GetAsString();
+				string from = m_transitionFrom;
+				string to = m_transitionTo;
+				if (to.empty() || from.empty() || end <= start)
+				{
+					return true;
+				}
+				double progress = (now <= start) ? 0 : (now >= end) ? 1 : (double) (now - start) / (double) (end - start);
+
+				if (from[0] == '#' && from.length() == to.length())
+				{
+					/* a color: interpolate each channel */
+					string estimate = "#";
+					for (size_t i = 1; i + 1 < from.length(); i += 2)
+					{
+						long f = strtol(from.substr(i, 2).c_str(), NULL, 16);
+						long t = strtol(to.substr(i, 2).c_str(), NULL, 16);
+						char str[3];
+						snprintf(str, sizeof(str), "%.2X", (unsigned int) (f + (t - f) * progress + 0.5) & 0xff);
+						estimate += str;
+					}
+					*o_estimate = estimate;
+					return true;
+				}
+
+				char* fromEnd;
+				char* toEnd;
+				double f = strtod(from.c_str(), &fromEnd);
+				double t = strtod(to.c_str(), &toEnd);
+				if (*fromEnd == 0 && *toEnd == 0)
+				{
+					/* a number: keep the precision of the Target Value */
+					size_t point = to.find('.');
+					int precision = (point == string::npos) ? 0 : (int) (to.length() - point - 1);
+					char str[32];
+					snprintf(str, sizeof(str), "%.*f", precision, f + (t - f) * progress);
+					*o_estimate = str;
+				}
+				return true;
+			}
+
 //-----------------------------------------------------------------------------
 // <Value::sendValueRefresh>
 // Callback from the Timer to send a Get value to refresh a value from the 
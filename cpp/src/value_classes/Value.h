@@ -29,10 +29,12 @@
 #define _Value_H
 
 #include <string>
+#include <atomic>
 #ifdef __FreeBSD__
 #include <time.h>
 #endif
 #include "Defs.h"
+#include "MemoryAccounting.h"
 #include "TimerThread.h"
 #include "platform/Ref.h"
 #include "value_classes/ValueID.h"
@@ -45,6 +47,12 @@ namespace OpenZWave
 	class Driver;
 	namespace Internal
 	{
+		class ValueTable;
+		class ValueHistory;
+		namespace CC
+		{
+			class CommandClass;
+		}
 		namespace VC
 		{
 
@@ -55,10 +63,19 @@ namespace OpenZWave
 			{
 					friend class OpenZWave::Driver;
 					friend class ValueStore;
+					friend class Internal::ValueTable;
 
 				public:
 					Value(uint32 const _homeId, uint8 const _nodeId, ValueID::ValueGenre const _genre, uint8 const _commandClassId, uint8 const _instance, uint16 const _index, ValueID::ValueType const _type, string const& _label, string const& _units, bool const _readOnly, bool const _writeOnly, bool const _isset, uint8 const _pollIntensity);
 					Value();
+					static void* operator new(size_t _size)
+					{
+						return Internal::MemoryAccounting::Allocate(_size, Internal::MemoryAccounting::Category_Value);
+					}
+					static void operator delete(void* _ptr)
+					{
+						Internal::MemoryAccounting::Free(_ptr);
+					}
 
 					virtual void ReadXML(uint32 const _homeId, uint8 const _nodeId, uint8 const _commandClassId, TiXmlElement const* _valueElement);
 					virtual void WriteXML(TiXmlElement* _valueElement);
@@ -116,6 +133,11 @@ namespace OpenZWave
 					{
 						return m_max;
 					}
+					void SetRange(int32 const _min, int32 const _max)
+					{
+						m_min = _min;
+						m_max = _max;
+					}
 
 					void SetChangeVerified(bool _verify)
 					{
@@ -135,6 +157,43 @@ namespace OpenZWave
 						return m_refreshAfterSet;
 					}
 
+					void SetNotificationFilter(double const _deadband, int32 const _minInterval, bool const _trailingEdge);
+					double GetNotificationDeadband() const
+					{
+						return m_notifyDeadband;
+					}
+					int32 GetNotificationMinInterval() const
+					{
+						return m_notifyMinInterval;
+					}
+					bool GetNotificationTrailingEdge() const
+					{
+						return m_notifyTrailingEdge;
+					}
+
+					// The recorded history, or NULL if the ValueHistorySize option is 0 or no numeric update has arrived yet
+					Internal::ValueHistory* GetHistory() const
+					{
+						return m_history.m_history.load(std::memory_order_acquire);
+					}
+
+					/**
+					 * Whether the node has reported that it is moving towards a target value,
+					 * and the duration it gave has not yet run out.  Values in a transition
+					 * are not polled.
+					 */
+					bool IsInTransition() const;
+
+					/**
+					 * The level a value in a transition is estimated to have reached, found
+					 * by interpolating from the last reported level to the target.  Levels
+					 * that are not numbers or colors are not interpolated.
+					 * \param o_estimate Set to the estimate, in the format of GetAsString.
+					 * \param o_remaining Set to the milliseconds left until the node should reach the target.
+					 * \return false if the value is not in a transition.
+					 */
+					bool GetTransition(string* o_estimate, uint32* o_remaining) const;
+
 					virtual string const GetAsString() const
 					{
 						return "";
@@ -164,6 +223,7 @@ namespace OpenZWave
 					}
 #endif
 					void sendValueRefresh(uint32 _unused);
+					void sendTrailingNotification(uint32 _filter);
 
 				protected:
 					virtual ~Value();
@@ -183,8 +243,12 @@ namespace OpenZWave
 
 					void OnValueRefreshed();			// A value in a device has been refreshed
 					void OnValueChanged();				// The refreshed value actually changed
+					void OnValueUpdated();				// The stored value has been updated from a report
 					int VerifyRefreshedValue(void* _originalValue, void* _checkValue, void* _newValue, void* _targetValue, ValueID::ValueType _type, int _originalValueLength = 0, int _checkValueLength = 0, int _newValueLength = 0, int _targetValueLength = 0);
 					int CheckTargetValue(void* _newValue, void* _targetValue, ValueID::ValueType _type, int _newValueLength, int _targetValueLength);
+					void StartTransition(uint32 const _duration, string const& _target = "");	// Called by SetTargetValue.  _target is only given for levels that can be interpolated.
+					bool IsNotificationFiltered(uint32 const _filter);
+					virtual bool GetNumericValue(double* o_value) const;	// Overridden by the types where the deadband makes sense
 
 					int32 m_min;
 					int32 m_max;
@@ -195,8 +259,17 @@ namespace OpenZWave
 					ValueID m_id;
 					bool m_targetValueSet;		// If the Target Value is Set 
 					uint32 m_duration;			// The Duration, if the CC supports it
+					uint64 m_transitionStart;	// Monotonic milliseconds when the last level of the transition was reported
+					uint64 m_transitionEnd;		// Monotonic milliseconds when the node should reach the Target Value, or 0 if unknown
+					string m_transitionFrom;	// Level reported at m_transitionStart, as a string
+					string m_transitionTo;		// Target Value as a string, or empty if it is not interpolated
 
 				private:
+					enum
+					{
+						TransitionRefreshMargin = 500	// Milliseconds to wait past the end of a transition before refreshing the value
+					};
+
 					string m_units;
 					bool m_readOnly;
 					bool m_writeOnly;
@@ -206,6 +279,73 @@ namespace OpenZWave
 					bool m_affectsAll;
 					bool m_checkChange;
 					uint8 m_pollIntensity;
+
+					// Deadband and rate limit applied to ValueRefreshed (0) and ValueChanged (1) notifications
+					enum
+					{
+						NotifyFilter_Refreshed = 0,
+						NotifyFilter_Changed,
+						NotifyFilter_Count
+					};
+					struct NotifyFilterState
+					{
+							NotifyFilterState() :
+									m_sentValue(0), m_sent(false), m_trailingPending(false)
+							{
+							}
+							NotifyFilterState(NotifyFilterState const&) :
+									m_sentValue(0), m_sent(false), m_trailingPending(false)		// Values are copied to hold a pending Set, which starts with no filter history
+							{
+							}
+							Internal::Platform::TimeStamp m_sentTS;	// When the last notification went out
+							double m_sentValue;						// Numeric value carried by the last notification
+							bool m_sent;
+							bool m_trailingPending;					// A held back value will be delivered when the interval expires
+					};
+					double m_notifyDeadband;					// Smallest change in a numeric value that is notified
+					int32 m_notifyMinInterval;					// Minimum milliseconds between notifications
+					bool m_notifyTrailingEdge;					// Deliver the last held back value once the interval expires
+					NotifyFilterState m_notifyState[NotifyFilter_Count];
+
+					// Set by the ValueStore while it holds the value, so reports can be handled without
+					// looking the driver, node and command class up again
+					struct Owner
+					{
+							Owner() :
+									m_driver(NULL), m_commandClass(NULL)
+							{
+							}
+							Owner(Owner const&) :
+									m_driver(NULL), m_commandClass(NULL)		// A copy is not in any ValueStore
+							{
+							}
+							Owner& operator =(Owner const&)
+							{
+								return *this;
+							}
+							Driver* m_driver;
+							Internal::CC::CommandClass* m_commandClass;
+					};
+					Owner m_owner;
+
+					// Created on the first numeric update of a value held by a ValueStore
+					struct History
+					{
+							History() :
+									m_history(NULL)
+							{
+							}
+							History(History const&) :
+									m_history(NULL)		// A copy records no history
+							{
+							}
+							History& operator =(History const&)
+							{
+								return *this;
+							}
+							std::atomic<Internal::ValueHistory*> m_history;
+					};
+					History m_history;
 			};
 		} // namespace VC
 	} // namespace Internal
@@ -347,9 +347,8 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void ValueBitSet::SetTargetValue(uint32 const _target, uint32 _duration)
 			{
-				m_targetValueSet = true;
 				m_targetValue = _target;
-				m_duration = _duration;
+				StartTransition(_duration);
 			}
 
 //-----------------------------------------------------------------------------
@@ -371,6 +370,7 @@ namespace OpenZWave
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
 				}
+				OnValueUpdated();
 			}
 		} // namespace VC
 	} // namespace Internal
@@ -116,9 +116,8 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void ValueBool::SetTargetValue(bool const _target, uint32 _duration)
 			{
-				m_targetValueSet = true;
 				m_targetValue = _target;
-				m_duration = _duration;
+				StartTransition(_duration);
 			}
 
 //-----------------------------------------------------------------------------
@@ -140,6 +139,7 @@ namespace OpenZWave
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
 				}
+				OnValueUpdated();
 			}
 		} // namespace VC
 	} // namespace Internal
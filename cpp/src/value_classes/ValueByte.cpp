@@ -135,9 +135,16 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void ValueByte::SetTargetValue(uint8 const _target, uint32 _duration)
 			{
-				m_targetValueSet = true;
 				m_targetValue = _target;
-				m_duration = _duration;
+				if (_target == 0xff)
+				{
+					// "On at the last level" can't be interpolated
+					StartTransition(_duration);
+					return;
+				}
+				char str[8];
+				snprintf(str, sizeof(str), "%d", _target);
+				StartTransition(_duration, str);
 			}
 
 //-----------------------------------------------------------------------------
@@ -159,6 +166,7 @@ namespace OpenZWave
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
 				}
+				OnValueUpdated();
 			}
 		} // namespace VC
 	} // namespace Internal
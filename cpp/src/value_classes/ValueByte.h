@@ -68,6 +68,14 @@ namespace OpenZWave
 						return m_value;
 					}
 
+				protected:
+					// From Value
+					virtual bool GetNumericValue(double* o_value) const
+					{
+						*o_value = m_value;
+						return true;
+					}
+
 				private:
 					uint8 m_value;				// the current value
 					uint8 m_valueCheck;			// the previous value (used for double-checking spurious value reads)
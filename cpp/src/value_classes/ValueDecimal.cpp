@@ -30,6 +30,7 @@
 #include "Msg.h"
 #include "platform/Log.h"
 #include "Manager.h"
+#include "command_classes/CommandClass.h"
 #include <ctime>
 
 namespace OpenZWave
@@ -102,9 +103,8 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void ValueDecimal::SetTargetValue(string const _target, uint32 _duration)
 			{
-				m_targetValueSet = true;
 				m_targetValue = _target;
-				m_duration = _duration;
+				StartTransition(_duration, _target);
 			}
 
 
@@ -127,6 +127,17 @@ namespace OpenZWave
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
 				}
+				OnValueUpdated();
+			}
+
+//-----------------------------------------------------------------------------
+// <ValueDecimal::OnValueRefreshed>
+// A value in a device has been refreshed, as a fixed point number
+//-----------------------------------------------------------------------------
+			void ValueDecimal::OnValueRefreshed(int32 const _value, uint8 const _precision)
+			{
+				m_precision = _precision;
+				OnValueRefreshed(Internal::CC::CommandClass::FormatValue(_value, _precision));
 			}
 		} // namespace VC
 	} // namespace Internal
@@ -29,6 +29,7 @@
 #define _ValueDecimal_H
 
 #include <string>
+#include <stdlib.h>
 #include "Defs.h"
 #include "value_classes/Value.h"
 
@@ -59,6 +60,7 @@ namespace OpenZWave
 
 					bool Set(string const& _value);
 					void OnValueRefreshed(string const& _value);
+					void OnValueRefreshed(int32 const _value, uint8 const _precision);	// _value is the reported number multiplied by 10^_precision
 					void SetTargetValue(string const _target, uint32 _duration = 0);
 
 					// From Value
@@ -86,6 +88,14 @@ namespace OpenZWave
 						m_precision = _precision;
 					}
 
+				protected:
+					// From Value
+					virtual bool GetNumericValue(double* o_value) const
+					{
+						*o_value = strtod(m_value.c_str(), NULL);
+						return true;
+					}
+
 				private:
 
 					string m_value;				// the current value
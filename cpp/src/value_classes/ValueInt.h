@@ -69,6 +69,14 @@ namespace OpenZWave
 						return m_value;
 					}
 
+				protected:
+					// From Value
+					virtual bool GetNumericValue(double* o_value) const
+					{
+						*o_value = m_value;
+						return true;
+					}
+
 				private:
 					int32 m_value;				// the current value
 					int32 m_valueCheck;			// the previous value (used for double-checking spurious value reads)
@@ -262,9 +262,8 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void ValueList::SetTargetValue(int32 const _target, uint32 _duration)
 			{
-				m_targetValueSet = true;
 				m_targetValue = _target;
-				m_duration = _duration;
+				StartTransition(_duration);
 			}
 
 //-----------------------------------------------------------------------------
@@ -295,6 +294,7 @@ namespace OpenZWave
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
 				}
+				OnValueUpdated();
 			}
 
 //-----------------------------------------------------------------------------
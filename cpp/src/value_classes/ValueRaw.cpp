@@ -217,10 +217,9 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void ValueRaw::SetTargetValue(uint8 const* _target, uint8 const _length, int32 _duration)
 			{
-				m_targetValueSet = true;
 				memcpy(m_targetValue, _target, _length);
 				m_targetValueLength = _length;
-				m_duration = _duration;
+				StartTransition((uint32) _duration);
 			}
 
 //-----------------------------------------------------------------------------
@@ -254,6 +253,7 @@ namespace OpenZWave
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
 				}
+				OnValueUpdated();
 			}
 		} // namespace VC
 	} // namespace Internal
@@ -137,9 +137,10 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void ValueShort::SetTargetValue(int16 const _target, uint32 _duration)
 			{
-				m_targetValueSet = true;
 				m_targetValue = _target;
-				m_duration = _duration;
+				char str[16];
+				snprintf(str, sizeof(str), "%d", _target);
+				StartTransition(_duration, str);
 			}
 
 //-----------------------------------------------------------------------------
@@ -161,6 +162,7 @@ namespace OpenZWave
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
 				}
+				OnValueUpdated();
 			}
 		} // namespace VC
 	} // namespace Internal
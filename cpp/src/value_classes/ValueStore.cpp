@@ -30,6 +30,7 @@
 #include "Manager.h"
 #include "Notification.h"
 #include "Localization.h"
+#include "ValueTable.h"
 #include "platform/Log.h"
 
 namespace OpenZWave
@@ -75,14 +76,17 @@ namespace OpenZWave
 
 				m_values[key] = _value;
 				_value->AddRef();
+				Internal::MemoryAccounting::Attribute(_value, _value->GetID().GetHomeId(), _value->GetID().GetNodeId(), (uint8) _value->GetID().GetType());
 
 				// Notify the watchers of the new value and Check our GetChangeVerified Flag
 				if (Driver* driver = Manager::Get()->GetDriver(_value->GetID().GetHomeId()))
 				{
+					_value->m_owner.m_driver = driver;
 					Node *node = driver->GetNodeUnsafe(_value->GetID().GetNodeId());
 					if (node) {
 						Internal::CC::CommandClass *cc = node->GetCommandClass(_value->GetID().GetCommandClassId());
 						if (cc) {
+							_value->m_owner.m_commandClass = cc;
 							if (cc->m_com.GetFlagBool(COMPAT_FLAG_VERIFYCHANGED, _value->GetID().GetIndex())) {
 								Log::Write(LogLevel_Info, _value->GetID().GetNodeId(), "Setting VerifiedChanged Flag on Value %d for CC %s", _value->GetID().GetIndex(), cc->GetCommandClassName().c_str());
 								_value->SetChangeVerified(true);
@@ -91,12 +95,18 @@ namespace OpenZWave
 								Log::Write(LogLevel_Info, _value->GetID().GetNodeId(), "Setting NoRefreshAfterSet Flag on Value %d for CC %s", _value->GetID().GetIndex(), cc->GetCommandClassName().c_str());
 								_value->SetRefreshAfterSet(false);
 							}
+							uint32 deadband = cc->m_com.GetFlagInt(COMPAT_FLAG_NOTIFY_DEADBAND, _value->GetID().GetIndex());
+							uint32 minInterval = cc->m_com.GetFlagInt(COMPAT_FLAG_NOTIFY_MININTERVAL, _value->GetID().GetIndex());
+							if (deadband > 0 || minInterval > 0) {
+								_value->SetNotificationFilter(deadband / 1000.0, minInterval, cc->m_com.GetFlagBool(COMPAT_FLAG_NOTIFY_TRAILINGEDGE, _value->GetID().GetIndex()));
+							}
 						}
 					}
 					Notification* notification = new Notification(Notification::Type_ValueAdded);
 					notification->SetValueId(_value->GetID());
 					driver->QueueNotification(notification);
 				}
+				Internal::ValueTable::Publish(_value);
 
 				return true;
 			}
@@ -121,7 +131,11 @@ namespace OpenZWave
 						driver->QueueNotification(notification);
 					}
 
+					Internal::ValueTable::Remove(valueId);
+
 					// Now release and remove the value from the store
+					value->m_owner.m_driver = NULL;
+					value->m_owner.m_commandClass = NULL;
 					int32 references = value->Release();
 					if (references > 0)
 						Log::Write(LogLevel_Warning, "Value Not Deleted - Still in use %d times: CC: %d - %s - %s - %d", references, valueId.GetCommandClassId(), valueId.GetTypeAsString().c_str(), value->GetLabel().c_str(), value->GetID());
@@ -169,6 +183,8 @@ namespace OpenZWave
 						}
 
 						// Now release and remove the value from the store
+						value->m_owner.m_driver = NULL;
+						value->m_owner.m_commandClass = NULL;
 						value->Release();
 						m_values.erase(it++);
 					}
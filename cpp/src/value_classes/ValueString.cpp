@@ -101,9 +101,8 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void ValueString::SetTargetValue(string const _target, uint32 _duration)
 			{
-				m_targetValueSet = true;
 				m_targetValue = _target;
-				m_duration = _duration;
+				StartTransition(_duration, _target);
 			}
 
 //-----------------------------------------------------------------------------
@@ -125,6 +124,7 @@ namespace OpenZWave
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
 				}
+				OnValueUpdated();
 			}
 		} // namespace VC
 	} // namespace Internal
@@ -0,0 +1,167 @@
+//-----------------------------------------------------------------------------
+//
+//	TimerThread_test.cpp
+//
+//	Test Framework for the TimerThread
+//
+//	Copyright (c) 2026 OpenZWave contributors
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "TimerThread.h"
+#include "platform/Thread.h"
+
+namespace OpenZWave
+{
+
+namespace Testing
+{
+using Internal::Timer;
+using Internal::TimerThread;
+
+// Drives a TimerThread without a Driver.  The events are owned by the test
+// rather than by the Timer, so the ones that fire are deleted at the end.
+class TimerThreadTest: public ::testing::Test
+{
+protected:
+	TimerThreadTest() :
+			m_timer(NULL), m_thread(NULL)
+	{
+	}
+
+	void SetEvent(int32 _milliseconds)
+	{
+		uint32 id = (uint32) m_entries.size();
+		m_entries.push_back(m_timer.TimerSetEvent(_milliseconds, bind(&TimerThreadTest::Fired, this, std::placeholders::_1), &m_instance, id));
+	}
+
+	void DelEvent(uint32 _id)
+	{
+		m_timer.TimerDelEvent(m_entries[_id]);
+		m_entries[_id] = NULL;
+	}
+
+	size_t GetPendingEvents()
+	{
+		return m_timer.GetPendingEvents();
+	}
+
+	void Start()
+	{
+		m_thread = new Internal::Platform::Thread("timer");
+		m_thread->Start(TimerThread::TimerThreadEntryPoint, &m_timer);
+	}
+
+	void Stop()
+	{
+		m_thread->Stop();
+		m_thread->Release();
+		m_thread = NULL;
+	}
+
+	virtual void TearDown()
+	{
+		for (std::vector<uint32>::iterator it = m_fired.begin(); it != m_fired.end(); ++it)
+		{
+			delete m_entries[*it];
+		}
+	}
+
+	// Runs on the timer thread, with the heap locked
+	void Fired(uint32 _id)
+	{
+		m_fired.push_back(_id);
+	}
+
+	TimerThread m_timer;
+	Timer m_instance;
+	Internal::Platform::Thread* m_thread;
+	std::vector<TimerThread::TimerEventEntry*> m_entries;		// By ID
+	std::vector<uint32> m_fired;								// IDs, in the order they fired
+};
+
+TEST_F(TimerThreadTest, FiresInDeadlineOrder)
+{
+	uint32 const count = 50000;
+	std::mt19937 random(1);
+	std::uniform_int_distribution<int32> delay(0, 500);
+
+	for (uint32 i = 0; i < count; ++i)
+	{
+		SetEvent(delay(random));
+	}
+	EXPECT_EQ(GetPendingEvents(), count);
+
+	// Cancel every third event, which takes events out of the middle of the heap
+	uint32 cancelled = 0;
+	for (uint32 i = 0; i < count; i += 3)
+	{
+		DelEvent(i);
+		++cancelled;
+	}
+	EXPECT_EQ(GetPendingEvents(), count - cancelled);
+
+	Start();
+	// GetPendingEvents waits for the lock the timer thread holds while it fires
+	// events, so at zero every callback has run
+	for (int i = 0; i < 1000 && GetPendingEvents() > 0; ++i)
+	{
+		m_thread->Sleep(10);
+	}
+	Stop();
+	EXPECT_EQ(GetPendingEvents(), 0u);
+
+	ASSERT_EQ(m_fired.size(), count - cancelled);
+	for (size_t i = 0; i < m_fired.size(); ++i)
+	{
+		EXPECT_NE(m_fired[i] % 3, 0u);
+		if (i > 0)
+		{
+			TimerThread::TimerEventEntry const* previous = m_entries[m_fired[i - 1]];
+			TimerThread::TimerEventEntry const* current = m_entries[m_fired[i]];
+			// Events due at the same time fire in the order they were set
+			ASSERT_TRUE(previous->deadline < current->deadline || (previous->deadline == current->deadline && previous->sequence < current->sequence)) << "event " << m_fired[i] << " fired out of order";
+		}
+	}
+}
+
+TEST_F(TimerThreadTest, CancelAll)
+{
+	for (uint32 i = 0; i < 1000; ++i)
+	{
+		SetEvent(10);
+	}
+	for (uint32 i = 1000; i > 0; --i)
+	{
+		DelEvent(i - 1);
+	}
+	EXPECT_EQ(GetPendingEvents(), 0u);
+
+	Start();
+	m_thread->Sleep(50);
+	Stop();
+	EXPECT_TRUE(m_fired.empty());
+}
+}
+} // namespace OpenZWave
@@ -1421,6 +1421,8 @@ DISTFILES =	.gitignore \
 	cpp/src/DoxygenMain.h \
 	cpp/src/Driver.cpp \
 	cpp/src/Driver.h \
+	cpp/src/FrameCapture.cpp \
+	cpp/src/FrameCapture.h \
 	cpp/src/Group.cpp \
 	cpp/src/Group.h \
 	cpp/src/Http.cpp \
@@ -1429,6 +1431,10 @@ DISTFILES =	.gitignore \
 	cpp/src/Localization.h \
 	cpp/src/Manager.cpp \
 	cpp/src/Manager.h \
+	cpp/src/MemoryAccounting.cpp \
+	cpp/src/MemoryAccounting.h \
+	cpp/src/Metrics.cpp \
+	cpp/src/Metrics.h \
 	cpp/src/ManufacturerSpecificDB.cpp \
 	cpp/src/ManufacturerSpecificDB.h \
 	cpp/src/Msg.cpp \
@@ -1442,17 +1448,27 @@ DISTFILES =	.gitignore \
 	cpp/src/OZWException.h \
 	cpp/src/Options.cpp \
 	cpp/src/Options.h \
+	cpp/src/ProductCache.cpp \
+	cpp/src/ProductCache.h \
 	cpp/src/Scene.cpp \
 	cpp/src/Scene.h \
 	cpp/src/SensorMultiLevelCCTypes.cpp \
 	cpp/src/SensorMultiLevelCCTypes.h \
 	cpp/src/TimerThread.cpp \
 	cpp/src/TimerThread.h \
+	cpp/src/Topology.cpp \
+	cpp/src/Topology.h \
 	cpp/src/Utils.cpp \
 	cpp/src/Utils.h \
+	cpp/src/ValueHistory.cpp \
+	cpp/src/ValueHistory.h \
 	cpp/src/ValueIDIndexes.h \
 	cpp/src/ValueIDIndexesDefines.def \
 	cpp/src/ValueIDIndexesDefines.h \
+	cpp/src/ValueTable.cpp \
+	cpp/src/ValueTable.h \
+	cpp/src/WatcherQueue.cpp \
+	cpp/src/WatcherQueue.h \
 	cpp/src/ZWSecurity.cpp \
 	cpp/src/ZWSecurity.h \
 	cpp/src/aes/aes.h \
@@ -1556,6 +1572,8 @@ DISTFILES =	.gitignore \
 	cpp/src/command_classes/SimpleAVCommandItem.h \
 	cpp/src/command_classes/SoundSwitch.cpp \
 	cpp/src/command_classes/SoundSwitch.h \
+	cpp/src/command_classes/Supervision.cpp \
+	cpp/src/command_classes/Supervision.h \
 	cpp/src/command_classes/SwitchAll.cpp \
 	cpp/src/command_classes/SwitchAll.h \
 	cpp/src/command_classes/SwitchBinary.cpp \
@@ -1603,6 +1621,8 @@ DISTFILES =	.gitignore \
 	cpp/src/platform/Mutex.cpp \
 	cpp/src/platform/Mutex.h \
 	cpp/src/platform/Ref.h \
+	cpp/src/platform/ReplayController.cpp \
+	cpp/src/platform/ReplayController.h \
 	cpp/src/platform/SerialController.cpp \
 	cpp/src/platform/SerialController.h \
 	cpp/src/platform/Stream.cpp \
@@ -1699,6 +1719,7 @@ DISTFILES =	.gitignore \
 	cpp/src/value_classes/ValueString.cpp \
 	cpp/src/value_classes/ValueString.h \
 	cpp/test/Makefile \
+	cpp/test/TimerThread_test.cpp \
 	cpp/test/ValueID_test.cpp \
 	cpp/test/include/gtest/gtest-death-test.h \
 	cpp/test/include/gtest/gtest-matchers.h \